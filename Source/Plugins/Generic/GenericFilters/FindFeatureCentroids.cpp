@@ -34,7 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindFeatureCentroids.h"
 
+#include <algorithm>
 #include <array>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -46,6 +49,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Generic/GenericConstants.h"
 #include "Generic/GenericVersion.h"
@@ -57,6 +61,60 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+/**
+ * @brief The FindFeatureCentroidsImpl class sums the voxel indices of every Feature for a range of slabs of rows, each
+ * slab into its own partial sums. The sums are exact integers, so the slabs can be added in any order.
+ */
+class FindFeatureCentroidsImpl
+{
+public:
+  FindFeatureCentroidsImpl(const int32_t* featureIds, const std::array<size_t, 3>& dims, size_t rowsPerSlab, std::vector<std::vector<uint64_t>>& counts, std::vector<std::vector<int64_t>>& sums)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_RowsPerSlab(rowsPerSlab)
+  , m_Counts(counts)
+  , m_Sums(sums)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numRows = m_Dims[1] * m_Dims[2];
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      std::vector<uint64_t>& counts = m_Counts[slab];
+      std::vector<int64_t>& sums = m_Sums[slab];
+      size_t numFeatures = counts.size();
+      size_t rowEnd = std::min(numRows, (slab + 1) * m_RowsPerSlab);
+      for(size_t rowIndex = slab * m_RowsPerSlab; rowIndex < rowEnd; rowIndex++)
+      {
+        int64_t y = static_cast<int64_t>(rowIndex % m_Dims[1]);
+        int64_t z = static_cast<int64_t>(rowIndex / m_Dims[1]);
+        const int32_t* row = m_FeatureIds + rowIndex * m_Dims[0];
+        for(size_t x = 0; x < m_Dims[0]; x++)
+        {
+          int32_t featureId = row[x];
+          if(featureId < 0 || static_cast<size_t>(featureId) >= numFeatures)
+          {
+            continue;
+          }
+          counts[featureId]++;
+          sums[featureId * 3 + 0] += static_cast<int64_t>(x);
+          sums[featureId * 3 + 1] += y;
+          sums[featureId * 3 + 2] += z;
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  std::array<size_t, 3> m_Dims = {0, 0, 0};
+  size_t m_RowsPerSlab = 1;
+  std::vector<std::vector<uint64_t>>& m_Counts;
+  std::vector<std::vector<int64_t>>& m_Sums;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -138,77 +196,47 @@ void FindFeatureCentroids::find_centroids()
 
   size_t totalFeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  size_t xPoints = imageGeom->getXPoints();
-  size_t yPoints = imageGeom->getYPoints();
-  size_t zPoints = imageGeom->getZPoints();
+  std::array<size_t, 3> dims = {imageGeom->getXPoints(), imageGeom->getYPoints(), imageGeom->getZPoints()};
+  FloatVec3Type origin = imageGeom->getOrigin();
+  FloatVec3Type spacing = imageGeom->getSpacing();
 
-  //Copy the Coords into an array and then compute the sum
+  // Sum the voxel indices as integers, one slab per thread, but never let the partial sums outgrow the Feature Ids
+  size_t numRows = dims[1] * dims[2];
+  size_t maxSlabs = std::max(static_cast<size_t>(1), (dims[0] * numRows * sizeof(int32_t)) / std::max(static_cast<size_t>(1), totalFeatures * 4 * sizeof(int64_t)));
+  size_t numSlabs = std::min({std::max(numRows, static_cast<size_t>(1)), static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())), maxSlabs});
+  size_t rowsPerSlab = std::max(static_cast<size_t>(1), (numRows + numSlabs - 1) / numSlabs);
+  numSlabs = std::max(static_cast<size_t>(1), (numRows + rowsPerSlab - 1) / rowsPerSlab);
 
-  std::vector<double> sum(totalFeatures * 3, 0.0);
-  std::vector<double> c(totalFeatures * 3, 0.0);
-  std::vector<size_t> count(totalFeatures * 3, 0.0);
+  std::vector<std::vector<uint64_t>> counts(numSlabs, std::vector<uint64_t>(totalFeatures, 0));
+  std::vector<std::vector<int64_t>> sums(numSlabs, std::vector<int64_t>(totalFeatures * 3, 0));
 
-  std::array<float, 3> voxel_center = {0.0f, 0.0f, 0.0f};
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSlabs);
+  dataAlg.execute(FindFeatureCentroidsImpl(m_FeatureIds, dims, rowsPerSlab, counts, sums));
 
-  size_t zStride = 0;
-  size_t yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
+  for(size_t slab = 1; slab < numSlabs; slab++)
   {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
+    for(size_t featureId = 0; featureId < totalFeatures; featureId++)
     {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t featureId = m_FeatureIds[zStride + yStride + k]; // Get the current FeatureId
-
-        imageGeom->getCoords(k, j, i, voxel_center.data()); // Get the voxel center based on XYZ index from Image Geom
-
-        //Kahan Sum for X Coord
-        size_t featureId_idx = static_cast<size_t>(featureId * 3);
-        double y = static_cast<double>(voxel_center[0] - c[featureId_idx]);
-        double t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Y Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-        y = static_cast<double>(voxel_center[1] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-
-        //Kahan Sum for Z Coord
-        featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-        y = static_cast<double>(voxel_center[2] - c[featureId_idx]);
-        t = sum[featureId_idx] + y;
-        c[featureId_idx] = (t - sum[featureId_idx]) - y;
-        sum[featureId_idx] = t;
-        count[featureId_idx]++;
-      }
+      counts[0][featureId] += counts[slab][featureId];
+      sums[0][featureId * 3 + 0] += sums[slab][featureId * 3 + 0];
+      sums[0][featureId * 3 + 1] += sums[slab][featureId * 3 + 1];
+      sums[0][featureId * 3 + 2] += sums[slab][featureId * 3 + 2];
     }
   }
 
+  // The centroid is the mean of the voxel centers
   for(size_t featureId = 0; featureId < totalFeatures; featureId++)
   {
-    size_t featureId_idx = static_cast<size_t>(featureId * 3);
-    if(count[featureId_idx] > 0.0f)
+    if(counts[0][featureId] == 0)
     {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
+      continue;
     }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 1);
-    if(count[featureId_idx] > 0.0f)
-    {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
-    }
-
-    featureId_idx = static_cast<size_t>(featureId * 3 + 2);
-    if(count[featureId_idx] > 0.0f)
+    double count = static_cast<double>(counts[0][featureId]);
+    for(size_t i = 0; i < 3; i++)
     {
-      m_Centroids[featureId_idx] = sum[featureId_idx] / static_cast<double>(count[featureId_idx]);
+      double meanIndex = static_cast<double>(sums[0][featureId * 3 + i]) / count;
+      m_Centroids[featureId * 3 + i] = static_cast<float>(origin[i] + (meanIndex + 0.5) * spacing[i]);
     }
   }
 }
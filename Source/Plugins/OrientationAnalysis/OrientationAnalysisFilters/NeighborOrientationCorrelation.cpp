@@ -35,11 +35,13 @@
 
 #include "NeighborOrientationCorrelation.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -50,64 +52,46 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
+#include "OrientationAnalysis/OrientationAnalysisFilters/util/NeighborMapGather.hpp"
 #include "OrientationAnalysis/OrientationAnalysisVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/task_group.h>
-#include <tbb/tick_count.h>
-#endif
-
+/**
+ * @brief The NeighborOrientationCorrelationTransferDataImpl class applies the best neighbor map to a range of the
+ * cell arrays, one typed pass per array
+ */
 class NeighborOrientationCorrelationTransferDataImpl
 {
 public:
-  NeighborOrientationCorrelationTransferDataImpl() = delete;
-  NeighborOrientationCorrelationTransferDataImpl(const NeighborOrientationCorrelationTransferDataImpl&) = default;
-
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, size_t totalPoints, const std::vector<int64_t>& bestNeighbor, IDataArray::Pointer dataArrayPtr)
+  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelation* filter, const std::vector<int64_t>& bestNeighbor, const std::vector<IDataArray::Pointer>& cellArrays)
   : m_Filter(filter)
-  , m_TotalPoints(totalPoints)
   , m_BestNeighbor(bestNeighbor)
-  , m_DataArrayPtr(dataArrayPtr)
+  , m_CellArrays(cellArrays)
   {
   }
-  NeighborOrientationCorrelationTransferDataImpl(NeighborOrientationCorrelationTransferDataImpl&&) = default;                // Move Constructor Not Implemented
-  NeighborOrientationCorrelationTransferDataImpl& operator=(const NeighborOrientationCorrelationTransferDataImpl&) = delete; // Copy Assignment Not Implemented
-  NeighborOrientationCorrelationTransferDataImpl& operator=(NeighborOrientationCorrelationTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
-
-  ~NeighborOrientationCorrelationTransferDataImpl() = default;
 
-  void operator()() const
+  void operator()(const SIMPLRange& range) const
   {
-    size_t progIncrement = static_cast<size_t>(m_TotalPoints / 50);
-    size_t prog = 1;
-    for(size_t i = 0; i < m_TotalPoints; i++)
+    for(size_t arrayIndex = range.min(); arrayIndex < range.max(); arrayIndex++)
     {
-      if(i > prog)
+      if(m_Filter->getCancel())
       {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
-      }
-      int64_t neighbor = m_BestNeighbor[i];
-      if(neighbor != -1)
-      {
-        // IDataArray::Pointer p = m_AttrMat->getAttributeArray(m_VoxelArrayNames[m_VoxelArrayIndex]);
-        m_DataArrayPtr->copyTuple(neighbor, i);
+        return;
       }
+
+      // Cells are visited in order, so chained replacements resolve exactly as in a serial copy
+      NeighborMapGather::Gather(m_CellArrays[arrayIndex].get(), nullptr, m_BestNeighbor.data(), m_BestNeighbor.size());
     }
   }
 
 private:
   NeighborOrientationCorrelation* m_Filter = nullptr;
-  size_t m_TotalPoints = 0;
-  std::vector<int64_t> m_BestNeighbor;
-  IDataArray::Pointer m_DataArrayPtr;
+  const std::vector<int64_t>& m_BestNeighbor;
+  const std::vector<IDataArray::Pointer>& m_CellArrays;
 };
 
 // -----------------------------------------------------------------------------
@@ -230,9 +214,6 @@ void NeighborOrientationCorrelation::execute()
     return;
   }
 
-  m_Progress = 0;
-  m_TotalProgress = 0;
-
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_ConfidenceIndexArrayPath.getDataContainerName());
   size_t totalPoints = m_ConfidenceIndexPtr.lock()->getNumberOfTuples();
 
@@ -440,65 +421,26 @@ void NeighborOrientationCorrelation::execute()
     {
       return;
     }
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    bool doParallel = true;
-#endif
 
     QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
     for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
     {
       voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
     }
-
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    // The idea for this parallel section is to parallelize over each Data Array that
-    // will need it's data adjusted. This should go faster than before by about 2x.
-    // Better speed up could be achieved if we had better data locality.
-    m_Progress = 0;
-    m_TotalProgress = 0;
-    if(doParallel)
+    std::vector<IDataArray::Pointer> voxelArrays;
+    for(const auto& arrayName : voxelArrayNames)
     {
-      std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
-      AttributeMatrix* attrMat = m->getAttributeMatrix(attrMatName).get();
-      m_TotalProgress = voxelArrayNames.size() * totalPoints; // Total number of points to update
-      // Create and run all the tasks
-      for(const auto& arrayName : voxelArrayNames)
-      {
-        IDataArray::Pointer dataArrayPtr = attrMat->getAttributeArray(arrayName);
-        taskGroup->run(NeighborOrientationCorrelationTransferDataImpl(this, totalPoints, bestNeighbor, dataArrayPtr));
-      }
-      // Wait for them to complete.
-      taskGroup->wait();
-    }
-    else
-#endif
-    {
-      progIncrement = static_cast<int64_t>(totalPoints / 100);
-      prog = 1;
-      progressInt = 0;
-      for(size_t i = 0; i < totalPoints; i++)
-      {
-        if(int64_t(i) > prog)
-        {
-          progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-          QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level).arg(progressInt);
-          notifyStatusMessage(ss);
-          prog = prog + progIncrement;
-        }
-        neighbor = bestNeighbor[i];
-        if(neighbor != -1)
-        {
-          for(const auto& iter : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(iter);
-            p->copyTuple(neighbor, i);
-          }
-        }
-      }
+      voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName));
     }
 
+    QString ss = QObject::tr("Level %1 of %2 || Copying Data").arg((startLevel - currentLevel) + 2).arg(startLevel - m_Level);
+    notifyStatusMessage(ss);
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, voxelArrays.size());
+    dataAlg.execute(NeighborOrientationCorrelationTransferDataImpl(this, bestNeighbor, voxelArrays));
+
     currentLevel = currentLevel - 1;
-    m_CurrentLevel = currentLevel;
   }
 
   if(getCancel())
@@ -507,17 +449,6 @@ void NeighborOrientationCorrelation::execute()
   }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void NeighborOrientationCorrelation::updateProgress(size_t p)
-{
-  m_Progress += p;
-  int32_t progressInt = static_cast<int>((static_cast<float>(m_Progress) / static_cast<float>(m_TotalProgress)) * 100.0f);
-  QString ss = QObject::tr("Level %1 of %2 || Copying Data %3%").arg((6 - m_CurrentLevel) + 2).arg(6 - m_Level).arg(progressInt);
-  notifyStatusMessage(ss);
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -187,8 +187,6 @@ public:
   std::vector<DataArrayPath> getIgnoredDataArrayPaths() const;
   Q_PROPERTY(DataArrayPathVec IgnoredDataArrayPaths READ getIgnoredDataArrayPaths WRITE setIgnoredDataArrayPaths)
 
-  void updateProgress(size_t p);
-
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -275,10 +273,6 @@ private:
   DataArrayPath m_QuatsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  size_t m_Progress = 0;
-  size_t m_TotalProgress = 0;
-  int32_t m_CurrentLevel = 0;
-
   LaueOpsContainer m_OrientationOps;
 
 public:
@@ -107,6 +107,8 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE)
 endforeach()
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/NeighborMapGather.hpp)
+
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
 SIMPL_END_FILTER_GROUP(${OrientationAnalysis_BINARY_DIR} "${_filterGroupName}" "OrientationAnalysis")
@@ -0,0 +1,115 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+namespace NeighborMapGather
+{
+/**
+ * @brief GatherTuples Copies the tuple of neighbors[i] into cell i (or cells[i]) for every entry that has a source,
+ * in entry order, if dataArray is a DataArray<T>
+ * @param dataArray Array whose tuples are copied
+ * @param cells Destination cell of each entry, or nullptr if entry i is cell i
+ * @param neighbors Source cell of each entry, or a negative value to skip the entry
+ * @param size Number of entries
+ * @return False if dataArray holds a different type
+ */
+template <typename T>
+bool GatherTuples(IDataArray* dataArray, const int64_t* cells, const int64_t* neighbors, size_t size)
+{
+  auto* typedArray = dynamic_cast<DataArray<T>*>(dataArray);
+  if(nullptr == typedArray)
+  {
+    return false;
+  }
+
+  T* data = typedArray->getPointer(0);
+  size_t numComps = static_cast<size_t>(typedArray->getNumberOfComponents());
+  for(size_t index = 0; index < size; index++)
+  {
+    int64_t neighbor = neighbors[index];
+    if(neighbor < 0)
+    {
+      continue;
+    }
+    size_t cell = (nullptr == cells) ? index : static_cast<size_t>(cells[index]);
+    if(numComps == 1)
+    {
+      data[cell] = data[neighbor];
+    }
+    else
+    {
+      std::copy_n(data + neighbor * numComps, numComps, data + cell * numComps);
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Gather Applies a neighbor map to dataArray in a single typed pass over its raw data. Arrays that are not
+ * one of the primitive DataArray types fall back to IDataArray::copyTuple.
+ * @param dataArray Array whose tuples are copied
+ * @param cells Destination cell of each entry, or nullptr if entry i is cell i
+ * @param neighbors Source cell of each entry, or a negative value to skip the entry
+ * @param size Number of entries
+ */
+inline void Gather(IDataArray* dataArray, const int64_t* cells, const int64_t* neighbors, size_t size)
+{
+  if(GatherTuples<int8_t>(dataArray, cells, neighbors, size) || GatherTuples<uint8_t>(dataArray, cells, neighbors, size) || GatherTuples<int16_t>(dataArray, cells, neighbors, size) ||
+     GatherTuples<uint16_t>(dataArray, cells, neighbors, size) || GatherTuples<int32_t>(dataArray, cells, neighbors, size) || GatherTuples<uint32_t>(dataArray, cells, neighbors, size) ||
+     GatherTuples<int64_t>(dataArray, cells, neighbors, size) || GatherTuples<uint64_t>(dataArray, cells, neighbors, size) || GatherTuples<float>(dataArray, cells, neighbors, size) ||
+     GatherTuples<double>(dataArray, cells, neighbors, size) || GatherTuples<bool>(dataArray, cells, neighbors, size))
+  {
+    return;
+  }
+
+  for(size_t index = 0; index < size; index++)
+  {
+    int64_t neighbor = neighbors[index];
+    if(neighbor >= 0)
+    {
+      size_t cell = (nullptr == cells) ? index : static_cast<size_t>(cells[index]);
+      dataArray->copyTuple(static_cast<size_t>(neighbor), cell);
+    }
+  }
+}
+} // namespace NeighborMapGather
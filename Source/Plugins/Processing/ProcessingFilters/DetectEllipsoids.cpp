@@ -37,6 +37,7 @@
 
 #define NOMINMAX
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <thread>
@@ -116,9 +117,9 @@ void DetectEllipsoids::initialize()
   setCancel(false);
 
   m_TotalNumberOfFeatures = 0;
-  m_NextExecutedFeatureId = 1;
+  m_FeatureOrder.clear();
+  m_NextFeatureIndex = 0;
   m_FeaturesCompleted = 0;
-  m_MaxFeatureId = 0;
 
   // Initialize counter to track number of detected ellipses
   m_Ellipse_Count = 0;
@@ -371,10 +372,25 @@ void DetectEllipsoids::execute()
     // Create offset array to use for smoothing convolutions
     Int32ArrayType::Pointer smoothOffsetArray = createOffsetArray(smooth_tDims);
 
+    // Order the features by the area of their bounding boxes, largest first. The cost of a feature grows with that area
+    // and the sizes are usually very skewed, so handing out the big features first keeps a thread from being left
+    // with a large one at the end while the others sit idle.
+    std::vector<size_t> featureAreas(m_TotalNumberOfFeatures, 0);
+    for(int32_t i = 1; i < m_TotalNumberOfFeatures; i++)
+    {
+      uint32_t* featureCorner = corners->getPointer(i * numComps);
+      if(featureCorner[3] >= featureCorner[0] && featureCorner[4] >= featureCorner[1])
+      {
+        featureAreas[i] = static_cast<size_t>(featureCorner[3] - featureCorner[0] + 1) * static_cast<size_t>(featureCorner[4] - featureCorner[1] + 1);
+      }
+      m_FeatureOrder.push_back(i);
+    }
+    std::stable_sort(m_FeatureOrder.begin(), m_FeatureOrder.end(), [&featureAreas](int32_t a, int32_t b) { return featureAreas[a] > featureAreas[b]; });
+
     QString ss = QObject::tr("0/%2").arg(m_TotalNumberOfFeatures);
     notifyStatusMessage(ss);
 
-    m_MaxFeatureId = m_TotalNumberOfFeatures;
+    std::vector<DE_EllipseBuffer> threadEllipses;
 
 #ifdef SIMPL_USE_PARALLEL_ALGORITHMS
     bool doParallel = true;
@@ -382,14 +398,14 @@ void DetectEllipsoids::execute()
     if(doParallel)
     {
       std::shared_ptr<tbb::task_group> g(new tbb::task_group);
-      int threads = std::thread::hardware_concurrency();
+      int threads = std::max(1u, std::thread::hardware_concurrency());
+      threadEllipses.resize(threads);
 
       for(int i = 0; i < threads; i++)
       {
         m_ThreadWork[i] = 0;
-        g->run(DetectEllipsoidsImpl(i, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
-                                    axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
-                                    m_EllipseFeatureAttributeMatrixPtr));
+        g->run(DetectEllipsoidsImpl(i, this, threadEllipses[i], cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil,
+                                    smoothOffsetArray, axis_min, axis_max, m_HoughTransformThreshold, m_MinAspectRatio));
       }
 
       g->wait();
@@ -397,9 +413,9 @@ void DetectEllipsoids::execute()
     else
 #endif
     {
-      DetectEllipsoidsImpl impl(0, this, cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil, smoothOffsetArray, axis_min,
-                                axis_max, m_HoughTransformThreshold, m_MinAspectRatio, m_CenterCoordinatesPtr, m_MajorAxisLengthArrayPtr, m_MinorAxisLengthArrayPtr, m_RotationalAnglesArrayPtr,
-                                m_EllipseFeatureAttributeMatrixPtr);
+      threadEllipses.resize(1);
+      DetectEllipsoidsImpl impl(0, this, threadEllipses[0], cellFeatureIdsPtr, imageDims, corners, convCoords_X, convCoords_Y, convCoords_Z, orient_tDims, convOffsetArray, smoothFil,
+                                smoothOffsetArray, axis_min, axis_max, m_HoughTransformThreshold, m_MinAspectRatio);
       m_ThreadWork[0] = 0;
       impl();
     }
@@ -409,6 +425,8 @@ void DetectEllipsoids::execute()
       return;
     }
 
+    storeEllipses(threadEllipses);
+
     // Plot each detected ellipse in the new Ellipse Detection Feature Ids array
     for(int featureId = 1; featureId < m_CenterCoordinatesPtr->getNumberOfTuples(); featureId++)
     {
@@ -1315,33 +1333,57 @@ void DetectEllipsoids::ind2sub(std::vector<size_t> tDims, size_t index, size_t&
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t DetectEllipsoids::getUniqueFeatureId()
+int32_t DetectEllipsoids::getNextFeatureId()
 {
-  QMutexLocker locker(&m_MaxFeatureIdMutex);
-  m_MaxFeatureId++;
-  int32_t id = m_MaxFeatureId;
-  return id;
+  size_t index = m_NextFeatureIndex++;
+  if(index >= m_FeatureOrder.size())
+  {
+    return -1;
+  }
+  return m_FeatureOrder[index];
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-size_t DetectEllipsoids::getNextFeatureId()
+void DetectEllipsoids::storeEllipses(const std::vector<DE_EllipseBuffer>& threadEllipses)
 {
-  QMutexLocker locker(&m_NextExecutedFeatureIdMutex);
-  int32_t featureId = m_NextExecutedFeatureId++;
-  if(m_NextExecutedFeatureId > m_TotalNumberOfFeatures)
+  DE_EllipseBuffer ellipses;
+  for(const auto& buffer : threadEllipses)
   {
-    featureId = -1;
+    ellipses.insert(ellipses.end(), buffer.begin(), buffer.end());
   }
-  return featureId;
-}
+  std::sort(ellipses.begin(), ellipses.end(), [](const DE_DetectedEllipse& a, const DE_DetectedEllipse& b) {
+    return a.featureId < b.featureId || (a.featureId == b.featureId && a.ellipseIndex < b.ellipseIndex);
+  });
 
-// -----------------------------------------------------------------------------
-void DetectEllipsoids::incrementEllipseCount()
-{
-  QMutexLocker locker(&m_IncrementCountMutex);
-  ++m_Ellipse_Count;
+  m_Ellipse_Count = ellipses.size();
+
+  // Size the ellipse arrays once for every ellipse beyond the first of its feature
+  size_t numExtraEllipses = 0;
+  for(const auto& ellipse : ellipses)
+  {
+    if(ellipse.ellipseIndex > 0)
+    {
+      numExtraEllipses++;
+    }
+  }
+  m_EllipseFeatureAttributeMatrixPtr->resizeAttributeArrays(std::vector<size_t>(1, static_cast<size_t>(m_TotalNumberOfFeatures) + 1 + numExtraEllipses));
+
+  size_t nextFeatureId = static_cast<size_t>(m_TotalNumberOfFeatures) + 1;
+  for(const auto& ellipse : ellipses)
+  {
+    size_t objId = static_cast<size_t>(ellipse.featureId);
+    if(ellipse.ellipseIndex > 0)
+    {
+      objId = nextFeatureId++;
+    }
+    m_CenterCoordinatesPtr->setComponent(objId, 0, ellipse.cenx);
+    m_CenterCoordinatesPtr->setComponent(objId, 1, ellipse.ceny);
+    m_MajorAxisLengthArrayPtr->setValue(objId, ellipse.majaxis);
+    m_MinorAxisLengthArrayPtr->setValue(objId, ellipse.minaxis);
+    m_RotationalAnglesArrayPtr->setValue(objId, ellipse.rotangle);
+  }
 }
 
 // -----------------------------------------------------------------------------
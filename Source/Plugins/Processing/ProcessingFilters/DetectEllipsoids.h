@@ -35,9 +35,10 @@
 
 #pragma once
 
-#include <memory>
-
+#include <atomic>
 #include <complex>
+#include <memory>
+#include <vector>
 
 #include <QtCore/QMutex>
 
@@ -48,6 +49,23 @@
 
 using DE_ComplexDoubleVector = std::vector<std::complex<double>>;
 
+/**
+ * @brief The DE_DetectedEllipse struct holds an ellipse found by a DetectEllipsoidsImpl until the filter merges the
+ * results of all threads into the ellipse feature arrays
+ */
+struct DE_DetectedEllipse
+{
+  int32_t featureId = 0;   // Feature the ellipse was found in
+  size_t ellipseIndex = 0; // Order in which the ellipse was found within its feature
+  double cenx = 0.0;
+  double ceny = 0.0;
+  double majaxis = 0.0;
+  double minaxis = 0.0;
+  double rotangle = 0.0;
+};
+
+using DE_EllipseBuffer = std::vector<DE_DetectedEllipse>;
+
 class DetectEllipsoidsImpl;
 
 #include "Processing/ProcessingDLLExport.h"
@@ -261,19 +279,11 @@ public:
   int getImageScaleBarLength() const;
   Q_PROPERTY(int ImageScaleBarLength READ getImageScaleBarLength WRITE setImageScaleBarLength)
 
-  void incrementEllipseCount();
-
   /**
-   * @brief getUniqueFeatureId
-   * @return
+   * @brief getNextFeatureId Hands out the features largest first so the threads pull new work as they finish
+   * @return The next feature to process, or -1 when all features have been handed out
    */
-  int32_t getUniqueFeatureId();
-
-  /**
-   * @brief getNextFeatureId
-   * @return
-   */
-  size_t getNextFeatureId();
+  int32_t getNextFeatureId();
 
   /**
    * @brief notifyFeatureCompleted
@@ -371,16 +381,13 @@ private:
   int m_ImageScaleBarLength = {100};
 
   static double m_img_scale_length;
-  int32_t m_MaxFeatureId = 0;
-  int32_t m_NextExecutedFeatureId = 1;
+  std::vector<int32_t> m_FeatureOrder;
+  std::atomic<size_t> m_NextFeatureIndex = {0};
   int32_t m_TotalNumberOfFeatures = 0;
   int32_t m_FeaturesCompleted = 0;
   size_t m_Ellipse_Count = 0;
 
-  QMutex m_MaxFeatureIdMutex;
-  QMutex m_NextExecutedFeatureIdMutex;
   QMutex m_FeaturesCompletedMutex;
-  QMutex m_IncrementCountMutex;
 
   int m_ThreadIndex = 0;
   QMap<int, int> m_ThreadWork;
@@ -392,6 +399,14 @@ private:
   DoubleArrayType::Pointer m_MinorAxisLengthArrayPtr;
   DoubleArrayType::Pointer m_RotationalAnglesArrayPtr;
 
+  /**
+   * @brief storeEllipses Writes the ellipses collected by all threads into the ellipse feature arrays. The first
+   * ellipse of a feature keeps the feature's id; every further one is numbered after the existing features in feature
+   * order, so the output does not depend on how the features were scheduled.
+   * @param threadEllipses Ellipses found by each thread
+   */
+  void storeEllipses(const std::vector<DE_EllipseBuffer>& threadEllipses);
+
   /**
    * @brief orientationFilter
    * @return
@@ -49,8 +49,95 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/NeighborMapTransfer.h"
+#include "Processing/ProcessingFilters/HelperClasses/PackedVoxelMask.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
+/**
+ * @brief findTransferSource Picks the face neighbor along the enabled axes whose values are copied into a voxel. When
+ * dilating the bad data a good voxel takes its last bad neighbor, and when eroding it a bad voxel takes the first
+ * Feature to reach the largest count among its neighbors.
+ */
+int64_t findTransferSource(const int32_t* featureIds, int64_t point, const int64_t dims[3], unsigned int direction, bool xDirOn, bool yDirOn, bool zDirOn)
+{
+  const int64_t plane = dims[0] * dims[1];
+  const int64_t i = point % dims[0];
+  const int64_t j = (point / dims[0]) % dims[1];
+  const int64_t k = point / plane;
+
+  int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
+  int32_t numNeighbors = 0;
+  if(zDirOn && k > 0)
+  {
+    neighbors[numNeighbors++] = point - plane;
+  }
+  if(yDirOn && j > 0)
+  {
+    neighbors[numNeighbors++] = point - dims[0];
+  }
+  if(xDirOn && i > 0)
+  {
+    neighbors[numNeighbors++] = point - 1;
+  }
+  if(xDirOn && i < dims[0] - 1)
+  {
+    neighbors[numNeighbors++] = point + 1;
+  }
+  if(yDirOn && j < dims[1] - 1)
+  {
+    neighbors[numNeighbors++] = point + dims[0];
+  }
+  if(zDirOn && k < dims[2] - 1)
+  {
+    neighbors[numNeighbors++] = point + plane;
+  }
+
+  int64_t source = -1;
+  if(direction == 0)
+  {
+    for(int32_t l = 0; l < numNeighbors; l++)
+    {
+      if(featureIds[neighbors[l]] == 0)
+      {
+        source = neighbors[l];
+      }
+    }
+    return source;
+  }
+
+  int32_t features[6] = {0, 0, 0, 0, 0, 0};
+  int32_t counts[6] = {0, 0, 0, 0, 0, 0};
+  int32_t numFeatures = 0;
+  int32_t most = 0;
+  for(int32_t l = 0; l < numNeighbors; l++)
+  {
+    const int32_t feature = featureIds[neighbors[l]];
+    if(feature <= 0)
+    {
+      continue;
+    }
+    int32_t slot = 0;
+    while(slot < numFeatures && features[slot] != feature)
+    {
+      slot++;
+    }
+    if(slot == numFeatures)
+    {
+      features[numFeatures++] = feature;
+    }
+    counts[slot]++;
+    if(counts[slot] > most)
+    {
+      most = counts[slot];
+      source = neighbors[l];
+    }
+  }
+  return source;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -102,7 +189,6 @@ void ErodeDilateBadData::setupFilterParameters()
 // -----------------------------------------------------------------------------
 void ErodeDilateBadData::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -142,11 +228,6 @@ void ErodeDilateBadData::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, std::string("_INTERNAL_USE_ONLY_Neighbors"), true);
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -156,164 +237,60 @@ void ErodeDilateBadData::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
-
-  for(size_t i = 0; i < totalPoints; i++)
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(m_FeatureIdsArrayPath.getAttributeMatrixName());
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+  }
+  std::vector<IDataArray::Pointer> voxelArrays;
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    voxelArrays.push_back(cellAttrMat->getAttributeArray(arrayName));
   }
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  QVector<int32_t> n(numfeatures + 1, 0);
+  // The voxels that change in an iteration are the ones of one kind with a face neighbor of the other kind, which is
+  // found for the whole volume with one packed dilation. Only those voxels look at their neighbors to pick a source.
+  PackedVoxelMask goodVoxels(dims);
+  PackedVoxelMask badVoxels(dims);
+  PackedVoxelMask frontier(dims);
+  goodVoxels.assign(m_FeatureIds, [](int32_t featureId) { return featureId > 0; });
+  badVoxels.assign(m_FeatureIds, [](int32_t featureId) { return featureId == 0; });
 
+  std::vector<int64_t> sources;
   for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
-    for(int64_t k = 0; k < dims[2]; k++)
+    if(getCancel())
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename == 0)
-          {
-            current = 0;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || !m_XDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || !m_XDirOn))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(m_Direction == 0 && feature > 0)
-                {
-                  m_Neighbors[neighpoint] = count;
-                }
-                if(feature > 0 && m_Direction == 1)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            if(m_Direction == 1)
-            {
-              for(int32_t l = 0; l < 6; l++)
-              {
-                good = 1;
-                neighpoint = count + neighpoints[l];
-                if(l == 0 && k == 0)
-                {
-                  good = 0;
-                }
-                if(l == 5 && k == (dims[2] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 1 && j == 0)
-                {
-                  good = 0;
-                }
-                if(l == 4 && j == (dims[1] - 1))
-                {
-                  good = 0;
-                }
-                if(l == 2 && i == 0)
-                {
-                  good = 0;
-                }
-                if(l == 3 && i == (dims[0] - 1))
-                {
-                  good = 0;
-                }
-                if(good == 1)
-                {
-                  feature = m_FeatureIds[neighpoint];              
-                  if(feature > 0)
-                  {
-                    n[feature] = 0;
-                  }
-                }
-              }
-            }
-          }
-        }
-      }
+      return;
     }
 
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
+    if(m_Direction == 0)
+    {
+      frontier.dilate(badVoxels, m_XDirOn, m_YDirOn, m_ZDirOn);
+      frontier.intersect(goodVoxels);
+    }
+    else
     {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
+      frontier.dilate(goodVoxels, m_XDirOn, m_YDirOn, m_ZDirOn);
+      frontier.intersect(badVoxels);
     }
 
-    for(size_t j = 0; j < totalPoints; j++)
+    std::vector<int64_t> cells = frontier.findSetVoxels();
+    sources.resize(cells.size());
+    for(size_t index = 0; index < cells.size(); index++)
     {
-      featurename = m_FeatureIds[j];
-      int32_t neighbor = m_Neighbors[j];
-      if(neighbor >= 0)
-      {
-        if((featurename == 0 && m_FeatureIds[neighbor] > 0 && m_Direction == 1) || (featurename > 0 && m_FeatureIds[neighbor] == 0 && m_Direction == 0))
-        {
-          for(const auto& arrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
+      sources[index] = findTransferSource(m_FeatureIds, cells[index], dims, m_Direction, m_XDirOn, m_YDirOn, m_ZDirOn);
+    }
+
+    // The sources of a pass are never written by that pass, so every array can be gathered directly
+    NeighborMapTransfer transfer(this, cells, sources);
+    transfer.execute(voxelArrays);
+
+    for(const auto& cell : cells)
+    {
+      goodVoxels.set(cell, m_FeatureIds[cell] > 0);
+      badVoxels.set(cell, m_FeatureIds[cell] == 0);
     }
   }
 }
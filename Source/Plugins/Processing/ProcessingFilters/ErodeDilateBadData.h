@@ -254,8 +254,6 @@ private:
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  int32_t* m_Neighbors;
-
 public:
   ErodeDilateBadData(const ErodeDilateBadData&) = delete;            // Copy Constructor Not Implemented
   ErodeDilateBadData(ErodeDilateBadData&&) = delete;                 // Move Constructor Not Implemented
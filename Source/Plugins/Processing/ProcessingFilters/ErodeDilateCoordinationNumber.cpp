@@ -34,6 +34,10 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "ErodeDilateCoordinationNumber.h"
 
+#include <functional>
+#include <queue>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -50,6 +54,124 @@
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
+constexpr uint8_t k_CurrentSweep = 1;
+constexpr uint8_t k_NextSweep = 2;
+
+/**
+ * @brief findFaceNeighbors Collects the in bounds face neighbors of a voxel in the order -Z, -Y, -X, +X, +Y, +Z
+ * @return Number of neighbors written to the neighbors array
+ */
+int32_t findFaceNeighbors(int64_t point, const int64_t dims[3], int64_t neighbors[6])
+{
+  const int64_t plane = dims[0] * dims[1];
+  const int64_t i = point % dims[0];
+  const int64_t j = (point / dims[0]) % dims[1];
+  const int64_t k = point / plane;
+  int32_t numNeighbors = 0;
+  if(k > 0)
+  {
+    neighbors[numNeighbors++] = point - plane;
+  }
+  if(j > 0)
+  {
+    neighbors[numNeighbors++] = point - dims[0];
+  }
+  if(i > 0)
+  {
+    neighbors[numNeighbors++] = point - 1;
+  }
+  if(i < dims[0] - 1)
+  {
+    neighbors[numNeighbors++] = point + 1;
+  }
+  if(j < dims[1] - 1)
+  {
+    neighbors[numNeighbors++] = point + dims[0];
+  }
+  if(k < dims[2] - 1)
+  {
+    neighbors[numNeighbors++] = point + plane;
+  }
+  return numNeighbors;
+}
+
+/**
+ * @brief countCoordination Counts the face neighbors on the other side of the good/bad interface. Only the sign
+ * of the Feature Ids matters, so the count of a voxel changes only when it or one of its neighbors is reassigned
+ */
+int32_t countCoordination(const int32_t* featureIds, int64_t point, const int64_t dims[3])
+{
+  int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
+  const int32_t numNeighbors = findFaceNeighbors(point, dims, neighbors);
+  const int32_t featurename = featureIds[point];
+  int32_t coordination = 0;
+  for(int32_t l = 0; l < numNeighbors; l++)
+  {
+    const int32_t feature = featureIds[neighbors[l]];
+    if((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
+    {
+      coordination++;
+    }
+  }
+  return coordination;
+}
+
+/**
+ * @brief findSource Picks the neighbor whose values are copied into a voxel. A bad voxel takes the first Feature to
+ * reach the largest count among its neighbors, a good voxel takes its last bad neighbor
+ * @return Index of the source voxel or -1 if there is none
+ */
+int64_t findSource(const int32_t* featureIds, int64_t point, const int64_t dims[3])
+{
+  int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
+  const int32_t numNeighbors = findFaceNeighbors(point, dims, neighbors);
+  const int32_t featurename = featureIds[point];
+  int64_t source = -1;
+  if(featurename > 0)
+  {
+    for(int32_t l = 0; l < numNeighbors; l++)
+    {
+      if(featureIds[neighbors[l]] == 0)
+      {
+        source = neighbors[l];
+      }
+    }
+    return source;
+  }
+
+  int32_t features[6] = {0, 0, 0, 0, 0, 0};
+  int32_t counts[6] = {0, 0, 0, 0, 0, 0};
+  int32_t numFeatures = 0;
+  int32_t most = 0;
+  for(int32_t l = 0; l < numNeighbors; l++)
+  {
+    const int32_t feature = featureIds[neighbors[l]];
+    if(feature <= 0)
+    {
+      continue;
+    }
+    int32_t slot = 0;
+    while(slot < numFeatures && features[slot] != feature)
+    {
+      slot++;
+    }
+    if(slot == numFeatures)
+    {
+      features[numFeatures++] = feature;
+    }
+    counts[slot]++;
+    if(counts[slot] > most)
+    {
+      most = counts[slot];
+      source = neighbors[l];
+    }
+  }
+  return source;
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -85,7 +207,6 @@ void ErodeDilateCoordinationNumber::setupFilterParameters()
 // -----------------------------------------------------------------------------
 void ErodeDilateCoordinationNumber::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -125,11 +246,7 @@ void ErodeDilateCoordinationNumber::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
-
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, std::string("Neighbors"), true);
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
+  int64_t totalPoints = static_cast<int64_t>(m_FeatureIdsPtr.lock()->getNumberOfTuples());
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -139,174 +256,104 @@ void ErodeDilateCoordinationNumber::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t coordination = 0;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-  size_t numfeatures = 0;
-
-  for(size_t i = 0; i < totalPoints; i++)
-  {
-    featurename = m_FeatureIds[i];
-    if(featurename > numfeatures)
-    {
-      numfeatures = featurename;
-    }
-  }
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
   QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  AttributeMatrix::Pointer attrMat = m->getAttributeMatrix(attrMatName);
+  QList<QString> voxelArrayNames = attrMat->getAttributeArrayNames();
   for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
+  std::vector<IDataArray::Pointer> voxelArrays;
+  voxelArrays.reserve(voxelArrayNames.size());
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    voxelArrays.push_back(attrMat->getAttributeArray(arrayName));
+  }
+
+  // The coordination numbers are computed once and then kept current as voxels are reassigned. A sweep visits the
+  // qualifying voxels in ascending order, so a voxel that starts to qualify behind the sweep waits for the next one
+  // while a voxel ahead of it joins the current one, exactly as a full scan of the volume would find them.
+  std::vector<int32_t> coordinationNumber(totalPoints, 0);
+  std::vector<uint8_t> queued(totalPoints, 0);
+  std::vector<int64_t> nextSweep;
+  for(int64_t point = 0; point < totalPoints; point++)
+  {
+    coordinationNumber[point] = countCoordination(m_FeatureIds, point, dims);
+    if(coordinationNumber[point] >= m_CoordinationNumber)
+    {
+      queued[point] = k_NextSweep;
+      nextSweep.push_back(point);
+    }
+  }
 
-  QVector<int32_t> n(numfeatures + 1, 0);
-  QVector<int32_t> coordinationNumber(totalPoints, 0);
+  int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
   bool keepgoing = true;
-  int32_t counter = 1;
+  size_t counter = 1;
 
   while(counter > 0 && keepgoing)
   {
+    if(getCancel())
+    {
+      return;
+    }
     counter = 0;
     if(!m_Loop)
     {
       keepgoing = false;
     }
 
-    for(int64_t k = 0; k < dims[2]; k++)
+    for(const auto& point : nextSweep)
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
+      queued[point] = k_CurrentSweep;
+    }
+    std::priority_queue<int64_t, std::vector<int64_t>, std::greater<>> sweep(std::greater<>(), std::move(nextSweep));
+    nextSweep.clear();
+
+    while(!sweep.empty())
+    {
+      int64_t point = sweep.top();
+      sweep.pop();
+      queued[point] = 0;
+      if(coordinationNumber[point] < m_CoordinationNumber)
+      {
+        continue;
+      }
+      counter++;
+
+      if(coordinationNumber[point] > 0)
       {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
+        int64_t source = findSource(m_FeatureIds, point, dims);
+        for(const auto& p : voxelArrays)
         {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          coordination = 0;
-          current = 0;
-          most = 0;
-          for(int32_t l = 0; l < 6; l++)
-          {
-            good = 1;
-            neighpoint = count + neighpoints[l];
-            if(l == 0 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && k == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
-            {
-              good = 0;
-            }
-            if(l == 4 && j == (dims[1] - 1))
-            {
-              good = 0;
-            }
-            if(l == 2 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && i == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if((featurename > 0 && feature == 0) || (featurename == 0 && feature > 0))
-              {
-                coordination = coordination + 1;
-                n[feature]++;
-                current = n[feature];
-                if(current > most)
-                {
-                  most = current;
-                  m_Neighbors[count] = neighpoint;
-                }
-              }
-            }
-          }
-          coordinationNumber[count] = coordination;
-          int32_t neighbor = m_Neighbors[count];
-          if(coordinationNumber[count] >= m_CoordinationNumber && coordinationNumber[count] > 0)
-          {
-            for(const auto& arrayName : voxelArrayNames)
-            {
-              IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName);
-              p->copyTuple(neighbor, count);
-            }
-          }
-          for(int32_t l = 0; l < 6; l++)
+          p->copyTuple(source, point);
+        }
+
+        int32_t numNeighbors = findFaceNeighbors(point, dims, neighbors);
+        for(int32_t l = 0; l < numNeighbors; l++)
+        {
+          int64_t neighpoint = neighbors[l];
+          coordinationNumber[neighpoint] = countCoordination(m_FeatureIds, neighpoint, dims);
+          if(coordinationNumber[neighpoint] >= m_CoordinationNumber && queued[neighpoint] == 0)
           {
-            good = 1;
-            neighpoint = count + neighpoints[l];
-            if(l == 0 && k == 0)
-            {
-              good = 0;
-            }
-            if(l == 5 && k == (dims[2] - 1))
-            {
-              good = 0;
-            }
-            if(l == 1 && j == 0)
+            if(neighpoint > point)
             {
-              good = 0;
+              queued[neighpoint] = k_CurrentSweep;
+              sweep.push(neighpoint);
             }
-            if(l == 4 && j == (dims[1] - 1))
+            else
             {
-              good = 0;
-            }
-            if(l == 2 && i == 0)
-            {
-              good = 0;
-            }
-            if(l == 3 && i == (dims[0] - 1))
-            {
-              good = 0;
-            }
-            if(good == 1)
-            {
-              feature = m_FeatureIds[neighpoint];
-              if(feature > 0)
-              {
-                n[feature] = 0;
-              }
+              queued[neighpoint] = k_NextSweep;
+              nextSweep.push_back(neighpoint);
             }
           }
         }
+        coordinationNumber[point] = countCoordination(m_FeatureIds, point, dims);
       }
-    }
-    for(int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = static_cast<int64_t>(dims[0] * dims[1] * k);
-      for(int64_t j = 0; j < dims[1]; j++)
+
+      if(coordinationNumber[point] >= m_CoordinationNumber)
       {
-        jstride = static_cast<int64_t>(dims[0] * j);
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          if(coordinationNumber[count] >= m_CoordinationNumber)
-          {
-            counter++;
-          }
-        }
+        queued[point] = k_NextSweep;
+        nextSweep.push_back(point);
       }
     }
   }
@@ -211,8 +211,6 @@ private:
   DataArrayPath m_FeatureIdsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  int32_t* m_Neighbors = nullptr;
-
 public:
   ErodeDilateCoordinationNumber(const ErodeDilateCoordinationNumber&) = delete;            // Copy Constructor Not Implemented
   ErodeDilateCoordinationNumber(ErodeDilateCoordinationNumber&&) = delete;                 // Move Constructor Not Implemented
@@ -48,6 +48,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/PackedVoxelMask.h"
 #include "Processing/ProcessingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -97,7 +98,6 @@ void ErodeDilateMask::setupFilterParameters()
 // -----------------------------------------------------------------------------
 void ErodeDilateMask::initialize()
 {
-  m_MaskCopy = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -137,11 +137,6 @@ void ErodeDilateMask::execute()
   }
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_MaskArrayPath.getDataContainerName());
-  size_t totalPoints = m_MaskPtr.lock()->getNumberOfTuples();
-
-  BoolArrayType::Pointer maskCopyPtr = BoolArrayType::CreateArray(totalPoints, std::string("_INTERNAL_USE_ONLY_MaskCopy"), true);
-  m_MaskCopy = maskCopyPtr->getPointer(0);
-  maskCopyPtr->initializeWithValue(false);
 
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
@@ -151,86 +146,31 @@ void ErodeDilateMask::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int64_t neighpoint = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
+  // A voxel is eroded when one of its face neighbors is outside the mask, so eroding the mask is the same as
+  // dilating its complement. Every iteration is one shift and OR pass over the packed words.
+  PackedVoxelMask mask(dims);
+  PackedVoxelMask maskCopy(dims);
+  mask.assign(m_Mask, [](bool value) { return value; });
+  if(m_Direction == 1)
+  {
+    mask.invert();
+  }
 
   for(int32_t iteration = 0; iteration < m_NumIterations; iteration++)
   {
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      m_MaskCopy[j] = m_Mask[j];
-    }
-    for(int64_t k = 0; k < dims[2]; k++)
+    if(getCancel())
     {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          
-          if(!m_Mask[count])
-          {
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && (k == 0 || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 5 && (k == (dims[2] - 1) || !m_ZDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 1 && (j == 0 || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 4 && (j == (dims[1] - 1) || !m_YDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 2 && (i == 0 || !m_XDirOn))
-              {
-                good = 0;
-              }
-              else if(l == 3 && (i == (dims[0] - 1) || !m_XDirOn))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                if(m_Direction == 0 && m_Mask[neighpoint])
-                {
-                  m_MaskCopy[count] = true;
-                }
-                if(m_Direction == 1 && m_Mask[neighpoint])
-                {
-                  m_MaskCopy[neighpoint] = false;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      m_Mask[j] = m_MaskCopy[j];
+      return;
     }
+    maskCopy.dilate(mask, m_XDirOn, m_YDirOn, m_ZDirOn);
+    mask.swap(maskCopy);
+  }
+
+  if(m_Direction == 1)
+  {
+    mask.invert();
   }
+  mask.copyTo(m_Mask);
 }
 
 // -----------------------------------------------------------------------------
@@ -238,8 +238,6 @@ private:
   bool m_ZDirOn = {true};
   DataArrayPath m_MaskArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask};
 
-  bool* m_MaskCopy = {nullptr};
-
 public:
   ErodeDilateMask(const ErodeDilateMask&) = delete;            // Copy Constructor Not Implemented
   ErodeDilateMask(ErodeDilateMask&&) = delete;                 // Move Constructor Not Implemented
@@ -34,11 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindProjectedImageStatistics.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -54,96 +54,278 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
 /**
- * @brief The CalcProjectedStatsImpl class implements a templated threaded algorithm for
- * determining the projected image statistics of a given volume.
+ * @brief The ProjectionMoments struct holds the running Welford statistics of one projection line
  */
-template <typename T>
-class CalcProjectedStatsImpl
+struct ProjectionMoments
+{
+  double mean = 0.0;
+  double m2 = 0.0;
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+};
+
+/**
+ * @brief The ProjectedStats struct holds the final statistics of one projection line
+ */
+struct ProjectedStats
+{
+  float min = 0.0f;
+  float max = 0.0f;
+  float avg = 0.0f;
+  float stdDev = 0.0f;
+  float var = 0.0f;
+};
+
+/**
+ * @brief addValue Adds the count-th value of a line to its moments
+ */
+inline void addValue(ProjectionMoments& moments, double value, size_t count)
 {
+  double delta = value - moments.mean;
+  moments.mean += delta / static_cast<double>(count);
+  moments.m2 += delta * (value - moments.mean);
+  moments.min = std::min(moments.min, value);
+  moments.max = std::max(moments.max, value);
+}
 
+/**
+ * @brief mergeMoments Merges the moments of countB values into moments that already cover countA values
+ */
+inline void mergeMoments(ProjectionMoments& moments, size_t countA, const ProjectionMoments& other, size_t countB)
+{
+  double total = static_cast<double>(countA + countB);
+  double delta = other.mean - moments.mean;
+  moments.mean += delta * static_cast<double>(countB) / total;
+  moments.m2 += other.m2 + delta * delta * static_cast<double>(countA) * static_cast<double>(countB) / total;
+  moments.min = std::min(moments.min, other.min);
+  moments.max = std::max(moments.max, other.max);
+}
+} // namespace
+
+/**
+ * @brief The ProjectedStatsSlabImpl class accumulates the Z projection of a range of slabs. Each slab walks its
+ * planes in memory order into its own set of moments, which are merged once every slab is done.
+ */
+template <typename T>
+class ProjectedStatsSlabImpl
+{
 public:
-  CalcProjectedStatsImpl(T* data, float* min, float* max, float* avg, float* std, float* var, int32_t* startPoints, size_t stride, size_t depth)
+  ProjectedStatsSlabImpl(const T* data, size_t plane, size_t slabDepth, size_t depth, std::vector<std::vector<ProjectionMoments>>& slabMoments)
   : m_Data(data)
-  , m_Min(min)
-  , m_Max(max)
-  , m_Avg(avg)
-  , m_Std(std)
-  , m_Var(var)
-  , m_StartPoints(startPoints)
-  , m_Stride(stride)
+  , m_Plane(plane)
+  , m_SlabDepth(slabDepth)
   , m_Depth(depth)
+  , m_SlabMoments(slabMoments)
   {
   }
-  virtual ~CalcProjectedStatsImpl() = default;
 
-  void convert(size_t start, size_t end) const
+  void operator()(const SIMPLRange& range) const
   {
-    int32_t point = 0, newPoint = 0;
-    T val = static_cast<T>(0);
-    for(size_t i = start; i < end; i++)
+    for(size_t slab = range.min(); slab < range.max(); slab++)
     {
-      point = m_StartPoints[i];
-      m_Min[point] = m_Data[point];
-      m_Max[point] = m_Data[point];
-      m_Avg[point] = m_Data[point];
-      for(size_t j = 0; j < m_Depth; j++)
+      std::vector<ProjectionMoments>& moments = m_SlabMoments[slab];
+      moments.assign(m_Plane, ProjectionMoments());
+      size_t zStart = slab * m_SlabDepth;
+      size_t zEnd = std::min(zStart + m_SlabDepth, m_Depth);
+      for(size_t z = zStart; z < zEnd; z++)
       {
-        newPoint = static_cast<int32_t>(point + (j * m_Stride));
-        val = m_Data[newPoint];
-        if(val < m_Min[point])
+        const T* planeData = m_Data + z * m_Plane;
+        size_t count = z - zStart + 1;
+        for(size_t pixel = 0; pixel < m_Plane; pixel++)
         {
-          m_Min[point] = val;
+          addValue(moments[pixel], static_cast<double>(planeData[pixel]), count);
         }
-        if(val > m_Max[point])
+      }
+    }
+  }
+
+private:
+  const T* m_Data = nullptr;
+  size_t m_Plane = 0;
+  size_t m_SlabDepth = 0;
+  size_t m_Depth = 0;
+  std::vector<std::vector<ProjectionMoments>>& m_SlabMoments;
+};
+
+/**
+ * @brief The ProjectedStatsPlaneImpl class accumulates the Y or X projection of a range of Z planes. The lines of
+ * these projections never leave their Z plane, so every plane is read once in memory order.
+ */
+template <typename T>
+class ProjectedStatsPlaneImpl
+{
+public:
+  ProjectedStatsPlaneImpl(const T* data, const SizeVec3Type& dims, bool alongX, std::vector<ProjectionMoments>& moments)
+  : m_Data(data)
+  , m_Dims(dims)
+  , m_AlongX(alongX)
+  , m_Moments(moments)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t plane = m_Dims[0] * m_Dims[1];
+    for(size_t z = range.min(); z < range.max(); z++)
+    {
+      for(size_t y = 0; y < m_Dims[1]; y++)
+      {
+        const T* rowData = m_Data + z * plane + y * m_Dims[0];
+        if(m_AlongX)
+        {
+          ProjectionMoments& moments = m_Moments[z * m_Dims[1] + y];
+          for(size_t x = 0; x < m_Dims[0]; x++)
+          {
+            addValue(moments, static_cast<double>(rowData[x]), x + 1);
+          }
+        }
+        else
         {
-          m_Max[point] = val;
+          ProjectionMoments* moments = m_Moments.data() + z * m_Dims[0];
+          for(size_t x = 0; x < m_Dims[0]; x++)
+          {
+            addValue(moments[x], static_cast<double>(rowData[x]), y + 1);
+          }
         }
-        m_Avg[point] += val;
       }
-      m_Avg[point] /= m_Depth;
-      for(size_t j = 0; j < m_Depth; j++)
+    }
+  }
+
+private:
+  const T* m_Data = nullptr;
+  SizeVec3Type m_Dims;
+  bool m_AlongX = false;
+  std::vector<ProjectionMoments>& m_Moments;
+};
+
+/**
+ * @brief The ProjectedStatsWriteImpl class copies the statistics of every projection line back onto the voxels of
+ * the line for a range of Z planes, writing the output arrays in memory order.
+ */
+class ProjectedStatsWriteImpl
+{
+public:
+  ProjectedStatsWriteImpl(const std::vector<ProjectedStats>& stats, const SizeVec3Type& dims, unsigned int plane, float* min, float* max, float* avg, float* stdDev, float* var)
+  : m_Stats(stats)
+  , m_Dims(dims)
+  , m_Plane(plane)
+  , m_Min(min)
+  , m_Max(max)
+  , m_Avg(avg)
+  , m_Std(stdDev)
+  , m_Var(var)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t z = range.min(); z < range.max(); z++)
+    {
+      for(size_t y = 0; y < m_Dims[1]; y++)
       {
-        newPoint = static_cast<int32_t>(point + (j * m_Stride));
-        val = m_Data[newPoint];
-        m_Min[newPoint] = m_Min[point];
-        m_Max[newPoint] = m_Max[point];
-        m_Avg[newPoint] = m_Avg[point];
-        m_Std[point] += ((val - m_Avg[point]) * (val - m_Avg[point]));
+        size_t rowStart = (z * m_Dims[1] + y) * m_Dims[0];
+        for(size_t x = 0; x < m_Dims[0]; x++)
+        {
+          size_t pixel = 0;
+          if(m_Plane == 0)
+          {
+            pixel = y * m_Dims[0] + x;
+          }
+          else if(m_Plane == 1)
+          {
+            pixel = z * m_Dims[0] + x;
+          }
+          else
+          {
+            pixel = z * m_Dims[1] + y;
+          }
+          const ProjectedStats& stats = m_Stats[pixel];
+          size_t index = rowStart + x;
+          m_Min[index] = stats.min;
+          m_Max[index] = stats.max;
+          m_Avg[index] = stats.avg;
+          m_Std[index] = stats.stdDev;
+          m_Var[index] = stats.var;
+        }
       }
-      m_Std[point] /= m_Depth;
-      m_Var[point] = m_Std[point];
-      m_Std[point] = sqrt(m_Std[point]);
-      for(size_t j = 0; j < m_Depth; j++)
+    }
+  }
+
+private:
+  const std::vector<ProjectedStats>& m_Stats;
+  SizeVec3Type m_Dims;
+  unsigned int m_Plane = 0;
+  float* m_Min = nullptr;
+  float* m_Max = nullptr;
+  float* m_Avg = nullptr;
+  float* m_Std = nullptr;
+  float* m_Var = nullptr;
+};
+
+/**
+ * @brief findProjectedStatistics Accumulates the statistics of every projection line of data, then finalizes them
+ * @return Statistics of each line, indexed by its position in the plane of interest
+ */
+template <typename T>
+std::vector<ProjectedStats> findProjectedStatistics(const T* data, const SizeVec3Type& dims, unsigned int plane)
+{
+  std::vector<ProjectionMoments> moments;
+  size_t depth = 0;
+  if(plane == 0)
+  {
+    size_t planeSize = dims[0] * dims[1];
+    depth = dims[2];
+    size_t numSlabs = std::min<size_t>(depth, std::max(1u, std::thread::hardware_concurrency()));
+    size_t slabDepth = (depth + numSlabs - 1) / numSlabs;
+    numSlabs = (depth + slabDepth - 1) / slabDepth;
+
+    std::vector<std::vector<ProjectionMoments>> slabMoments(numSlabs);
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numSlabs);
+    dataAlg.execute(ProjectedStatsSlabImpl<T>(data, planeSize, slabDepth, depth, slabMoments));
+
+    moments.swap(slabMoments[0]);
+    for(size_t slab = 1; slab < numSlabs; slab++)
+    {
+      size_t countA = slab * slabDepth;
+      size_t countB = std::min(slabDepth, depth - countA);
+      for(size_t pixel = 0; pixel < planeSize; pixel++)
       {
-        newPoint = point + (j * m_Stride);
-        m_Std[newPoint] = m_Std[point];
-        m_Var[newPoint] = m_Var[point];
+        mergeMoments(moments[pixel], countA, slabMoments[slab][pixel], countB);
       }
+      std::vector<ProjectionMoments>().swap(slabMoments[slab]);
     }
   }
+  else
+  {
+    bool alongX = (plane == 2);
+    depth = alongX ? dims[0] : dims[1];
+    moments.resize(dims[2] * (alongX ? dims[1] : dims[0]));
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, dims[2]);
+    dataAlg.execute(ProjectedStatsPlaneImpl<T>(data, dims, alongX, moments));
+  }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  std::vector<ProjectedStats> stats(moments.size());
+  for(size_t pixel = 0; pixel < moments.size(); pixel++)
   {
-    convert(r.begin(), r.end());
+    double var = moments[pixel].m2 / static_cast<double>(depth);
+    stats[pixel].min = static_cast<float>(moments[pixel].min);
+    stats[pixel].max = static_cast<float>(moments[pixel].max);
+    stats[pixel].avg = static_cast<float>(moments[pixel].mean);
+    stats[pixel].var = static_cast<float>(var);
+    stats[pixel].stdDev = static_cast<float>(std::sqrt(var));
   }
-#endif
-private:
-  T* m_Data;
-  float* m_Min;
-  float* m_Max;
-  float* m_Avg;
-  float* m_Std;
-  float* m_Var;
-  int32_t* m_StartPoints;
-  size_t m_Stride;
-  size_t m_Depth;
-};
+  return stats;
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -312,208 +494,80 @@ void FindProjectedImageStatistics::execute()
 
   SizeVec3Type geoDims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
-  Int32ArrayType::Pointer startingPoints = Int32ArrayType::CreateArray(0, std::string("_INTERNAL_USE_ONLY_startingPoints"), true);
-  int32_t* startPoints = nullptr;
-  size_t stride = 0, yStride = 0;
-  size_t count = 0;
-  size_t depth = 0;
-  if(m_Plane == 0)
-  {
-    startingPoints->resizeTuples(geoDims[0] * geoDims[1]);
-    startPoints = startingPoints->getPointer(0);
-    stride = geoDims[0] * geoDims[1];
-    depth = geoDims[2];
-    for(size_t i = 0; i < geoDims[1]; i++)
-    {
-      yStride = i * geoDims[0];
-      for(size_t j = 0; j < geoDims[0]; j++)
-      {
-        startPoints[count] = yStride + j;
-        count++;
-      }
-    }
-  }
-  if(m_Plane == 1)
-  {
-    startingPoints->resizeTuples(geoDims[0] * geoDims[2]);
-    startPoints = startingPoints->getPointer(0);
-    stride = geoDims[0];
-    depth = geoDims[1];
-    for(size_t i = 0; i < geoDims[2]; i++)
-    {
-      yStride = i * geoDims[0] * geoDims[1];
-      for(size_t j = 0; j < geoDims[0]; j++)
-      {
-        startPoints[count] = yStride + j;
-        count++;
-      }
-    }
-  }
-  if(m_Plane == 2)
-  {
-    startingPoints->resizeTuples(geoDims[1] * geoDims[2]);
-    startPoints = startingPoints->getPointer(0);
-    stride = 1;
-    depth = geoDims[0];
-    for(size_t i = 0; i < geoDims[2]; i++)
-    {
-      yStride = i * geoDims[0] * geoDims[1];
-      for(size_t j = 0; j < geoDims[1]; j++)
-      {
-        startPoints[count] = yStride + (j * geoDims[0]);
-        count++;
-      }
-    }
-  }
-
-  if(nullptr == startPoints)
+  if(m_Plane > 2)
   {
     QString ss = QObject::tr("Unable to establish starting location for supplied plane. The plane is %1").arg(m_Plane);
     setErrorCondition(-11001, ss);
     return;
   }
 
-  if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(m_InDataPtr.lock()))
+  IDataArray::Pointer inputData = m_InDataPtr.lock();
+  std::vector<ProjectedStats> stats;
+  if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(inputData))
   {
-    Int8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int8ArrayType>(m_InDataPtr.lock());
-    int8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<int8_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-
-#else
-    CalcProjectedStatsImpl<int8_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+    Int8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int8ArrayType>(inputData);
+    stats = findProjectedStatistics<int8_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt8ArrayType>(m_InDataPtr.lock());
-    uint8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<uint8_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-
-#else
-    CalcProjectedStatsImpl<uint8_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(inputData))
+  {
+    UInt8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt8ArrayType>(inputData);
+    stats = findProjectedStatistics<uint8_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int16ArrayType>(m_InDataPtr.lock());
-    int16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<int16_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-#else
-    CalcProjectedStatsImpl<int16_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(inputData))
+  {
+    Int16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int16ArrayType>(inputData);
+    stats = findProjectedStatistics<int16_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt16ArrayType>(m_InDataPtr.lock());
-    uint16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<uint16_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-#else
-    CalcProjectedStatsImpl<uint16_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(inputData))
+  {
+    UInt16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt16ArrayType>(inputData);
+    stats = findProjectedStatistics<uint16_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int32ArrayType>(m_InDataPtr.lock());
-    int32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<int32_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-
-#else
-    CalcProjectedStatsImpl<int32_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(inputData))
+  {
+    Int32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int32ArrayType>(inputData);
+    stats = findProjectedStatistics<int32_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt32ArrayType>(m_InDataPtr.lock());
-    uint32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<uint32_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-
-#else
-    CalcProjectedStatsImpl<uint32_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(inputData))
+  {
+    UInt32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt32ArrayType>(inputData);
+    stats = findProjectedStatistics<uint32_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(m_InDataPtr.lock()))
-  {
-    Int64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int64ArrayType>(m_InDataPtr.lock());
-    int64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<int64_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-
-#else
-    CalcProjectedStatsImpl<int64_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(inputData))
+  {
+    Int64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int64ArrayType>(inputData);
+    stats = findProjectedStatistics<int64_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(m_InDataPtr.lock()))
-  {
-    UInt64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt64ArrayType>(m_InDataPtr.lock());
-    uint64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<uint64_t>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-#else
-    CalcProjectedStatsImpl<uint64_t> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(inputData))
+  {
+    UInt64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt64ArrayType>(inputData);
+    stats = findProjectedStatistics<uint64_t>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(m_InDataPtr.lock()))
-  {
-    FloatArrayType::Pointer cellArray = std::dynamic_pointer_cast<FloatArrayType>(m_InDataPtr.lock());
-    float* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<float>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-#else
-    CalcProjectedStatsImpl<float> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(inputData))
+  {
+    FloatArrayType::Pointer cellArray = std::dynamic_pointer_cast<FloatArrayType>(inputData);
+    stats = findProjectedStatistics<float>(cellArray->getPointer(0), geoDims, m_Plane);
   }
-  else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(m_InDataPtr.lock()))
-  {
-    DoubleArrayType::Pointer cellArray = std::dynamic_pointer_cast<DoubleArrayType>(m_InDataPtr.lock());
-    double* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
-                      CalcProjectedStatsImpl<double>(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth),
-                      tbb::auto_partitioner());
-#else
-    CalcProjectedStatsImpl<double> serial(cPtr, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar, startPoints, stride, depth);
-    serial.convert(0, count);
-#endif
+  else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(inputData))
+  {
+    DoubleArrayType::Pointer cellArray = std::dynamic_pointer_cast<DoubleArrayType>(inputData);
+    stats = findProjectedStatistics<double>(cellArray->getPointer(0), geoDims, m_Plane);
   }
   else
   {
-    QString ss = QObject::tr("Selected array is of unsupported type. The type is %1").arg(m_InDataPtr.lock()->getTypeAsString());
+    QString ss = QObject::tr("Selected array is of unsupported type. The type is %1").arg(inputData->getTypeAsString());
     setErrorCondition(-11001, ss);
     return;
   }
+
+  if(getCancel())
+  {
+    return;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, geoDims[2]);
+  dataAlg.execute(ProjectedStatsWriteImpl(stats, geoDims, m_Plane, m_ProjectedImageMin, m_ProjectedImageMax, m_ProjectedImageAvg, m_ProjectedImageStd, m_ProjectedImageVar));
 }
 
 // -----------------------------------------------------------------------------
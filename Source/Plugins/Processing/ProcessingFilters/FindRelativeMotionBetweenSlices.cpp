@@ -34,11 +34,11 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindRelativeMotionBetweenSlices.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/partitioner.h>
-#endif
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -55,10 +55,21 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
+// The patch norms come from double sums over whole slices, so two norms of equal patches can differ by a tiny
+// fraction of their size
+constexpr float k_NormSlack = 1.0E-6f;
+// The squared differences are summed in float, which can undercount a sum of up to about ten thousand terms by this
+// fraction
+constexpr float k_SumSlack = 1.0E-3f;
+} // namespace
+
 /**
  * @brief The CalcRelativeMotion class implements a templated threaded algorithm for
  * determining the relative motion between a series of slices through a 3D volume.
@@ -68,60 +79,186 @@ class CalcRelativeMotion
 {
 
 public:
-  CalcRelativeMotion(T* data, float* motionDir, int32_t* patchPoints, int32_t* searchPoints, bool* validPoints, size_t numPP, size_t numSP)
+  CalcRelativeMotion(T* data, float* motionDir, int32_t* patchPoints, int32_t* searchPoints, bool* validPoints, const float* patchNorms, size_t numPP, size_t numSP)
   : m_Data(data)
   , m_MotionDirection(motionDir)
   , m_PatchPoints(patchPoints)
   , m_SearchPoints(searchPoints)
   , m_ValidPoints(validPoints)
+  , m_PatchNorms(patchNorms)
   , m_NumPatchPoints(numPP)
   , m_NumSearchPoints(numSP)
   {
   }
   virtual ~CalcRelativeMotion() = default;
 
-  void convert(size_t start, size_t end) const
-  {
-    int32_t patchPoint = 0, comparePoint = 0;
-    float val = 0.0f, minVal = 0.0f;
-    for(size_t i = start; i < end; i++)
+  /**
+   * @brief PatchNorms Computes, for every voxel whose patch fits inside the volume, the square root of the sum of the
+   * squared values over the patch around it. The sums are read from an integral image of squares over the two patch
+   * axes, so each one costs four lookups whatever the patch size.
+   * @param data Input array
+   * @param dims Volume dimensions
+   * @param plane Plane of interest, as in FindRelativeMotionBetweenSlices
+   * @param pSize1 First patch dimension
+   * @param pSize2 Second patch dimension
+   * @return One norm per voxel, zero where the patch does not fit
+   */
+  static std::vector<float> PatchNorms(const T* data, const int64_t dims[3], uint32_t plane, int32_t pSize1, int32_t pSize2)
+  {
+    // Extents and strides of the two patch axes, then of the axis the slices step along
+    std::array<int64_t, 3> extent = {dims[0], dims[1], dims[2]};
+    std::array<int64_t, 3> stride = {1, dims[0], dims[0] * dims[1]};
+    if(plane == 1)
+    {
+      extent = {dims[0], dims[2], dims[1]};
+      stride = {1, dims[0] * dims[1], dims[0]};
+    }
+    if(plane == 2)
     {
-      if(m_ValidPoints[i] == true)
+      extent = {dims[1], dims[2], dims[0]};
+      stride = {dims[0], dims[0] * dims[1], 1};
+    }
+
+    size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    std::vector<double> integral(totalPoints, 0.0);
+    for(int64_t c = 0; c < extent[2]; c++)
+    {
+      for(int64_t b = 0; b < extent[1]; b++)
       {
-        minVal = std::numeric_limits<float>::max();
-        for(size_t j = 0; j < m_NumSearchPoints; j++)
+        for(int64_t a = 0; a < extent[0]; a++)
         {
-          val = 0;
-          for(size_t k = 0; k < m_NumPatchPoints; k++)
+          int64_t point = a * stride[0] + b * stride[1] + c * stride[2];
+          double value = static_cast<double>(data[point]);
+          double sum = value * value;
+          if(a > 0)
           {
-            patchPoint = i + m_PatchPoints[k];
-            comparePoint = patchPoint + m_SearchPoints[4 * j];
-            val += float((m_Data[patchPoint] - m_Data[comparePoint])) * float((m_Data[patchPoint] - m_Data[comparePoint]));
+            sum += integral[point - stride[0]];
           }
-          if(val < minVal)
+          if(b > 0)
           {
-            minVal = val;
-            m_MotionDirection[3 * i + 0] = m_SearchPoints[4 * j + 1];
-            m_MotionDirection[3 * i + 1] = m_SearchPoints[4 * j + 2];
-            m_MotionDirection[3 * i + 2] = m_SearchPoints[4 * j + 3];
+            sum += integral[point - stride[1]];
           }
+          if(a > 0 && b > 0)
+          {
+            sum -= integral[point - stride[0] - stride[1]];
+          }
+          integral[point] = sum;
         }
       }
     }
+
+    // The patch covers offsets [-pSize / 2, pSize / 2) along each axis, so its sum is read between the corners just
+    // outside the low end and at the high end
+    auto corner = [&](int64_t a, int64_t b, int64_t c) { return (a < 0 || b < 0) ? 0.0 : integral[a * stride[0] + b * stride[1] + c * stride[2]]; };
+    int64_t half1 = pSize1 / 2;
+    int64_t half2 = pSize2 / 2;
+    std::vector<float> norms(totalPoints, 0.0f);
+    for(int64_t c = 0; c < extent[2]; c++)
+    {
+      for(int64_t b = half2; b < std::min(extent[1], extent[1] - half2 + 1); b++)
+      {
+        for(int64_t a = half1; a < std::min(extent[0], extent[0] - half1 + 1); a++)
+        {
+          double sum = corner(a + half1 - 1, b + half2 - 1, c) - corner(a - half1 - 1, b + half2 - 1, c) - corner(a + half1 - 1, b - half2 - 1, c) + corner(a - half1 - 1, b - half2 - 1, c);
+          norms[a * stride[0] + b * stride[1] + c * stride[2]] = static_cast<float>(std::sqrt(std::max(sum, 0.0)));
+        }
+      }
+    }
+    return norms;
   }
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  void operator()(const tbb::blocked_range<size_t>& r) const
+  /**
+   * @brief isPruned Checks whether two patches with norms |a| and |b| must differ by more than limit, using the lower
+   * bound (|a| - |b|)^2 on their squared difference. Both slacks keep the pruning exact under rounding.
+   */
+  bool isPruned(float patchNorm, float searchNorm, float limit) const
   {
-    convert(r.begin(), r.end());
+    float difference = std::abs(patchNorm - searchNorm) - k_NormSlack * (patchNorm + searchNorm);
+    return difference > 0.0f && difference * difference > limit * (1.0f + k_SumSlack);
   }
-#endif
+
+  /**
+   * @brief patchDifference Sums the squared differences between the patch around point and the patch of the search
+   * point. The partial sums never decrease, so the sum is abandoned as soon as it exceeds limit.
+   * @return The full sum, or a partial sum larger than limit
+   */
+  float patchDifference(size_t point, size_t searchPoint, float limit) const
+  {
+    float val = 0.0f;
+    int64_t offset = m_SearchPoints[4 * searchPoint];
+    for(size_t k = 0; k < m_NumPatchPoints; k++)
+    {
+      int64_t patchPoint = static_cast<int64_t>(point) + m_PatchPoints[k];
+      int64_t comparePoint = patchPoint + offset;
+      val += float((m_Data[patchPoint] - m_Data[comparePoint])) * float((m_Data[patchPoint] - m_Data[comparePoint]));
+      if(val > limit)
+      {
+        return val;
+      }
+    }
+    return val;
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    // Neighboring patches usually move the same way, so the best search point of the previous patch is tried first
+    // to give a tight bound. The other search points are skipped when the norms of the two patches alone rule them
+    // out. Ties still go to the earliest search point, as in a plain scan of the search window.
+    size_t previousBest = m_NumSearchPoints;
+    for(size_t i = start; i < end; i++)
+    {
+      if(!m_ValidPoints[i])
+      {
+        continue;
+      }
+
+      size_t best = m_NumSearchPoints;
+      float minVal = std::numeric_limits<float>::max();
+      if(previousBest < m_NumSearchPoints)
+      {
+        float val = patchDifference(i, previousBest, minVal);
+        if(val < minVal)
+        {
+          minVal = val;
+          best = previousBest;
+        }
+      }
+      for(size_t j = 0; j < m_NumSearchPoints; j++)
+      {
+        if(j == previousBest || isPruned(m_PatchNorms[i], m_PatchNorms[static_cast<int64_t>(i) + m_SearchPoints[4 * j]], minVal))
+        {
+          continue;
+        }
+        float val = patchDifference(i, j, minVal);
+        if(val < minVal || (val == minVal && j < best))
+        {
+          minVal = val;
+          best = j;
+        }
+      }
+
+      if(best < m_NumSearchPoints)
+      {
+        m_MotionDirection[3 * i + 0] = m_SearchPoints[4 * best + 1];
+        m_MotionDirection[3 * i + 1] = m_SearchPoints[4 * best + 2];
+        m_MotionDirection[3 * i + 2] = m_SearchPoints[4 * best + 3];
+      }
+      previousBest = best;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    convert(range.min(), range.max());
+  }
+
 private:
   T* m_Data;
   float* m_MotionDirection;
   int32_t* m_PatchPoints;
   int32_t* m_SearchPoints;
   bool* m_ValidPoints;
+  const float* m_PatchNorms;
   size_t m_NumPatchPoints;
   size_t m_NumSearchPoints;
 };
@@ -307,13 +444,15 @@ void FindRelativeMotionBetweenSlices::execute()
   int64_t yP = static_cast<int64_t>(image->getYPoints());
   int64_t zP = static_cast<int64_t>(image->getZPoints());
   size_t totalPoints = xP * yP * zP;
+  const int64_t dims[3] = {xP, yP, zP};
 
   int32_t buffer1 = (m_PSize1 / 2) + (m_SSize1 / 2);
-  int32_t buffer2 = (m_PSize2 / 2) + (m_SSize1 / 2);
+  int32_t buffer2 = (m_PSize2 / 2) + (m_SSize2 / 2);
 
+  // The search window spans -(SSize / 2) to SSize / 2 inclusive, which is one point more than SSize when it is even
   std::vector<size_t> cDims(1, 4);
   Int32ArrayType::Pointer patchPointsPtr = Int32ArrayType::CreateArray((m_PSize1 * m_PSize2), std::string("_INTERNAL_USE_ONLY_patchPoints"), true);
-  Int32ArrayType::Pointer searchPointsPtr = Int32ArrayType::CreateArray((m_SSize1 * m_SSize2), cDims, "_INTERNAL_USE_ONLY_searchPoints", true);
+  Int32ArrayType::Pointer searchPointsPtr = Int32ArrayType::CreateArray((2 * (m_SSize1 / 2) + 1) * (2 * (m_SSize2 / 2) + 1), cDims, "_INTERNAL_USE_ONLY_searchPoints", true);
   BoolArrayType::Pointer validPointsPtr = BoolArrayType::CreateArray(totalPoints, std::string("_INTERNAL_USE_ONLY_validPoints"), true);
   validPointsPtr->initializeWithValue(false);
   int32_t* patchPoints = patchPointsPtr->getPointer(0);
@@ -381,7 +520,7 @@ void FindRelativeMotionBetweenSlices::execute()
       yStride = (j * xP * yP);
       for(int32_t i = -(m_SSize1 / 2); i <= (m_SSize1 / 2); i++)
       {
-        searchPoints[count] = (m_SliceStep * xP) + yStride + i;
+        searchPoints[4 * count] = (m_SliceStep * xP) + yStride + i;
         searchPoints[4 * count + 1] = i;
         searchPoints[4 * count + 2] = m_SliceStep;
         searchPoints[4 * count + 3] = j;
@@ -421,7 +560,7 @@ void FindRelativeMotionBetweenSlices::execute()
       yStride = (j * xP * yP);
       for(int32_t i = -(m_SSize1 / 2); i <= (m_SSize1 / 2); i++)
       {
-        searchPoints[count] = (m_SliceStep) + yStride + (i * xP);
+        searchPoints[4 * count] = (m_SliceStep) + yStride + (i * xP);
         searchPoints[4 * count + 1] = m_SliceStep;
         searchPoints[4 * count + 2] = i;
         searchPoints[4 * count + 3] = j;
@@ -450,125 +589,77 @@ void FindRelativeMotionBetweenSlices::execute()
     return;
   }
 
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, totalPoints);
   if(TemplateHelpers::CanDynamicCast<Int8ArrayType>()(m_InDataPtr.lock()))
   {
     Int8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int8ArrayType>(m_InDataPtr.lock());
     int8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<int8_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<int8_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<int8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<UInt8ArrayType>()(m_InDataPtr.lock()))
   {
     UInt8ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt8ArrayType>(m_InDataPtr.lock());
     uint8_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<uint8_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<uint8_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<uint8_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<Int16ArrayType>()(m_InDataPtr.lock()))
   {
     Int16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int16ArrayType>(m_InDataPtr.lock());
     int16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<int16_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<int16_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<int16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<UInt16ArrayType>()(m_InDataPtr.lock()))
   {
     UInt16ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt16ArrayType>(m_InDataPtr.lock());
     uint16_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<uint16_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<uint16_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<uint16_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<Int32ArrayType>()(m_InDataPtr.lock()))
   {
     Int32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int32ArrayType>(m_InDataPtr.lock());
     int32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<int32_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<int32_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<int32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<UInt32ArrayType>()(m_InDataPtr.lock()))
   {
     UInt32ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt32ArrayType>(m_InDataPtr.lock());
     uint32_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<uint32_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<uint32_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<uint32_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<Int64ArrayType>()(m_InDataPtr.lock()))
   {
     Int64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<Int64ArrayType>(m_InDataPtr.lock());
     int64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<int64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<int64_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<int64_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<int64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<UInt64ArrayType>()(m_InDataPtr.lock()))
   {
     UInt64ArrayType::Pointer cellArray = std::dynamic_pointer_cast<UInt64ArrayType>(m_InDataPtr.lock());
     uint64_t* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<uint64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<uint64_t> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<uint64_t>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<uint64_t>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<FloatArrayType>()(m_InDataPtr.lock()))
   {
     FloatArrayType::Pointer cellArray = std::dynamic_pointer_cast<FloatArrayType>(m_InDataPtr.lock());
     float* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<float>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<float> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<float>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<float>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else if(TemplateHelpers::CanDynamicCast<DoubleArrayType>()(m_InDataPtr.lock()))
   {
     DoubleArrayType::Pointer cellArray = std::dynamic_pointer_cast<DoubleArrayType>(m_InDataPtr.lock());
     double* cPtr = cellArray->getPointer(0);
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints), CalcRelativeMotion<double>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints),
-                      tbb::auto_partitioner());
-#else
-    CalcRelativeMotion<double> serial(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, numPatchPoints, numSearchPoints);
-    serial.convert(0, totalPoints);
-#endif
+    std::vector<float> patchNorms = CalcRelativeMotion<double>::PatchNorms(cPtr, dims, m_Plane, m_PSize1, m_PSize2);
+    dataAlg.execute(CalcRelativeMotion<double>(cPtr, m_MotionDirection, patchPoints, searchPoints, validPoints, patchNorms.data(), numPatchPoints, numSearchPoints));
   }
   else
   {
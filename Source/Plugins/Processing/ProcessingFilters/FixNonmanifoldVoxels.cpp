@@ -4,6 +4,11 @@
 
 #include "FixNonmanifoldVoxels.h"
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -11,10 +16,125 @@
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
 
+namespace
+{
+/**
+ * @brief buildNonmanifoldTable Flags the occupancy codes of a 2x2x2 block that are not manifold. Bit dx + 2 * dy + 4 * dz
+ * stands for the voxel at that corner. A code is not manifold if a face of the block holds only one diagonal pair, so
+ * two voxels share just an edge, or if only two opposite corners differ from the rest, so they share just a vertex.
+ */
+std::array<bool, 256> buildNonmanifoldTable()
+{
+  static const int32_t k_Faces[6][4] = {{0, 1, 3, 2}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 2, 6, 4}, {1, 3, 7, 5}};
+
+  std::array<bool, 256> table = {};
+  for(int32_t code = 0; code < 256; code++)
+  {
+    for(const auto& face : k_Faces)
+    {
+      bool a = ((code >> face[0]) & 1) != 0;
+      bool b = ((code >> face[1]) & 1) != 0;
+      bool c = ((code >> face[2]) & 1) != 0;
+      bool d = ((code >> face[3]) & 1) != 0;
+      if(a == c && b == d && a != b)
+      {
+        table[code] = true;
+      }
+    }
+    for(int32_t corner = 0; corner < 4; corner++)
+    {
+      int32_t pair = (1 << corner) | (1 << (7 - corner));
+      if(code == pair || code == (~pair & 0xFF))
+      {
+        table[code] = true;
+      }
+    }
+  }
+  return table;
+}
+} // namespace
+
+/**
+ * @brief The FixNonmanifoldVoxelsFindImpl class counts the non-manifold vertices of a range of vertex planes
+ */
+class FixNonmanifoldVoxelsFindImpl
+{
+public:
+  FixNonmanifoldVoxelsFindImpl(FixNonmanifoldVoxels* filter, const int32_t* featureIds, const int64_t dims[3], std::vector<size_t>& nonmanifoldCounts)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_NonmanifoldCounts(nonmanifoldCounts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    static const std::array<bool, 256> k_NonmanifoldTable = buildNonmanifoldTable();
+
+    const int64_t row = m_Dims[0];
+    const int64_t plane = m_Dims[0] * m_Dims[1];
+    const int64_t offsets[8] = {0, 1, row, row + 1, plane, plane + 1, plane + row, plane + row + 1};
+
+    for(int64_t z = static_cast<int64_t>(range.min()); z < static_cast<int64_t>(range.max()); z++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
+      size_t count = 0;
+      for(int64_t y = 1; y < m_Dims[1]; y++)
+      {
+        for(int64_t x = 1; x < m_Dims[0]; x++)
+        {
+          const int64_t base = (z - 1) * plane + (y - 1) * row + (x - 1);
+          int32_t ids[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+          for(int32_t corner = 0; corner < 8; corner++)
+          {
+            ids[corner] = m_FeatureIds[base + offsets[corner]];
+          }
+
+          uint32_t visited = 0;
+          for(int32_t corner = 0; corner < 8; corner++)
+          {
+            if(((visited >> corner) & 1) != 0)
+            {
+              continue;
+            }
+            uint32_t code = 0;
+            for(int32_t other = corner; other < 8; other++)
+            {
+              if(ids[other] == ids[corner])
+              {
+                code |= (1 << other);
+              }
+            }
+            visited |= code;
+            if(k_NonmanifoldTable[code])
+            {
+              count++;
+              break;
+            }
+          }
+        }
+      }
+      m_NonmanifoldCounts[z - 1] = count;
+    }
+  }
+
+private:
+  FixNonmanifoldVoxels* m_Filter = nullptr;
+  const int32_t* m_FeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  std::vector<size_t>& m_NonmanifoldCounts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -36,6 +156,7 @@ void FixNonmanifoldVoxels::initialize()
   clearErrorCode();
   clearWarningCode();
   setCancel(false);
+  m_NonmanifoldVertexCount = 0;
 }
 
 // -----------------------------------------------------------------------------
@@ -82,7 +203,7 @@ void FixNonmanifoldVoxels::execute()
 {
   initialize();
   dataCheck();
-  if(getErrorCondition() < 0)
+  if(getErrorCode() < 0)
   {
     return;
   }
@@ -98,91 +219,22 @@ void FixNonmanifoldVoxels::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int64_t maxId = dims[0] * dims[1] * dims[2];
-  int64_t plane = (dims[0] * dims[1]);
-  int64_t row = (dims[0]);
-
-  int64_t neighpointsIndices[20] = {
-      // Top Plane of indices
-      -plane - row - 1,
-      -plane - row,
-      -plane - row + 1,
-      -plane - 1,
-      -plane + 1,
-      -plane + row - 1,
-      -plane + row,
-      -plane + row + 1,
-      // Middle plane of indices
-      -row - 1,
-      -row + 1,
-
-      row - 1,
-      row + 1,
-      // Bottom Plane of indices
-      +plane - row - 1,
-      +plane - row,
-      +plane - row + 1,
-      +plane - 1,
-      +plane + 1,
-      +plane + row - 1,
-      +plane + row,
-      +plane + row + 1,
-  };
-  std::cout << "Dims: " << dims[0] << ", " << dims[1] << ", " << dims[2] << std::endl;
-  std::cout << "-----------------------------------------------" << std::endl;
-  std::cout << neighpointsIndices[0] << " " << neighpointsIndices[1] << " " << neighpointsIndices[2] << std::endl;
-  std::cout << neighpointsIndices[3] << " "
-            << " XX " << neighpointsIndices[4] << std::endl;
-  std::cout << neighpointsIndices[5] << " " << neighpointsIndices[6] << " " << neighpointsIndices[7] << std::endl;
-  std::cout << "-----------------------------------------------" << std::endl;
-  std::cout << neighpointsIndices[8] << " "
-            << " XX "
-            << " " << neighpointsIndices[9] << std::endl;
-  std::cout << " XX "
-            << " "
-            << " XX "
-            << " "
-            << " XX " << std::endl;
-  std::cout << neighpointsIndices[10] << " "
-            << " XX "
-            << " " << neighpointsIndices[11] << std::endl;
-  std::cout << "-----------------------------------------------" << std::endl;
-  std::cout << neighpointsIndices[12] << " " << neighpointsIndices[13] << " " << neighpointsIndices[14] << std::endl;
-  std::cout << neighpointsIndices[15] << " "
-            << " XX "
-            << " " << neighpointsIndices[16] << std::endl;
-  std::cout << neighpointsIndices[17] << " " << neighpointsIndices[18] << " " << neighpointsIndices[19] << std::endl;
-
-  for(int64_t z = 0; z < dims[2]; z++)
+  // Every interior vertex of the grid is shared by a 2x2x2 block of voxels. Each Feature in the block is packed into
+  // an 8 bit occupancy code that is looked up in the table of non-manifold configurations, one vertex plane per task.
+  std::vector<size_t> nonmanifoldCounts(static_cast<size_t>(std::max<int64_t>(dims[2] - 1, 0)), 0);
+  if(dims[0] > 1 && dims[1] > 1 && dims[2] > 1)
   {
-
-    for(int64_t y = 0; y < dims[1]; y++)
-    {
-      if(getCancel())
-      {
-        break;
-      }
-      for(int64_t x = 0; x < dims[0]; x++)
-      {
-        int64_t curIdx = (z * plane) + (y * row) + x;
-        int32_t featureId = m_FeatureIds[static_cast<size_t>(curIdx)];
-
-        for(size_t i = 0; i < 20; i++)
-        {
-          int64_t neighIdx = curIdx + neighpointsIndices[i];
-          // Validate we are within the array bounds
-          if(neighIdx >= 0 && neighIdx < maxId)
-          {
-            int32_t neighFeatId = m_FeatureIds[static_cast<size_t>(neighIdx)];
-            if(neighFeatId == featureId)
-            {
-              // std::cout << "Nonmanifold Voxel at " << x << ", " << y << ", " << z << " Feature Id: " << featureId << std::endl;
-            }
-          }
-        }
-      }
-    }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(1, static_cast<size_t>(dims[2]));
+    dataAlg.execute(FixNonmanifoldVoxelsFindImpl(this, m_FeatureIds, dims, nonmanifoldCounts));
   }
+  if(getCancel())
+  {
+    return;
+  }
+
+  m_NonmanifoldVertexCount = std::accumulate(nonmanifoldCounts.begin(), nonmanifoldCounts.end(), size_t(0));
+  notifyStatusMessage(QObject::tr("Found %1 non-manifold vertices").arg(m_NonmanifoldVertexCount));
 }
 
 // -----------------------------------------------------------------------------
@@ -297,3 +349,9 @@ DataArrayPath FixNonmanifoldVoxels::getFeatureIdsArrayPath() const
 {
   return m_FeatureIdsArrayPath;
 }
+
+// -----------------------------------------------------------------------------
+size_t FixNonmanifoldVoxels::getNonmanifoldVertexCount() const
+{
+  return m_NonmanifoldVertexCount;
+}
@@ -60,6 +60,12 @@ public:
   DataArrayPath getFeatureIdsArrayPath() const;
   Q_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
 
+  /**
+   * @brief Getter for the number of non-manifold vertices found by the last execution
+   * @return Number of non-manifold vertices
+   */
+  size_t getNonmanifoldVertexCount() const;
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -133,6 +139,7 @@ private:
   int32_t* m_FeatureIds = nullptr;
 
   DataArrayPath m_FeatureIdsArrayPath = {"", "", ""};
+  size_t m_NonmanifoldVertexCount = 0;
 
   /* Rule of 5: All special member functions should be defined if any are defined.
    * CppCoreGuidelines #c21 if you define or delete any default operation define or delete them all
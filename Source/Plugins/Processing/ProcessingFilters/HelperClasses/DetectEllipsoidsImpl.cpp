@@ -35,18 +35,104 @@
 
 #include "DetectEllipsoidsImpl.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "ProcessingFilters/HelperClasses/ComputeGradient.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 
+namespace
+{
+/**
+ * @brief nextPowerOfTwo Returns the smallest power of two that is not smaller than value
+ */
+size_t nextPowerOfTwo(size_t value)
+{
+  size_t power = 1;
+  while(power < value)
+  {
+    power <<= 1;
+  }
+  return power;
+}
+
+/**
+ * @brief fft In place iterative radix-2 transform of a power of two length sequence. The inverse is not scaled.
+ */
+void fft(DE_ComplexDoubleVector& data, bool inverse)
+{
+  size_t n = data.size();
+  for(size_t i = 1, j = 0; i < n; i++)
+  {
+    size_t bit = n >> 1;
+    for(; (j & bit) != 0; bit >>= 1)
+    {
+      j ^= bit;
+    }
+    j ^= bit;
+    if(i < j)
+    {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  for(size_t length = 2; length <= n; length <<= 1)
+  {
+    double angle = 2.0 * SIMPLib::Constants::k_PiD / static_cast<double>(length) * (inverse ? 1.0 : -1.0);
+    std::complex<double> step(std::cos(angle), std::sin(angle));
+    for(size_t i = 0; i < n; i += length)
+    {
+      std::complex<double> w(1.0, 0.0);
+      for(size_t j = 0; j < length / 2; j++)
+      {
+        std::complex<double> u = data[i + j];
+        std::complex<double> v = data[i + j + length / 2] * w;
+        data[i + j] = u + v;
+        data[i + j + length / 2] = u - v;
+        w *= step;
+      }
+    }
+  }
+}
+
+/**
+ * @brief fft2D Transforms the rows and then the columns of a row major xDim by yDim array
+ */
+void fft2D(DE_ComplexDoubleVector& data, size_t xDim, size_t yDim, bool inverse)
+{
+  DE_ComplexDoubleVector line(xDim);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    std::copy_n(data.begin() + y * xDim, xDim, line.begin());
+    fft(line, inverse);
+    std::copy_n(line.begin(), xDim, data.begin() + y * xDim);
+  }
+
+  line.resize(yDim);
+  for(size_t x = 0; x < xDim; x++)
+  {
+    for(size_t y = 0; y < yDim; y++)
+    {
+      line[y] = data[y * xDim + x];
+    }
+    fft(line, inverse);
+    for(size_t y = 0; y < yDim; y++)
+    {
+      data[y * xDim + x] = line[y];
+    }
+  }
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners,
-                                           DE_ComplexDoubleVector convCoords_X, DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, std::vector<size_t> kernel_tDims,
+DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, DE_EllipseBuffer& ellipses, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims,
+                                           UInt32ArrayType::Pointer corners, DE_ComplexDoubleVector convCoords_X, DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, std::vector<size_t> kernel_tDims,
                                            Int32ArrayType::Pointer convOffsetArray, std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max,
-                                           float tol_ellipse, float ba_min, DoubleArrayType::Pointer center, DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis,
-                                           DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM)
+                                           float tol_ellipse, float ba_min)
 : m_Filter(filter)
+, m_Ellipses(ellipses)
 , m_CellFeatureIdsPtr(cellFeatureIdsPtr)
 , m_CellFeatureIdsDims(cellFeatureIdsDims)
 , m_Corners(corners)
@@ -61,11 +147,6 @@ DetectEllipsoidsImpl::DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* fi
 , m_Axis_Max(axis_max)
 , m_TolEllipse(tol_ellipse)
 , m_Ba_Min(ba_min)
-, m_Center(center)
-, m_Majaxis(majaxis)
-, m_Minaxis(minaxis)
-, m_Rotangle(rotangle)
-, m_EllipseFeatureAM(ellipseFeatureAM)
 , m_ThreadIndex(threadIndex)
 {
 }
@@ -117,6 +198,12 @@ void DetectEllipsoidsImpl::operator()() const
     accum_can->setComponent(i, 0, std::numeric_limits<double>::quiet_NaN());
   }
 
+  // Kernel spectra are kept for every padded size this thread has seen, so features of similar size share them
+  DE_SpectrumCache convSpectra_X;
+  DE_SpectrumCache convSpectra_Y;
+  DE_SpectrumCache smoothSpectra;
+  DE_ComplexDoubleVector smoothKernel(m_SmoothKernel.begin(), m_SmoothKernel.end());
+
   // Run the ellipse detection algorithm on each object
   int32_t featureId = m_Filter->getNextFeatureId();
   while(featureId > 0)
@@ -191,21 +278,62 @@ void DetectEllipsoidsImpl::operator()() const
       DoubleArrayType::Pointer gradX = grad.getGradX();
       DoubleArrayType::Pointer gradY = grad.getGradY();
 
-      // Convolute Gradient of object with convolution kernel
-      DE_ComplexDoubleVector gradX_conv = convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims);
-      DE_ComplexDoubleVector gradY_conv = convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims);
-
-      // Calculate the magnitude matrix of the convolution.
-      DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(gradX_conv.size(), std::vector<size_t>(1, 1), "obj_conv_mag", true);
-      for(int i = 0; i < gradX_conv.size(); i++)
+      // Convolute Gradient of object with convolution kernel. Both gradients are transformed and their products with the
+      // kernel spectra summed, so the FFT path needs a single inverse transform for the pair.
+      DoubleArrayType::Pointer obj_conv_mag = DoubleArrayType::CreateArray(gradX->getNumberOfTuples(), std::vector<size_t>(1, 1), "obj_conv_mag", true);
+      std::pair<size_t, size_t> convFFTDims = getPaddedFFTDims(m_ConvOffsetArray, paddedObj_tDims);
+      if(useFFTConvolution(m_ConvCoords_X.size(), paddedObj_tDims, convFFTDims, 1.5))
       {
-        std::complex<double> complexValue = gradX_conv[i] + gradY_conv[i];
-        double value = std::abs(complexValue);
-        obj_conv_mag->setValue(i, value);
+        const DE_ComplexDoubleVector& spectrumX = getKernelSpectrum(m_ConvCoords_X, m_ConvOffsetArray, convFFTDims, convSpectra_X);
+        const DE_ComplexDoubleVector& spectrumY = getKernelSpectrum(m_ConvCoords_Y, m_ConvOffsetArray, convFFTDims, convSpectra_Y);
+        DE_ComplexDoubleVector gradSpectrum = imageSpectrum(gradX, paddedObj_tDims, convFFTDims);
+        DE_ComplexDoubleVector gradY_spectrum = imageSpectrum(gradY, paddedObj_tDims, convFFTDims);
+        for(size_t i = 0; i < gradSpectrum.size(); i++)
+        {
+          gradSpectrum[i] = gradSpectrum[i] * spectrumX[i] + gradY_spectrum[i] * spectrumY[i];
+        }
+        DE_ComplexDoubleVector grad_conv = inverseSpectrum(gradSpectrum, paddedObj_tDims, convFFTDims);
+        for(size_t i = 0; i < grad_conv.size(); i++)
+        {
+          obj_conv_mag->setValue(i, std::abs(grad_conv[i]));
+        }
+      }
+      else
+      {
+        DE_ComplexDoubleVector gradX_conv = convoluteImage(gradX, m_ConvCoords_X, m_ConvOffsetArray, paddedObj_tDims);
+        DE_ComplexDoubleVector gradY_conv = convoluteImage(gradY, m_ConvCoords_Y, m_ConvOffsetArray, paddedObj_tDims);
+
+        // Calculate the magnitude matrix of the convolution.
+        for(int i = 0; i < gradX_conv.size(); i++)
+        {
+          std::complex<double> complexValue = gradX_conv[i] + gradY_conv[i];
+          double value = std::abs(complexValue);
+          obj_conv_mag->setValue(i, value);
+        }
       }
 
       // Smooth the magnitude matrix using a smoothing kernel.
-      std::vector<double> obj_conv_mag_smooth = convoluteImage(obj_conv_mag, m_SmoothKernel, m_SmoothOffsetArray, paddedObj_tDims);
+      std::vector<double> obj_conv_mag_smooth;
+      std::pair<size_t, size_t> smoothFFTDims = getPaddedFFTDims(m_SmoothOffsetArray, paddedObj_tDims);
+      if(useFFTConvolution(m_SmoothKernel.size(), paddedObj_tDims, smoothFFTDims, 2.0))
+      {
+        const DE_ComplexDoubleVector& spectrum = getKernelSpectrum(smoothKernel, m_SmoothOffsetArray, smoothFFTDims, smoothSpectra);
+        DE_ComplexDoubleVector magSpectrum = imageSpectrum(obj_conv_mag, paddedObj_tDims, smoothFFTDims);
+        for(size_t i = 0; i < magSpectrum.size(); i++)
+        {
+          magSpectrum[i] *= spectrum[i];
+        }
+        DE_ComplexDoubleVector smoothed = inverseSpectrum(magSpectrum, paddedObj_tDims, smoothFFTDims);
+        obj_conv_mag_smooth.resize(smoothed.size());
+        for(size_t i = 0; i < smoothed.size(); i++)
+        {
+          obj_conv_mag_smooth[i] = smoothed[i].real();
+        }
+      }
+      else
+      {
+        obj_conv_mag_smooth = convoluteImage(obj_conv_mag, m_SmoothKernel, m_SmoothOffsetArray, paddedObj_tDims);
+      }
       double obj_conv_max = 0;
       for(int i = 0; i < obj_conv_mag_smooth.size(); i++)
       {
@@ -339,20 +467,9 @@ void DetectEllipsoidsImpl::operator()() const
         // If the sub-object has enough votes, it is found to be an ellipse
         if(can_num > 0) // Assume best match is the ellipse
         {
-          // Increment the ellipse counter
-          m_Filter->incrementEllipseCount();
           // Get the index into the ellipse value arrays that has the most votes
           int accum_idx = getIdOfMax<double>(accum_can);
 
-          /* If this is another ellipse in the same overall object,
-           * create a new feature id and resize our output arrays */
-          size_t objId = featureId;
-          if(numberOfDetectedEllipses > 0)
-          {
-            objId = m_Filter->getUniqueFeatureId();
-            m_EllipseFeatureAM->resizeAttributeArrays(std::vector<size_t>(1, objId + 1));
-          }
-
           double cenx_val = cenx_can->getValue(accum_idx);
           double ceny_val = ceny_can->getValue(accum_idx);
           double majaxis_val = maj_can->getValue(accum_idx);
@@ -373,13 +490,6 @@ void DetectEllipsoidsImpl::operator()() const
             }
           }
 
-          // Store ellipse parameters
-          m_Center->setComponent(objId, 0, cenx_val);
-          m_Center->setComponent(objId, 1, ceny_val);
-          m_Majaxis->setValue(objId, majaxis_val);
-          m_Minaxis->setValue(objId, minaxis_val);
-          m_Rotangle->setValue(objId, rotangle_val);
-
           // Remove the sub-object from the feature id object's 2D array
           Int32ArrayType::Pointer featureObjOnesArray = Int32ArrayType::CreateArray(paddedObj_tDims, std::vector<size_t>(1, 1), "featureObjOnesArray", true);
           featureObjOnesArray->initializeWithValue(1);
@@ -396,8 +506,17 @@ void DetectEllipsoidsImpl::operator()() const
           size_t obj_x_min = topL_Y;
           size_t obj_y_min = topL_X;
 
-          m_Center->setComponent(objId, 0, m_Center->getComponent(objId, 0) + obj_x_min);
-          m_Center->setComponent(objId, 1, m_Center->getComponent(objId, 1) + obj_y_min);
+          // Store ellipse parameters. If this is another ellipse in the same overall object, the filter gives it a new
+          // feature id when the buffers of all threads are merged
+          DE_DetectedEllipse ellipse;
+          ellipse.featureId = featureId;
+          ellipse.ellipseIndex = numberOfDetectedEllipses;
+          ellipse.cenx = cenx_val + obj_x_min;
+          ellipse.ceny = ceny_val + obj_y_min;
+          ellipse.majaxis = majaxis_val;
+          ellipse.minaxis = minaxis_val;
+          ellipse.rotangle = rotangle_val;
+          m_Ellipses.push_back(ellipse);
 
           // Clear Accumulator
           accum_can->initializeWithZeros();
@@ -429,6 +548,119 @@ void DetectEllipsoidsImpl::operator()() const
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::pair<size_t, size_t> DetectEllipsoidsImpl::getPaddedFFTDims(Int32ArrayType::Pointer offsetArray, const std::vector<size_t>& image_tDims) const
+{
+  int* offsetArrayPtr = offsetArray->getPointer(0);
+  int offsetArrayNumOfComps = offsetArray->getNumberOfComponents();
+  size_t numOffsets = offsetArray->getNumberOfTuples();
+
+  size_t halo_X = 0;
+  size_t halo_Y = 0;
+  for(size_t j = 0; j < numOffsets; j++)
+  {
+    halo_X = std::max(halo_X, static_cast<size_t>(std::abs(offsetArrayPtr[j * offsetArrayNumOfComps])));
+    halo_Y = std::max(halo_Y, static_cast<size_t>(std::abs(offsetArrayPtr[(j * offsetArrayNumOfComps) + 1])));
+  }
+
+  return std::make_pair(nextPowerOfTwo(image_tDims[0] + halo_X), nextPowerOfTwo(image_tDims[1] + halo_Y));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DetectEllipsoidsImpl::useFFTConvolution(size_t kernelSize, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims, double numTransforms) const
+{
+  double directCost = static_cast<double>(image_tDims[0] * image_tDims[1]) * static_cast<double>(kernelSize);
+  double fftSize = static_cast<double>(fftDims.first * fftDims.second);
+
+  // A radix-2 butterfly pass costs roughly five floating point operations per element
+  double fftCost = numTransforms * 5.0 * fftSize * std::log2(fftSize);
+  return fftCost < directCost;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const DE_ComplexDoubleVector& DetectEllipsoidsImpl::getKernelSpectrum(const DE_ComplexDoubleVector& kernel, Int32ArrayType::Pointer offsetArray, const std::pair<size_t, size_t>& fftDims,
+                                                                      DE_SpectrumCache& cache) const
+{
+  DE_SpectrumCache::iterator iter = cache.find(fftDims);
+  if(iter != cache.end())
+  {
+    return iter->second;
+  }
+
+  int* offsetArrayPtr = offsetArray->getPointer(0);
+  int offsetArrayNumOfComps = offsetArray->getNumberOfComponents();
+  int64_t fftX = static_cast<int64_t>(fftDims.first);
+  int64_t fftY = static_cast<int64_t>(fftDims.second);
+
+  // convoluteImage samples image[p + offset] with the kernel value, which is a convolution with the value placed at -offset
+  DE_ComplexDoubleVector spectrum(fftDims.first * fftDims.second, std::complex<double>(0.0, 0.0));
+  for(size_t j = 0; j < kernel.size(); j++)
+  {
+    // 3DIM: Only the kernel plane at z offset 0 touches a 2D image
+    if(offsetArrayPtr[(j * offsetArrayNumOfComps) + 2] != 0)
+    {
+      continue;
+    }
+    int64_t x = (fftX - offsetArrayPtr[j * offsetArrayNumOfComps]) % fftX;
+    int64_t y = (fftY - offsetArrayPtr[(j * offsetArrayNumOfComps) + 1]) % fftY;
+    spectrum[y * fftX + x] += kernel[j];
+  }
+  fft2D(spectrum, fftDims.first, fftDims.second, false);
+
+  return cache.emplace(fftDims, std::move(spectrum)).first->second;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DE_ComplexDoubleVector DetectEllipsoidsImpl::imageSpectrum(DoubleArrayType::Pointer image, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims) const
+{
+  double* imageArray = image->getPointer(0);
+  size_t xDim = image_tDims[0];
+  size_t yDim = image_tDims[1];
+
+  DE_ComplexDoubleVector spectrum(fftDims.first * fftDims.second, std::complex<double>(0.0, 0.0));
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      spectrum[y * fftDims.first + x] = imageArray[y * xDim + x];
+    }
+  }
+  fft2D(spectrum, fftDims.first, fftDims.second, false);
+
+  return spectrum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DE_ComplexDoubleVector DetectEllipsoidsImpl::inverseSpectrum(DE_ComplexDoubleVector& spectrum, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims) const
+{
+  fft2D(spectrum, fftDims.first, fftDims.second, true);
+
+  size_t xDim = image_tDims[0];
+  size_t yDim = image_tDims[1];
+  double scale = 1.0 / static_cast<double>(fftDims.first * fftDims.second);
+
+  DE_ComplexDoubleVector image(xDim * yDim);
+  for(size_t y = 0; y < yDim; y++)
+  {
+    for(size_t x = 0; x < xDim; x++)
+    {
+      image[y * xDim + x] = spectrum[y * fftDims.first + x] * scale;
+    }
+  }
+
+  return image;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -35,6 +35,8 @@
 #pragma once
 
 #include <complex>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -42,20 +44,27 @@
 
 #include "Processing/ProcessingFilters/DetectEllipsoids.h"
 
+#include "Processing/ProcessingDLLExport.h"
+
 class DetectEllipsoids;
 
 using DE_ComplexDoubleVector = std::vector<std::complex<double>>;
 
 /**
- * @brief The DetectEllipsoidsImpl class implements a threaded algorithm that detects ellipsoids in a FeatureIds array
+ * @brief DE_SpectrumCache maps padded FFT dimensions to the spectrum of one convolution kernel at those dimensions
+ */
+using DE_SpectrumCache = std::map<std::pair<size_t, size_t>, DE_ComplexDoubleVector>;
+
+/**
+ * @brief The DetectEllipsoidsImpl class implements a threaded algorithm that detects ellipsoids in a FeatureIds array.
+ * Each instance pulls features from the filter until none are left and collects its ellipses in its own buffer.
  */
-class DetectEllipsoidsImpl
+class Processing_EXPORT DetectEllipsoidsImpl
 {
 public:
-  DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners, DE_ComplexDoubleVector convCoords_X,
+  DetectEllipsoidsImpl(int threadIndex, DetectEllipsoids* filter, DE_EllipseBuffer& ellipses, int* cellFeatureIdsPtr, std::vector<size_t> cellFeatureIdsDims, UInt32ArrayType::Pointer corners, DE_ComplexDoubleVector convCoords_X,
                        DE_ComplexDoubleVector convCoords_Y, DE_ComplexDoubleVector convCoords_Z, std::vector<size_t> kernel_tDims, Int32ArrayType::Pointer convOffsetArray,
-                       std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max, float tol_ellipse, float ba_min, DoubleArrayType::Pointer center,
-                       DoubleArrayType::Pointer majaxis, DoubleArrayType::Pointer minaxis, DoubleArrayType::Pointer rotangle, AttributeMatrix::Pointer ellipseFeatureAM);
+                       std::vector<double> smoothFil, Int32ArrayType::Pointer smoothOffsetArray, double axis_min, double axis_max, float tol_ellipse, float ba_min);
 
   virtual ~DetectEllipsoidsImpl();
 
@@ -197,6 +206,55 @@ public:
     return convArray;
   }
 
+  /**
+   * @brief getPaddedFFTDims Returns the power of two dimensions that hold the image plus the halo of the kernel
+   * described by offsetArray, so that the circular convolution computed through the FFT never wraps around
+   * @param offsetArray Kernel offset array
+   * @param image_tDims Image dimensions
+   * @return Padded x and y dimensions
+   */
+  std::pair<size_t, size_t> getPaddedFFTDims(Int32ArrayType::Pointer offsetArray, const std::vector<size_t>& image_tDims) const;
+
+  /**
+   * @brief useFFTConvolution Compares the cost of convolving the image directly with a kernel against the cost of the
+   * FFT transforms at the padded dimensions. Small objects stay on the direct path.
+   * @param kernelSize Number of kernel elements
+   * @param image_tDims Image dimensions
+   * @param fftDims Padded FFT dimensions
+   * @param numTransforms Number of transforms the FFT path needs per kernel
+   * @return
+   */
+  bool useFFTConvolution(size_t kernelSize, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims, double numTransforms) const;
+
+  /**
+   * @brief getKernelSpectrum Returns the spectrum of a kernel at the padded dimensions, computing it on the first request.
+   * The spectrum reproduces convoluteImage exactly: each kernel value is placed at the negated offset it samples.
+   * @param kernel Kernel values, already reversed as for convoluteImage
+   * @param offsetArray Kernel offset array
+   * @param fftDims Padded FFT dimensions
+   * @param cache Spectra already computed for this kernel
+   * @return
+   */
+  const DE_ComplexDoubleVector& getKernelSpectrum(const DE_ComplexDoubleVector& kernel, Int32ArrayType::Pointer offsetArray, const std::pair<size_t, size_t>& fftDims, DE_SpectrumCache& cache) const;
+
+  /**
+   * @brief imageSpectrum Zero pads the image to the padded dimensions and returns its spectrum
+   * @param image
+   * @param image_tDims
+   * @param fftDims
+   * @return
+   */
+  DE_ComplexDoubleVector imageSpectrum(DoubleArrayType::Pointer image, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims) const;
+
+  /**
+   * @brief inverseSpectrum Transforms a product spectrum back and crops it to the image dimensions
+   * @param spectrum Product spectrum, overwritten by the transform
+   * @param image_tDims
+   * @param fftDims
+   * @return
+   */
+  DE_ComplexDoubleVector inverseSpectrum(DE_ComplexDoubleVector& spectrum, const std::vector<size_t>& image_tDims, const std::pair<size_t, size_t>& fftDims) const;
+
   /**
    * @brief findExtrema
    * @param thresholdArray
@@ -325,6 +383,7 @@ public:
 
 private:
   DetectEllipsoids* m_Filter;
+  DE_EllipseBuffer& m_Ellipses;
   int* m_CellFeatureIdsPtr;
   std::vector<size_t> m_CellFeatureIdsDims;
   UInt32ArrayType::Pointer m_Corners;
@@ -339,10 +398,5 @@ private:
   double m_Axis_Max;
   float m_TolEllipse;
   float m_Ba_Min;
-  DoubleArrayType::Pointer m_Center;
-  DoubleArrayType::Pointer m_Majaxis;
-  DoubleArrayType::Pointer m_Minaxis;
-  DoubleArrayType::Pointer m_Rotangle;
-  AttributeMatrix::Pointer m_EllipseFeatureAM;
   int m_ThreadIndex = 0;
 };
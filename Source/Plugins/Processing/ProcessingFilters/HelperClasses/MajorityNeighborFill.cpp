@@ -0,0 +1,209 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "MajorityNeighborFill.h"
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Processing/ProcessingFilters/HelperClasses/NeighborMapTransfer.h"
+
+/**
+ * @brief The MajorityNeighborFillFindImpl class picks the source neighbor of every cell in the worklist. A neighbor
+ * is chosen when its Feature becomes the most common one seen so far while walking the six face neighbors in order,
+ * so ties go to the Feature that reaches the count first.
+ */
+class MajorityNeighborFillFindImpl
+{
+public:
+  MajorityNeighborFillFindImpl(const int64_t* dims, const int32_t* featureIds, int32_t minSourceFeatureId, const std::vector<int64_t>& worklist, std::vector<int64_t>& sources)
+  : m_Dims(dims)
+  , m_FeatureIds(featureIds)
+  , m_MinSourceFeatureId(minSourceFeatureId)
+  , m_Worklist(worklist)
+  , m_Sources(sources)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    int32_t features[6] = {0, 0, 0, 0, 0, 0};
+    int32_t counts[6] = {0, 0, 0, 0, 0, 0};
+
+    for(size_t index = range.min(); index < range.max(); index++)
+    {
+      int64_t cell = m_Worklist[index];
+      int64_t i = cell % m_Dims[0];
+      int64_t j = (cell / m_Dims[0]) % m_Dims[1];
+      int64_t k = cell / (m_Dims[0] * m_Dims[1]);
+      bool good[6] = {k > 0, j > 0, i > 0, i < m_Dims[0] - 1, j < m_Dims[1] - 1, k < m_Dims[2] - 1};
+
+      int64_t source = -1;
+      int32_t most = 0;
+      int32_t numFeatures = 0;
+      for(int32_t l = 0; l < 6; l++)
+      {
+        if(!good[l])
+        {
+          continue;
+        }
+        int64_t neighpoint = cell + neighpoints[l];
+        int32_t feature = m_FeatureIds[neighpoint];
+        if(feature < m_MinSourceFeatureId)
+        {
+          continue;
+        }
+        int32_t slot = 0;
+        while(slot < numFeatures && features[slot] != feature)
+        {
+          slot++;
+        }
+        if(slot == numFeatures)
+        {
+          features[slot] = feature;
+          counts[slot] = 0;
+          numFeatures++;
+        }
+        counts[slot]++;
+        if(counts[slot] > most)
+        {
+          most = counts[slot];
+          source = neighpoint;
+        }
+      }
+      m_Sources[index] = source;
+    }
+  }
+
+private:
+  const int64_t* m_Dims = nullptr;
+  const int32_t* m_FeatureIds = nullptr;
+  int32_t m_MinSourceFeatureId = 0;
+  const std::vector<int64_t>& m_Worklist;
+  std::vector<int64_t>& m_Sources;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MajorityNeighborFill::MajorityNeighborFill(AbstractFilter* filter, const int64_t* dims, int32_t* featureIds, int32_t minSourceFeatureId)
+: m_Filter(filter)
+, m_FeatureIds(featureIds)
+, m_MinSourceFeatureId(minSourceFeatureId)
+{
+  m_Dims[0] = dims[0];
+  m_Dims[1] = dims[1];
+  m_Dims[2] = dims[2];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+MajorityNeighborFill::~MajorityNeighborFill() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void MajorityNeighborFill::execute(const std::vector<IDataArray::Pointer>& cellArrays)
+{
+  int64_t totalPoints = m_Dims[0] * m_Dims[1] * m_Dims[2];
+
+  std::vector<int64_t> worklist;
+  for(int64_t cell = 0; cell < totalPoints; cell++)
+  {
+    if(m_FeatureIds[cell] < 0)
+    {
+      worklist.push_back(cell);
+    }
+  }
+
+  const int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+  std::vector<int64_t> sources;
+  std::vector<int64_t> nextWorklist;
+  std::vector<uint8_t> queued(static_cast<size_t>(totalPoints), 0);
+
+  while(!worklist.empty())
+  {
+    if(m_Filter->getCancel())
+    {
+      return;
+    }
+
+    sources.assign(worklist.size(), -1);
+    ParallelDataAlgorithm findAlg;
+    findAlg.setRange(0, worklist.size());
+    findAlg.execute(MajorityNeighborFillFindImpl(m_Dims, m_FeatureIds, m_MinSourceFeatureId, worklist, sources));
+
+    // Sources are always good cells, which are never written during a pass, so the arrays can be gathered directly
+    NeighborMapTransfer transfer(m_Filter, worklist, sources);
+    transfer.execute(cellArrays);
+    for(size_t index = 0; index < worklist.size(); index++)
+    {
+      if(sources[index] >= 0)
+      {
+        m_FeatureIds[worklist[index]] = m_FeatureIds[sources[index]];
+      }
+    }
+
+    // Only the bad cells touching a cell filled in this pass can have a different outcome in the next one
+    nextWorklist.clear();
+    for(size_t index = 0; index < worklist.size(); index++)
+    {
+      if(sources[index] < 0)
+      {
+        continue;
+      }
+      int64_t cell = worklist[index];
+      int64_t i = cell % m_Dims[0];
+      int64_t j = (cell / m_Dims[0]) % m_Dims[1];
+      int64_t k = cell / (m_Dims[0] * m_Dims[1]);
+      bool good[6] = {k > 0, j > 0, i > 0, i < m_Dims[0] - 1, j < m_Dims[1] - 1, k < m_Dims[2] - 1};
+      for(int32_t l = 0; l < 6; l++)
+      {
+        int64_t neighpoint = cell + neighpoints[l];
+        if(good[l] && m_FeatureIds[neighpoint] < 0 && queued[neighpoint] == 0)
+        {
+          queued[neighpoint] = 1;
+          nextWorklist.push_back(neighpoint);
+        }
+      }
+    }
+    for(const auto& cell : nextWorklist)
+    {
+      queued[cell] = 0;
+    }
+    worklist.swap(nextWorklist);
+  }
+}
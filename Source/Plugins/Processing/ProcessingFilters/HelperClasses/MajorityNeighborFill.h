@@ -0,0 +1,84 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+#include "Processing/ProcessingDLLExport.h"
+
+/**
+ * @brief The MajorityNeighborFill class assigns every bad cell of an image geometry the values of the face neighbor
+ * that belongs to the most common Feature among its six face neighbors, and repeats until no bad cell borders a
+ * good one. The first pass visits every bad cell; each later pass only revisits the bad cells next to the cells
+ * filled by the pass before it, so the total work follows the number of bad cells rather than the volume. The cells
+ * of a pass are evaluated in parallel against the Feature Ids left by the previous pass, and the chosen sources are
+ * then gathered into every cell array with a NeighborMapTransfer.
+ */
+class Processing_EXPORT MajorityNeighborFill
+{
+public:
+  /**
+   * @param filter Filter that is checked for cancellation
+   * @param dims Dimensions of the image geometry
+   * @param featureIds Feature Ids array. Cells with a negative Id are bad
+   * @param minSourceFeatureId Smallest Feature Id whose cells may be copied into a bad cell
+   */
+  MajorityNeighborFill(AbstractFilter* filter, const int64_t* dims, int32_t* featureIds, int32_t minSourceFeatureId);
+  virtual ~MajorityNeighborFill();
+
+  /**
+   * @brief execute Fills the bad cells, copying the chosen neighbor's tuple of every array in cellArrays into
+   * each filled cell. The Feature Id of a filled cell is always updated, even if the Feature Ids array is not listed.
+   * @param cellArrays Cell arrays whose values are transferred
+   */
+  void execute(const std::vector<IDataArray::Pointer>& cellArrays);
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  int64_t m_Dims[3] = {0, 0, 0};
+  int32_t* m_FeatureIds = nullptr;
+  int32_t m_MinSourceFeatureId = 0;
+
+public:
+  MajorityNeighborFill(const MajorityNeighborFill&) = delete;            // Copy Constructor Not Implemented
+  MajorityNeighborFill(MajorityNeighborFill&&) = delete;                 // Move Constructor Not Implemented
+  MajorityNeighborFill& operator=(const MajorityNeighborFill&) = delete; // Copy Assignment Not Implemented
+  MajorityNeighborFill& operator=(MajorityNeighborFill&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,119 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "NeighborMapTransfer.h"
+
+#include <algorithm>
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Processing/ProcessingFilters/HelperClasses/NeighborMapGather.hpp"
+
+/**
+ * @brief The NeighborMapTransferImpl class applies the neighbor map to a range of the cell arrays
+ */
+class NeighborMapTransferImpl
+{
+public:
+  NeighborMapTransferImpl(AbstractFilter* filter, const std::vector<IDataArray::Pointer>& cellArrays, const int64_t* cells, const int64_t* neighbors, size_t size)
+  : m_Filter(filter)
+  , m_CellArrays(cellArrays)
+  , m_Cells(cells)
+  , m_Neighbors(neighbors)
+  , m_Size(size)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t arrayIndex = range.min(); arrayIndex < range.max(); arrayIndex++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+
+      NeighborMapGather::Gather(m_CellArrays[arrayIndex].get(), m_Cells, m_Neighbors, m_Size);
+    }
+  }
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  const std::vector<IDataArray::Pointer>& m_CellArrays;
+  const int64_t* m_Cells = nullptr;
+  const int64_t* m_Neighbors = nullptr;
+  size_t m_Size = 0;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NeighborMapTransfer::NeighborMapTransfer(AbstractFilter* filter, const std::vector<int64_t>& neighbors)
+: m_Filter(filter)
+, m_Neighbors(neighbors.data())
+, m_Size(neighbors.size())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NeighborMapTransfer::NeighborMapTransfer(AbstractFilter* filter, const std::vector<int64_t>& cells, const std::vector<int64_t>& neighbors)
+: m_Filter(filter)
+, m_Cells(cells.data())
+, m_Neighbors(neighbors.data())
+, m_Size(std::min(cells.size(), neighbors.size()))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NeighborMapTransfer::~NeighborMapTransfer() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void NeighborMapTransfer::execute(const std::vector<IDataArray::Pointer>& cellArrays) const
+{
+  if(cellArrays.empty() || m_Size == 0)
+  {
+    return;
+  }
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, cellArrays.size());
+  dataAlg.execute(NeighborMapTransferImpl(m_Filter, cellArrays, m_Cells, m_Neighbors, m_Size));
+}
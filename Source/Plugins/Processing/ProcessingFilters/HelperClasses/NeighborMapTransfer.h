@@ -0,0 +1,85 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The NeighborMapTransfer class copies the tuple of a source cell into a destination cell for every entry of
+ * a neighbor map, across a whole list of cell arrays. Each array is resolved to its concrete type once and gathered
+ * in a single pass over its raw data, and the arrays are transferred in parallel. Within an array the entries are
+ * applied in order, so a map whose source was written by an earlier entry gives the same result as a serial copy.
+ */
+class NeighborMapTransfer
+{
+public:
+  /**
+   * @param filter Filter that is checked for cancellation
+   * @param neighbors Source cell for every cell of the arrays, or -1 to leave the cell untouched
+   */
+  NeighborMapTransfer(AbstractFilter* filter, const std::vector<int64_t>& neighbors);
+
+  /**
+   * @param filter Filter that is checked for cancellation
+   * @param cells Destination cells of the map
+   * @param neighbors Source cell for each entry of cells, or -1 to skip the entry
+   */
+  NeighborMapTransfer(AbstractFilter* filter, const std::vector<int64_t>& cells, const std::vector<int64_t>& neighbors);
+
+  virtual ~NeighborMapTransfer();
+
+  /**
+   * @brief execute Applies the neighbor map to every array in cellArrays. The map must stay alive until this returns.
+   * @param cellArrays Cell arrays whose values are transferred
+   */
+  void execute(const std::vector<IDataArray::Pointer>& cellArrays) const;
+
+private:
+  AbstractFilter* m_Filter = nullptr;
+  const int64_t* m_Cells = nullptr;
+  const int64_t* m_Neighbors = nullptr;
+  size_t m_Size = 0;
+
+public:
+  NeighborMapTransfer(const NeighborMapTransfer&) = delete;            // Copy Constructor Not Implemented
+  NeighborMapTransfer(NeighborMapTransfer&&) = delete;                 // Move Constructor Not Implemented
+  NeighborMapTransfer& operator=(const NeighborMapTransfer&) = delete; // Copy Assignment Not Implemented
+  NeighborMapTransfer& operator=(NeighborMapTransfer&&) = delete;      // Move Assignment Not Implemented
+};
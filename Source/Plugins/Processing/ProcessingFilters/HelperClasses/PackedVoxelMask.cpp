@@ -0,0 +1,256 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PackedVoxelMask.h"
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+/**
+ * @brief countTrailingZeros Returns the position of the lowest set bit of a non zero word
+ */
+int64_t countTrailingZeros(uint64_t word)
+{
+  static const int64_t k_DeBruijnPositions[64] = {0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,  62, 55, 59, 36, 53, 51,
+                                                  43, 22, 45, 39, 33, 30, 24, 18, 12, 5,  63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21,
+                                                  44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6};
+  const uint64_t lowest = word & (~word + 1);
+  return k_DeBruijnPositions[(lowest * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+} // namespace
+
+/**
+ * @brief The PackedVoxelMaskDilateImpl class dilates a range of planes of a packed mask
+ */
+class PackedVoxelMaskDilateImpl
+{
+public:
+  PackedVoxelMaskDilateImpl(const uint64_t* source, uint64_t* destination, const int64_t dims[3], int64_t wordsPerRow, uint64_t lastWordMask, bool xDirOn, bool yDirOn, bool zDirOn)
+  : m_Source(source)
+  , m_Destination(destination)
+  , m_Dims(dims)
+  , m_WordsPerRow(wordsPerRow)
+  , m_LastWordMask(lastWordMask)
+  , m_XDirOn(xDirOn)
+  , m_YDirOn(yDirOn)
+  , m_ZDirOn(zDirOn)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t planeWords = m_Dims[1] * m_WordsPerRow;
+    for(int64_t k = static_cast<int64_t>(range.min()); k < static_cast<int64_t>(range.max()); k++)
+    {
+      for(int64_t j = 0; j < m_Dims[1]; j++)
+      {
+        const int64_t rowStart = k * planeWords + j * m_WordsPerRow;
+        for(int64_t word = 0; word < m_WordsPerRow; word++)
+        {
+          const int64_t index = rowStart + word;
+          const uint64_t bits = m_Source[index];
+          uint64_t result = bits;
+          if(m_XDirOn)
+          {
+            const uint64_t lower = (word > 0) ? m_Source[index - 1] : 0;
+            const uint64_t upper = (word < m_WordsPerRow - 1) ? m_Source[index + 1] : 0;
+            result |= (bits << 1) | (lower >> 63) | (bits >> 1) | (upper << 63);
+          }
+          if(m_YDirOn)
+          {
+            if(j > 0)
+            {
+              result |= m_Source[index - m_WordsPerRow];
+            }
+            if(j < m_Dims[1] - 1)
+            {
+              result |= m_Source[index + m_WordsPerRow];
+            }
+          }
+          if(m_ZDirOn)
+          {
+            if(k > 0)
+            {
+              result |= m_Source[index - planeWords];
+            }
+            if(k < m_Dims[2] - 1)
+            {
+              result |= m_Source[index + planeWords];
+            }
+          }
+          if(word == m_WordsPerRow - 1)
+          {
+            result &= m_LastWordMask;
+          }
+          m_Destination[index] = result;
+        }
+      }
+    }
+  }
+
+private:
+  const uint64_t* m_Source = nullptr;
+  uint64_t* m_Destination = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int64_t m_WordsPerRow = 0;
+  uint64_t m_LastWordMask = 0;
+  bool m_XDirOn = true;
+  bool m_YDirOn = true;
+  bool m_ZDirOn = true;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PackedVoxelMask::PackedVoxelMask(const int64_t dims[3])
+{
+  m_Dims[0] = dims[0];
+  m_Dims[1] = dims[1];
+  m_Dims[2] = dims[2];
+  m_WordsPerRow = (m_Dims[0] + 63) / 64;
+  const int64_t remainder = m_Dims[0] % 64;
+  m_LastWordMask = (remainder == 0) ? ~uint64_t(0) : ((uint64_t(1) << remainder) - 1);
+  m_Words.assign(static_cast<size_t>(m_WordsPerRow * m_Dims[1] * m_Dims[2]), 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PackedVoxelMask::~PackedVoxelMask() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::copyTo(bool* mask) const
+{
+  for(int64_t row = 0; row < m_Dims[1] * m_Dims[2]; row++)
+  {
+    bool* rowData = mask + row * m_Dims[0];
+    const uint64_t* rowWords = m_Words.data() + row * m_WordsPerRow;
+    for(int64_t i = 0; i < m_Dims[0]; i++)
+    {
+      rowData[i] = ((rowWords[i / 64] >> (i % 64)) & 1) != 0;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackedVoxelMask::test(int64_t index) const
+{
+  const int64_t row = index / m_Dims[0];
+  const int64_t i = index - row * m_Dims[0];
+  return ((m_Words[row * m_WordsPerRow + i / 64] >> (i % 64)) & 1) != 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::set(int64_t index, bool value)
+{
+  const int64_t row = index / m_Dims[0];
+  const int64_t i = index - row * m_Dims[0];
+  const uint64_t bit = uint64_t(1) << (i % 64);
+  uint64_t& word = m_Words[row * m_WordsPerRow + i / 64];
+  word = value ? (word | bit) : (word & ~bit);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::dilate(const PackedVoxelMask& source, bool xDirOn, bool yDirOn, bool zDirOn)
+{
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, static_cast<size_t>(m_Dims[2]));
+  dataAlg.execute(PackedVoxelMaskDilateImpl(source.m_Words.data(), m_Words.data(), m_Dims, m_WordsPerRow, m_LastWordMask, xDirOn, yDirOn, zDirOn));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::invert()
+{
+  for(size_t index = 0; index < m_Words.size(); index++)
+  {
+    m_Words[index] = ~m_Words[index];
+    if(static_cast<int64_t>(index % m_WordsPerRow) == m_WordsPerRow - 1)
+    {
+      m_Words[index] &= m_LastWordMask;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::intersect(const PackedVoxelMask& other)
+{
+  for(size_t index = 0; index < m_Words.size(); index++)
+  {
+    m_Words[index] &= other.m_Words[index];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<int64_t> PackedVoxelMask::findSetVoxels() const
+{
+  std::vector<int64_t> voxels;
+  for(int64_t row = 0; row < m_Dims[1] * m_Dims[2]; row++)
+  {
+    const uint64_t* rowWords = m_Words.data() + row * m_WordsPerRow;
+    for(int64_t word = 0; word < m_WordsPerRow; word++)
+    {
+      uint64_t bits = rowWords[word];
+      while(bits != 0)
+      {
+        voxels.push_back(row * m_Dims[0] + word * 64 + countTrailingZeros(bits));
+        bits &= bits - 1;
+      }
+    }
+  }
+  return voxels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackedVoxelMask::swap(PackedVoxelMask& other)
+{
+  m_Words.swap(other.m_Words);
+}
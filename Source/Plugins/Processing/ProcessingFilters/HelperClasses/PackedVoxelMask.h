@@ -0,0 +1,138 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The PackedVoxelMask class stores a boolean cell mask of an image geometry with 64 voxels per word. Every
+ * row along X starts on a new word and the bits past the end of a row are always clear, so a face neighbor step
+ * is a shift along X and a whole word OR along Y and Z.
+ */
+class PackedVoxelMask
+{
+public:
+  /**
+   * @param dims Dimensions of the image geometry
+   */
+  explicit PackedVoxelMask(const int64_t dims[3]);
+
+  virtual ~PackedVoxelMask();
+
+  /**
+   * @brief assign Packs a cell array, setting every voxel for which predicate returns true
+   * @param data Cell array with one component
+   * @param predicate Test applied to every value
+   */
+  template <typename T, typename Predicate>
+  void assign(const T* data, Predicate predicate)
+  {
+    for(int64_t row = 0; row < m_Dims[1] * m_Dims[2]; row++)
+    {
+      const T* rowData = data + row * m_Dims[0];
+      uint64_t* rowWords = m_Words.data() + row * m_WordsPerRow;
+      for(int64_t word = 0; word < m_WordsPerRow; word++)
+      {
+        int64_t start = word * 64;
+        int64_t end = std::min<int64_t>(start + 64, m_Dims[0]);
+        uint64_t bits = 0;
+        for(int64_t i = start; i < end; i++)
+        {
+          bits |= static_cast<uint64_t>(predicate(rowData[i]) ? 1 : 0) << (i - start);
+        }
+        rowWords[word] = bits;
+      }
+    }
+  }
+
+  /**
+   * @brief copyTo Unpacks the mask into a bool cell array
+   */
+  void copyTo(bool* mask) const;
+
+  /**
+   * @brief test Returns whether the voxel at index is set
+   */
+  bool test(int64_t index) const;
+
+  /**
+   * @brief set Sets or clears the voxel at index
+   */
+  void set(int64_t index, bool value);
+
+  /**
+   * @brief dilate Replaces this mask with source plus every voxel that has a face neighbor in source along one of
+   * the enabled axes. Neighbors outside the geometry are ignored. The planes are processed in parallel.
+   * @param source Mask to dilate, which must be a different object of the same dimensions
+   */
+  void dilate(const PackedVoxelMask& source, bool xDirOn, bool yDirOn, bool zDirOn);
+
+  /**
+   * @brief invert Flips every voxel of the mask
+   */
+  void invert();
+
+  /**
+   * @brief intersect Clears every voxel that is not set in other
+   */
+  void intersect(const PackedVoxelMask& other);
+
+  /**
+   * @brief findSetVoxels Returns the indices of the set voxels in ascending order
+   */
+  std::vector<int64_t> findSetVoxels() const;
+
+  /**
+   * @brief swap Exchanges the contents of two masks of the same dimensions
+   */
+  void swap(PackedVoxelMask& other);
+
+private:
+  int64_t m_Dims[3] = {0, 0, 0};
+  int64_t m_WordsPerRow = 0;
+  uint64_t m_LastWordMask = 0;
+  std::vector<uint64_t> m_Words;
+
+public:
+  PackedVoxelMask(const PackedVoxelMask&) = delete;            // Copy Constructor Not Implemented
+  PackedVoxelMask(PackedVoxelMask&&) = delete;                 // Move Constructor Not Implemented
+  PackedVoxelMask& operator=(const PackedVoxelMask&) = delete; // Copy Assignment Not Implemented
+  PackedVoxelMask& operator=(PackedVoxelMask&&) = delete;      // Move Assignment Not Implemented
+};
@@ -35,6 +35,9 @@
 
 #include "IdentifySample.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -47,6 +50,7 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Processing/ProcessingConstants.h"
 #include "Processing/ProcessingVersion.h"
@@ -123,6 +127,265 @@ void IdentifySample::dataCheck()
   }
 }
 
+namespace
+{
+/**
+ * @brief The VoxelRun struct is a run of consecutive voxels along X within one row of the volume
+ */
+struct VoxelRun
+{
+  int64_t begin = 0; // First X index of the run
+  int64_t end = 0;   // One past the last X index of the run
+};
+
+/**
+ * @brief The RunComponents struct holds the 6-connected components of a voxel selection. The runs of row y of plane z are
+ * runs[rowStarts[z * yDim + y]] up to runs[rowStarts[z * yDim + y + 1]], and component holds the index of the first run
+ * of the component each run belongs to.
+ */
+struct RunComponents
+{
+  std::vector<VoxelRun> runs;
+  std::vector<size_t> rowStarts;
+  std::vector<size_t> component;
+};
+
+/**
+ * @brief findRoot Returns the smallest run of the component of run, halving the path on the way
+ */
+size_t findRoot(std::vector<size_t>& parent, size_t run)
+{
+  while(parent[run] != run)
+  {
+    parent[run] = parent[parent[run]];
+    run = parent[run];
+  }
+  return run;
+}
+
+/**
+ * @brief joinRows Unites every run of [first0, last0) with the runs of [first1, last1) that share an X index with it
+ */
+void joinRows(const std::vector<VoxelRun>& runs, std::vector<size_t>& parent, size_t first0, size_t last0, size_t first1, size_t last1)
+{
+  size_t r0 = first0;
+  size_t r1 = first1;
+  while(r0 < last0 && r1 < last1)
+  {
+    if(runs[r0].begin < runs[r1].end && runs[r1].begin < runs[r0].end)
+    {
+      size_t root0 = findRoot(parent, r0);
+      size_t root1 = findRoot(parent, r1);
+      if(root0 < root1)
+      {
+        parent[root1] = root0;
+      }
+      else if(root1 < root0)
+      {
+        parent[root0] = root1;
+      }
+    }
+    if(runs[r0].end < runs[r1].end)
+    {
+      r0++;
+    }
+    else
+    {
+      r1++;
+    }
+  }
+}
+} // namespace
+
+/**
+ * @brief The IdentifySampleFindRunsImpl class collects, for a range of Z planes, the runs of voxels whose mask value is the selected one
+ */
+template <typename T>
+class IdentifySampleFindRunsImpl
+{
+public:
+  IdentifySampleFindRunsImpl(const T* mask, const int64_t* dims, bool value, std::vector<std::vector<VoxelRun>>& planeRuns, std::vector<size_t>& rowCounts)
+  : m_Mask(mask)
+  , m_Dims(dims)
+  , m_Value(value)
+  , m_PlaneRuns(planeRuns)
+  , m_RowCounts(rowCounts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t z = range.min(); z < range.max(); z++)
+    {
+      std::vector<VoxelRun>& runs = m_PlaneRuns[z];
+      for(int64_t y = 0; y < m_Dims[1]; y++)
+      {
+        const T* row = m_Mask + (static_cast<int64_t>(z) * m_Dims[1] + y) * m_Dims[0];
+        size_t numRuns = runs.size();
+        int64_t x = 0;
+        while(x < m_Dims[0])
+        {
+          if(static_cast<bool>(row[x]) != m_Value)
+          {
+            x++;
+            continue;
+          }
+          VoxelRun run;
+          run.begin = x;
+          while(x < m_Dims[0] && static_cast<bool>(row[x]) == m_Value)
+          {
+            x++;
+          }
+          run.end = x;
+          runs.push_back(run);
+        }
+        m_RowCounts[z * m_Dims[1] + y] = runs.size() - numRuns;
+      }
+    }
+  }
+
+private:
+  const T* m_Mask = nullptr;
+  const int64_t* m_Dims = nullptr;
+  bool m_Value = true;
+  std::vector<std::vector<VoxelRun>>& m_PlaneRuns;
+  std::vector<size_t>& m_RowCounts;
+};
+
+/**
+ * @brief The IdentifySampleJoinPlanesImpl class unites the overlapping runs of neighboring rows within a range of Z
+ * planes. Only runs of the same plane are linked, so the planes are independent of each other.
+ */
+class IdentifySampleJoinPlanesImpl
+{
+public:
+  IdentifySampleJoinPlanesImpl(const int64_t* dims, RunComponents& components)
+  : m_Dims(dims)
+  , m_Components(components)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const std::vector<size_t>& rowStarts = m_Components.rowStarts;
+    for(size_t z = range.min(); z < range.max(); z++)
+    {
+      for(int64_t y = 1; y < m_Dims[1]; y++)
+      {
+        size_t row = z * m_Dims[1] + y;
+        joinRows(m_Components.runs, m_Components.component, rowStarts[row - 1], rowStarts[row], rowStarts[row], rowStarts[row + 1]);
+      }
+    }
+  }
+
+private:
+  const int64_t* m_Dims = nullptr;
+  RunComponents& m_Components;
+};
+
+/**
+ * @brief The IdentifySampleWriteRunsImpl class sets the mask of every run whose component is selected, for a range of Z planes
+ */
+template <typename T>
+class IdentifySampleWriteRunsImpl
+{
+public:
+  IdentifySampleWriteRunsImpl(T* mask, const int64_t* dims, const RunComponents& components, const std::vector<uint8_t>& selected, bool value)
+  : m_Mask(mask)
+  , m_Dims(dims)
+  , m_Components(components)
+  , m_Selected(selected)
+  , m_Value(value)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t z = range.min(); z < range.max(); z++)
+    {
+      for(int64_t y = 0; y < m_Dims[1]; y++)
+      {
+        size_t row = z * m_Dims[1] + y;
+        T* rowMask = m_Mask + row * m_Dims[0];
+        for(size_t r = m_Components.rowStarts[row]; r < m_Components.rowStarts[row + 1]; r++)
+        {
+          if(m_Selected[m_Components.component[r]] != 0)
+          {
+            const VoxelRun& run = m_Components.runs[r];
+            std::fill(rowMask + run.begin, rowMask + run.end, static_cast<T>(m_Value));
+          }
+        }
+      }
+    }
+  }
+
+private:
+  T* m_Mask = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const RunComponents& m_Components;
+  const std::vector<uint8_t>& m_Selected;
+  bool m_Value = true;
+};
+
+/**
+ * @brief labelComponents Finds the 6-connected components of the voxels whose mask value is value. The runs are
+ * found and joined inside each Z plane in parallel, then the planes are joined to each other in a single sweep.
+ */
+template <typename T>
+RunComponents labelComponents(const T* mask, const int64_t* dims, bool value)
+{
+  size_t numPlanes = static_cast<size_t>(dims[2]);
+  size_t numRows = static_cast<size_t>(dims[1] * dims[2]);
+
+  std::vector<std::vector<VoxelRun>> planeRuns(numPlanes);
+  std::vector<size_t> rowCounts(numRows, 0);
+  ParallelDataAlgorithm findAlg;
+  findAlg.setRange(0, numPlanes);
+  findAlg.execute(IdentifySampleFindRunsImpl<T>(mask, dims, value, planeRuns, rowCounts));
+
+  RunComponents components;
+  components.rowStarts.resize(numRows + 1, 0);
+  for(size_t row = 0; row < numRows; row++)
+  {
+    components.rowStarts[row + 1] = components.rowStarts[row] + rowCounts[row];
+  }
+  components.runs.reserve(components.rowStarts[numRows]);
+  for(auto& runs : planeRuns)
+  {
+    components.runs.insert(components.runs.end(), runs.begin(), runs.end());
+    std::vector<VoxelRun>().swap(runs);
+  }
+
+  size_t numRuns = components.runs.size();
+  components.component.resize(numRuns);
+  for(size_t r = 0; r < numRuns; r++)
+  {
+    components.component[r] = r;
+  }
+
+  ParallelDataAlgorithm joinAlg;
+  joinAlg.setRange(0, numPlanes);
+  joinAlg.execute(IdentifySampleJoinPlanesImpl(dims, components));
+
+  for(size_t z = 1; z < numPlanes; z++)
+  {
+    for(int64_t y = 0; y < dims[1]; y++)
+    {
+      size_t row = z * dims[1] + y;
+      size_t belowRow = row - dims[1];
+      joinRows(components.runs, components.component, components.rowStarts[belowRow], components.rowStarts[belowRow + 1], components.rowStarts[row], components.rowStarts[row + 1]);
+    }
+  }
+
+  // Every link points at a smaller run, so one ascending pass resolves each run to the first run of its component
+  for(size_t r = 0; r < numRuns; r++)
+  {
+    components.component[r] = components.component[components.component[r]];
+  }
+
+  return components;
+}
+
 template <typename T>
 void _execute(IdentifySample* filter)
 {
@@ -136,8 +399,6 @@ void _execute(IdentifySample* filter)
   ArrayPointerType m_GoodVoxelsPtr = dca->getPrereqArrayFromPath<ArrayType>(filter, filter->getGoodVoxelsArrayPath(), cDims);
   T* m_GoodVoxels = m_GoodVoxelsPtr->getTuplePointer(0);
 
-  int64_t totalPoints = static_cast<int64_t>(m_GoodVoxelsPtr->getNumberOfTuples());
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -145,196 +406,75 @@ void _execute(IdentifySample* filter)
       static_cast<int64_t>(udims[1]),
       static_cast<int64_t>(udims[2]),
   };
+  size_t numPlanes = static_cast<size_t>(dims[2]);
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  int64_t xp = dims[0];
-  int64_t yp = dims[1];
-  int64_t zp = dims[2];
-
-  neighpoints[0] = -(xp * yp);
-  neighpoints[1] = -xp;
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = xp;
-  neighpoints[5] = (xp * yp);
-  std::vector<int64_t> currentvlist;
-  std::vector<bool> checked(totalPoints, false);
-  std::vector<bool> sample(totalPoints, false);
-  int64_t biggestBlock = 0;
-  size_t count = 0;
-  int32_t good = 0;
-  int64_t neighbor = 0;
-  int64_t column = 0, row = 0, plane = 0;
-  int64_t index = 0;
-
-  // In this loop over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
-  // are flipped to be called 'bad' voxels or 'not sample'
-  float threshold = 0.0f;
-  for(int64_t i = 0; i < totalPoints; i++)
+  // In this pass over the data we are finding the biggest contiguous set of GoodVoxels and calling that the 'sample'  All GoodVoxels that do not touch the 'sample'
+  // are flipped to be called 'bad' voxels or 'not sample'. On a tie the component found last in voxel order wins.
+  filter->notifyStatusMessage(QObject::tr("Labeling Good Voxels"));
   {
-    float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-    if(percentIncrement > threshold)
+    RunComponents components = labelComponents(m_GoodVoxels, dims, true);
+    size_t numRuns = components.runs.size();
+
+    std::vector<size_t> componentSizes(numRuns, 0);
+    for(size_t r = 0; r < numRuns; r++)
     {
-      QString ss = QObject::tr("%1% Scanned").arg(static_cast<int32_t>(percentIncrement));
-      filter->notifyStatusMessage(ss);
-      threshold = threshold + 5.0f;
-      if(threshold < percentIncrement)
+      componentSizes[components.component[r]] += static_cast<size_t>(components.runs[r].end - components.runs[r].begin);
+    }
+    size_t sampleComponent = 0;
+    size_t biggestBlock = 0;
+    for(size_t r = 0; r < numRuns; r++)
+    {
+      if(componentSizes[r] > 0 && componentSizes[r] >= biggestBlock)
       {
-        threshold = percentIncrement;
+        biggestBlock = componentSizes[r];
+        sampleComponent = r;
       }
     }
 
-    if(!checked[i] && m_GoodVoxels[i])
+    std::vector<uint8_t> notSample(numRuns, 1);
+    if(numRuns > 0)
     {
-      currentvlist.push_back(i);
-      count = 0;
-      while(count < currentvlist.size())
-      {
-        index = currentvlist[count];
-        column = index % xp;
-        row = (index / xp) % yp;
-        plane = index / (xp * yp);
-        for(int32_t j = 0; j < 6; j++)
-        {
-          good = 1;
-          neighbor = index + neighpoints[j];
-          if(j == 0 && plane == 0)
-          {
-            good = 0;
-          }
-          if(j == 5 && plane == (zp - 1))
-          {
-            good = 0;
-          }
-          if(j == 1 && row == 0)
-          {
-            good = 0;
-          }
-          if(j == 4 && row == (yp - 1))
-          {
-            good = 0;
-          }
-          if(j == 2 && column == 0)
-          {
-            good = 0;
-          }
-          if(j == 3 && column == (xp - 1))
-          {
-            good = 0;
-          }
-          if(good == 1 && !checked[neighbor] && m_GoodVoxels[neighbor])
-          {
-            currentvlist.push_back(neighbor);
-            checked[neighbor] = true;
-          }
-        }
-        count++;
-      }
-      if(static_cast<int64_t>(currentvlist.size()) >= biggestBlock)
-      {
-        biggestBlock = currentvlist.size();
-        sample.assign(totalPoints, false);
-        for(int64_t j = 0; j < biggestBlock; j++)
-        {
-          sample[currentvlist[j]] = true;
-        }
-      }
-      currentvlist.clear();
+      notSample[sampleComponent] = 0;
     }
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numPlanes);
+    dataAlg.execute(IdentifySampleWriteRunsImpl<T>(m_GoodVoxels, dims, components, notSample, false));
   }
-  for(int64_t i = 0; i < totalPoints; i++)
+
+  if(filter->getCancel())
   {
-    if(!sample[i] && m_GoodVoxels[i])
-    {
-      m_GoodVoxels[i] = false;
-    }
+    return;
   }
-  sample.clear();
-  checked.assign(totalPoints, false);
 
-  // In this loop we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
+  // In this pass we are going to 'close' all of the 'holes' inside of the region already identified as the 'sample' if the user chose to do so.
   // This is done by flipping all 'bad' voxel features that do not touch the outside of the sample (i.e. they are fully contained inside of the 'sample'.
-  threshold = 0.0F;
   if(filter->getFillHoles())
   {
-    bool touchesBoundary = false;
-    for(int64_t i = 0; i < totalPoints; i++)
-    {
-      float percentIncrement = static_cast<float>(i) / static_cast<float>(totalPoints) * 100.0f;
-      if(percentIncrement > threshold)
-      {
-        QString ss = QObject::tr("%1% Filling Holes").arg(static_cast<int32_t>(percentIncrement));
-        filter->notifyStatusMessage(ss);
-        threshold = threshold + 5.0f;
-        if(threshold < percentIncrement)
-        {
-          threshold = percentIncrement;
-        }
-      }
+    filter->notifyStatusMessage(QObject::tr("Filling Holes"));
+    RunComponents components = labelComponents(m_GoodVoxels, dims, false);
+    size_t numRuns = components.runs.size();
 
-      if(!checked[i] && !m_GoodVoxels[i])
+    std::vector<uint8_t> isHole(numRuns, 1);
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
       {
-        currentvlist.push_back(i);
-        count = 0;
-        touchesBoundary = false;
-        while(count < currentvlist.size())
-        {
-          index = currentvlist[count];
-          column = index % xp;
-          row = (index / xp) % yp;
-          plane = index / (xp * yp);
-          if(column == 0 || column == (xp - 1) || row == 0 || row == (yp - 1) || plane == 0 || plane == (zp - 1))
-          {
-            touchesBoundary = true;
-          }
-          for(int32_t j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = index + neighpoints[j];
-            if(j == 0 && plane == 0)
-            {
-              good = 0;
-            }
-            if(j == 5 && plane == (zp - 1))
-            {
-              good = 0;
-            }
-            if(j == 1 && row == 0)
-            {
-              good = 0;
-            }
-            if(j == 4 && row == (yp - 1))
-            {
-              good = 0;
-            }
-            if(j == 2 && column == 0)
-            {
-              good = 0;
-            }
-            if(j == 3 && column == (xp - 1))
-            {
-              good = 0;
-            }
-            if(good == 1 && !checked[neighbor] && !m_GoodVoxels[neighbor])
-            {
-              currentvlist.push_back(neighbor);
-              checked[neighbor] = true;
-            }
-          }
-          count++;
-        }
-        if(!touchesBoundary)
+        size_t row = z * dims[1] + y;
+        bool boundaryRow = (y == 0 || y == dims[1] - 1 || z == 0 || z == dims[2] - 1);
+        for(size_t r = components.rowStarts[row]; r < components.rowStarts[row + 1]; r++)
         {
-          for(size_t j = 0; j < currentvlist.size(); j++)
+          if(boundaryRow || components.runs[r].begin == 0 || components.runs[r].end == dims[0])
           {
-            m_GoodVoxels[currentvlist[j]] = true;
+            isHole[components.component[r]] = 0;
           }
         }
-        currentvlist.clear();
       }
     }
+
+    ParallelDataAlgorithm dataAlg;
+    dataAlg.setRange(0, numPlanes);
+    dataAlg.execute(IdentifySampleWriteRunsImpl<T>(m_GoodVoxels, dims, components, isHole, true));
   }
-  checked.clear();
 }
 
 // -----------------------------------------------------------------------------
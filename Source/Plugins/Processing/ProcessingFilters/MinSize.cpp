@@ -48,6 +48,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 
 #include "Processing/ProcessingConstants.h"
+#include "Processing/ProcessingFilters/HelperClasses/MajorityNeighborFill.h"
 #include "Processing/ProcessingVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -100,7 +101,6 @@ void MinSize::setupFilterParameters()
 // -----------------------------------------------------------------------------
 void MinSize::initialize()
 {
-  m_Neighbors = nullptr;
 }
 
 // -----------------------------------------------------------------------------
@@ -234,7 +234,6 @@ void MinSize::assign_badpoints()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -243,154 +242,20 @@ void MinSize::assign_badpoints()
       static_cast<int64_t>(udims[2]),
   };
 
-  Int32ArrayType::Pointer neighborsPtr = Int32ArrayType::CreateArray(totalPoints, std::string("_INTERNAL_USE_ONLY_Neighbors"), true);
-  m_Neighbors = neighborsPtr->getPointer(0);
-  neighborsPtr->initializeWithValue(-1);
-
-  int32_t good = 1;
-  int32_t current = 0;
-  int32_t most = 0;
-  int64_t neighpoint = 0;
-
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  size_t counter = 1;
-  int64_t count = 0;
-  int64_t kstride = 0, jstride = 0;
-  int32_t featurename = 0, feature = 0;
-  int32_t neighbor = 0;
-  QVector<int32_t> n(m_NumCellsPtr.lock()->getNumberOfTuples(), 0);
-  while(counter != 0)
+  QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
+  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+  for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
-    counter = 0;
-    for(int64_t k = 0; k < dims[2]; k++)
-    {
-      kstride = dims[0] * dims[1] * k;
-      for(int64_t j = 0; j < dims[1]; j++)
-      {
-        jstride = dims[0] * j;
-        for(int64_t i = 0; i < dims[0]; i++)
-        {
-          count = kstride + jstride + i;
-          featurename = m_FeatureIds[count];
-          if(featurename < 0)
-          {
-            counter++;
-            most = 0;
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature]++;
-                  current = n[feature];
-                  if(current > most)
-                  {
-                    most = current;
-                    m_Neighbors[count] = neighpoint;
-                  }
-                }
-              }
-            }
-            for(int32_t l = 0; l < 6; l++)
-            {
-              good = 1;
-              neighpoint = count + neighpoints[l];
-              if(l == 0 && k == 0)
-              {
-                good = 0;
-              }
-              if(l == 5 && k == (dims[2] - 1))
-              {
-                good = 0;
-              }
-              if(l == 1 && j == 0)
-              {
-                good = 0;
-              }
-              if(l == 4 && j == (dims[1] - 1))
-              {
-                good = 0;
-              }
-              if(l == 2 && i == 0)
-              {
-                good = 0;
-              }
-              if(l == 3 && i == (dims[0] - 1))
-              {
-                good = 0;
-              }
-              if(good == 1)
-              {
-                feature = m_FeatureIds[neighpoint];
-                if(feature >= 0)
-                {
-                  n[feature] = 0;
-                }
-              }
-            }
-          }
-        }
-      }
-    }
-    QString attrMatName = m_FeatureIdsArrayPath.getAttributeMatrixName();
-    QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-    for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
-    {
-      voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
-    }
-    // TODO: This loop could be parallelized. Look at NeighborOrientationCorrelation filter
-    for(size_t j = 0; j < totalPoints; j++)
-    {
-      featurename = m_FeatureIds[j];
-      neighbor = m_Neighbors[j];
-      if(neighbor >= 0)
-      {
-        if(featurename < 0 && m_FeatureIds[neighbor] >= 0)
-        {
-          for(auto& voxelArrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(voxelArrayName);
-            p->copyTuple(neighbor, j);
-          }
-        }
-      }
-    }
+    voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
+  std::vector<IDataArray::Pointer> voxelArrays;
+  for(const auto& arrayName : voxelArrayNames)
+  {
+    voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(arrayName));
+  }
+
+  MajorityNeighborFill neighborFill(this, dims, m_FeatureIds, 0);
+  neighborFill.execute(voxelArrays);
 }
 
 // -----------------------------------------------------------------------------
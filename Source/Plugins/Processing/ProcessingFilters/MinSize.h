@@ -268,8 +268,6 @@ private:
   DataArrayPath m_NumCellsArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::NumCells};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  int32_t* m_Neighbors = nullptr;
-
 public:
   MinSize(const MinSize&) = delete;            // Copy Constructor Not Implemented
   MinSize(MinSize&&) = delete;                 // Move Constructor Not Implemented
@@ -226,8 +226,6 @@ private:
   DataArrayPath m_FlaggedFeaturesArrayPath = {SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Active};
   std::vector<DataArrayPath> m_IgnoredDataArrayPaths = {};
 
-  int32_t* m_Neighbors;
-
 public:
   RemoveFlaggedFeatures(const RemoveFlaggedFeatures&) = delete;            // Copy Constructor Not Implemented
   RemoveFlaggedFeatures(RemoveFlaggedFeatures&&) = delete;                 // Move Constructor Not Implemented
@@ -33,6 +33,10 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+#include <complex>
+#include <vector>
+
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 
@@ -51,6 +55,9 @@
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 #include "UnitTestSupport.hpp"
 
+#include "Processing/ProcessingFilters/DetectEllipsoids.h"
+#include "Processing/ProcessingFilters/HelperClasses/DetectEllipsoidsImpl.h"
+
 #include "ProcessingTestFileLocations.h"
 
 class DetectEllipsoidsTest
@@ -217,6 +224,99 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFFTConvolution()
+  {
+    // A kernel with z offsets of -1, 0 and 1, laid out the way DetectEllipsoids::createOffsetArray does it
+    std::vector<size_t> kernel_tDims = {7, 5, 3};
+    Int32ArrayType::Pointer offsetArray = Int32ArrayType::CreateArray(kernel_tDims, std::vector<size_t>(1, 3), "Coordinate Array", true);
+    DE_ComplexDoubleVector kernel;
+    std::vector<double> realKernel;
+    size_t index = 0;
+    for(int z = 0; z < 3; z++)
+    {
+      for(int y = 0; y < 5; y++)
+      {
+        for(int x = 0; x < 7; x++)
+        {
+          offsetArray->setComponent(index, 0, x - 3);
+          offsetArray->setComponent(index, 1, y - 2);
+          offsetArray->setComponent(index, 2, z - 1);
+          kernel.push_back(std::complex<double>(std::cos(0.7 * index), std::sin(0.3 * index)));
+          realKernel.push_back(std::cos(0.7 * index));
+          index++;
+        }
+      }
+    }
+
+    // A 13 x 9 object image with the 1-pixel zero border the filter pads every object with
+    std::vector<size_t> paddedObj_tDims = {13, 9};
+    DoubleArrayType::Pointer image = DoubleArrayType::CreateArray(paddedObj_tDims, std::vector<size_t>(1, 1), "Padded Object", true);
+    image->initializeWithZeros();
+    for(size_t y = 1; y < paddedObj_tDims[1] - 1; y++)
+    {
+      for(size_t x = 1; x < paddedObj_tDims[0] - 1; x++)
+      {
+        image->setValue(y * paddedObj_tDims[0] + x, ((3 * x + 5 * y) % 7) / 7.0 - 0.25);
+      }
+    }
+
+    DetectEllipsoids::Pointer filter = DetectEllipsoids::New();
+    DE_EllipseBuffer ellipses;
+    DetectEllipsoidsImpl impl(0, filter.get(), ellipses, nullptr, paddedObj_tDims, UInt32ArrayType::NullPointer(), kernel, kernel, kernel, kernel_tDims, offsetArray, realKernel, offsetArray,
+                              0.0, 0.0, 0.0f, 0.0f);
+
+    std::pair<size_t, size_t> fftDims = impl.getPaddedFFTDims(offsetArray, paddedObj_tDims);
+    DREAM3D_REQUIRE_EQUAL(fftDims.first, 16);
+    DREAM3D_REQUIRE_EQUAL(fftDims.second, 16);
+
+    DE_SpectrumCache cache;
+    const DE_ComplexDoubleVector& kernelSpectrum = impl.getKernelSpectrum(kernel, offsetArray, fftDims, cache);
+    DREAM3D_REQUIRE(&impl.getKernelSpectrum(kernel, offsetArray, fftDims, cache) == &kernelSpectrum);
+    DREAM3D_REQUIRE_EQUAL(cache.size(), 1);
+
+    // Complex gradient kernel
+    DE_ComplexDoubleVector spectrum = impl.imageSpectrum(image, paddedObj_tDims, fftDims);
+    for(size_t i = 0; i < spectrum.size(); i++)
+    {
+      spectrum[i] *= kernelSpectrum[i];
+    }
+    DE_ComplexDoubleVector fftConv = impl.inverseSpectrum(spectrum, paddedObj_tDims, fftDims);
+    DE_ComplexDoubleVector directConv = impl.convoluteImage(image, kernel, offsetArray, paddedObj_tDims);
+    DREAM3D_REQUIRE_EQUAL(fftConv.size(), directConv.size());
+    for(size_t i = 0; i < directConv.size(); i++)
+    {
+      DREAM3D_REQUIRED(std::abs(fftConv[i] - directConv[i]), <, 1.0E-9);
+    }
+
+    // Real smoothing kernel
+    DE_SpectrumCache smoothCache;
+    DE_ComplexDoubleVector smoothKernel(realKernel.begin(), realKernel.end());
+    const DE_ComplexDoubleVector& smoothSpectrum = impl.getKernelSpectrum(smoothKernel, offsetArray, fftDims, smoothCache);
+    spectrum = impl.imageSpectrum(image, paddedObj_tDims, fftDims);
+    for(size_t i = 0; i < spectrum.size(); i++)
+    {
+      spectrum[i] *= smoothSpectrum[i];
+    }
+    fftConv = impl.inverseSpectrum(spectrum, paddedObj_tDims, fftDims);
+    std::vector<double> directSmooth = impl.convoluteImage(image, realKernel, offsetArray, paddedObj_tDims);
+    for(size_t i = 0; i < directSmooth.size(); i++)
+    {
+      DREAM3D_REQUIRED(std::abs(fftConv[i].real() - directSmooth[i]), <, 1.0E-9);
+      DREAM3D_REQUIRED(std::abs(fftConv[i].imag()), <, 1.0E-9);
+    }
+
+    // A 3 x 3 kernel stays direct on a 40 x 40 object, a 31 x 31 kernel goes through the FFT
+    std::vector<size_t> largeObj_tDims = {40, 40};
+    std::pair<size_t, size_t> largeFFTDims(64, 64);
+    DREAM3D_REQUIRE_EQUAL(impl.useFFTConvolution(9, largeObj_tDims, largeFFTDims, 1.5), false);
+    DREAM3D_REQUIRE_EQUAL(impl.useFFTConvolution(961, largeObj_tDims, largeFFTDims, 1.5), true);
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -228,6 +328,8 @@ public:
 
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
+    DREAM3D_REGISTER_TEST(TestFFTConvolution());
+
     DREAM3D_REGISTER_TEST(TestDetectEllipsoids());
 
     if(testOutFile.isOpen())
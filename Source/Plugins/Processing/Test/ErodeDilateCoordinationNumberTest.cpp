@@ -0,0 +1,218 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class ErodeDilateCoordinationNumberTest
+{
+
+public:
+  ErodeDilateCoordinationNumberTest() = default;
+  ~ErodeDilateCoordinationNumberTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the ErodeDilateCoordinationNumber Filter from the FilterManager
+    QString filtName = "ErodeDilateCoordinationNumber";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on two 7 x 5 planes of Feature Ids, given as one picture per Z plane with rows along Y, and
+  // compares every voxel with the expected pictures. A second cell array holds 1.5 times the Feature Id, so it shows
+  // that whole tuples are copied from the same source voxel.
+  // -----------------------------------------------------------------------------
+  void checkFeatureIds(int coordinationNumber, bool loop, const std::vector<std::vector<QString>>& expected)
+  {
+    const std::vector<std::vector<QString>> input = {
+        {"1110022", "1100022", "1010222", "0000022", "3300000"},
+        {"1110222", "1111022", "0000202", "3030020", "3330000"},
+    };
+    const size_t dims[3] = {7, 5, 2};
+    const size_t totalPoints = dims[0] * dims[1] * dims[2];
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds, true);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(totalPoints, QString("Data"), true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          int32_t featureId = input[z][y][static_cast<int>(x)].digitValue();
+          featureIds->setValue(index, featureId);
+          data->setValue(index, 1.5f * static_cast<float>(featureId));
+        }
+      }
+    }
+    cellAM->insertOrAssign(featureIds);
+    cellAM->insertOrAssign(data);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("ErodeDilateCoordinationNumber")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE(filter->setProperty("FeatureIdsArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("CoordinationNumber", coordinationNumber))
+    DREAM3D_REQUIRE(filter->setProperty("Loop", loop))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          DREAM3D_REQUIRE_EQUAL(featureIds->getValue(index), expected[z][y][static_cast<int>(x)].digitValue())
+          DREAM3D_REQUIRE_EQUAL(data->getValue(index), 1.5f * static_cast<float>(featureIds->getValue(index)))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // A single sweep. Voxels reassigned earlier in the sweep change the coordination numbers of the voxels after them.
+  // -----------------------------------------------------------------------------
+  int TestSingleSweep()
+  {
+    checkFeatureIds(1, false,
+                    {
+                        {"1100222", "1011222", "0101000", "3331100", "3031111"},
+                        {"1102000", "0000200", "3111020", "0301100", "0001111"},
+                    });
+    checkFeatureIds(2, false,
+                    {
+                        {"1100222", "1011222", "0001222", "3331220", "3331220"},
+                        {"1102222", "1000222", "1001022", "3301200", "3301220"},
+                    });
+    checkFeatureIds(3, false,
+                    {
+                        {"1110022", "1110022", "0000022", "0000022", "3300000"},
+                        {"1111222", "1110222", "0000022", "0000000", "3300000"},
+                    });
+    checkFeatureIds(4, false,
+                    {
+                        {"1110022", "1110022", "1000222", "0000022", "3300000"},
+                        {"1110222", "1110022", "0000022", "3000020", "3330000"},
+                    });
+    // No voxel of the fixture has six face neighbors across the interface
+    checkFeatureIds(6, false,
+                    {
+                        {"1110022", "1100022", "1010222", "0000022", "3300000"},
+                        {"1110222", "1111022", "0000202", "3030020", "3330000"},
+                    });
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Sweeps repeat until no voxel reaches the coordination number
+  // -----------------------------------------------------------------------------
+  int TestLoop()
+  {
+    checkFeatureIds(2, true,
+                    {
+                        {"2222222", "2222222", "3331222", "3331222", "3331222"},
+                        {"2222222", "2222222", "3331222", "3331222", "3331222"},
+                    });
+    checkFeatureIds(3, true,
+                    {
+                        {"1110022", "1110022", "0000022", "0000000", "3300000"},
+                        {"1111222", "1111222", "0000022", "0000000", "3300000"},
+                    });
+    checkFeatureIds(4, true,
+                    {
+                        {"1110022", "1110022", "1000022", "0000022", "3300000"},
+                        {"1110222", "1110022", "0000022", "3000020", "3330000"},
+                    });
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### ErodeDilateCoordinationNumberTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSingleSweep());
+    DREAM3D_REGISTER_TEST(TestLoop());
+  }
+
+public:
+  ErodeDilateCoordinationNumberTest(const ErodeDilateCoordinationNumberTest&) = delete;            // Copy Constructor Not Implemented
+  ErodeDilateCoordinationNumberTest(ErodeDilateCoordinationNumberTest&&) = delete;                 // Move Constructor Not Implemented
+  ErodeDilateCoordinationNumberTest& operator=(const ErodeDilateCoordinationNumberTest&) = delete; // Copy Assignment Not Implemented
+  ErodeDilateCoordinationNumberTest& operator=(ErodeDilateCoordinationNumberTest&&) = delete;      // Move Assignment Not Implemented
+};
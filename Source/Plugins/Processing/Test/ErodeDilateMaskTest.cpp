@@ -0,0 +1,242 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class ErodeDilateMaskTest
+{
+
+public:
+  ErodeDilateMaskTest() = default;
+  ~ErodeDilateMaskTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the ErodeDilateMask Filter from the FilterManager
+    QString filtName = "ErodeDilateMask";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A sparse pattern that also sets the last voxel of every other row, so set bits sit on both sides of the
+  // 64 bit word boundaries of the packed rows
+  // -----------------------------------------------------------------------------
+  bool maskAt(size_t x, size_t y, size_t z, size_t xDim)
+  {
+    return ((x * 7 + y * 3 + z * 5) % 29) == 0 || (x + 1 == xDim && (y + z) % 2 == 0) || (x == 63 && y == 1);
+  }
+
+  // -----------------------------------------------------------------------------
+  // One voxel at a time erode or dilate iteration with the face neighbor rules of the filter
+  // -----------------------------------------------------------------------------
+  void referenceIteration(std::vector<bool>& mask, const size_t dims[3], unsigned int direction, const bool dirOn[3])
+  {
+    std::vector<bool> maskCopy = mask;
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          if(mask[index])
+          {
+            continue;
+          }
+          std::vector<size_t> neighbors;
+          if(dirOn[0] && x > 0)
+          {
+            neighbors.push_back(index - 1);
+          }
+          if(dirOn[0] && x + 1 < dims[0])
+          {
+            neighbors.push_back(index + 1);
+          }
+          if(dirOn[1] && y > 0)
+          {
+            neighbors.push_back(index - dims[0]);
+          }
+          if(dirOn[1] && y + 1 < dims[1])
+          {
+            neighbors.push_back(index + dims[0]);
+          }
+          if(dirOn[2] && z > 0)
+          {
+            neighbors.push_back(index - dims[0] * dims[1]);
+          }
+          if(dirOn[2] && z + 1 < dims[2])
+          {
+            neighbors.push_back(index + dims[0] * dims[1]);
+          }
+          for(const size_t& neighbor : neighbors)
+          {
+            if(mask[neighbor])
+            {
+              if(direction == 0)
+              {
+                maskCopy[index] = true;
+              }
+              else
+              {
+                maskCopy[neighbor] = false;
+              }
+            }
+          }
+        }
+      }
+    }
+    mask = maskCopy;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on one row length and compares every voxel with the reference iterations
+  // -----------------------------------------------------------------------------
+  void checkMask(size_t xDim, unsigned int direction, const bool dirOn[3])
+  {
+    const size_t dims[3] = {xDim, 4, 3};
+    const int numIterations = 2;
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    BoolArrayType::Pointer maskArray = BoolArrayType::CreateArray(dims[0] * dims[1] * dims[2], SIMPL::CellData::Mask, true);
+    std::vector<bool> expected(dims[0] * dims[1] * dims[2], false);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          expected[index] = (direction == 0) ? maskAt(x, y, z, xDim) : !maskAt(x, y, z, xDim);
+          maskArray->setValue(index, expected[index]);
+        }
+      }
+    }
+    cellAM->insertOrAssign(maskArray);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("ErodeDilateMask")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask));
+    DREAM3D_REQUIRE(filter->setProperty("MaskArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("Direction", direction))
+    DREAM3D_REQUIRE(filter->setProperty("NumIterations", numIterations))
+    DREAM3D_REQUIRE(filter->setProperty("XDirOn", dirOn[0]))
+    DREAM3D_REQUIRE(filter->setProperty("YDirOn", dirOn[1]))
+    DREAM3D_REQUIRE(filter->setProperty("ZDirOn", dirOn[2]))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    for(int iteration = 0; iteration < numIterations; iteration++)
+    {
+      referenceIteration(expected, dims, direction, dirOn);
+    }
+    for(size_t index = 0; index < expected.size(); index++)
+    {
+      DREAM3D_REQUIRE_EQUAL(maskArray->getValue(index), expected[index])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Rows one bit short of, exactly and one bit over a packed 64 bit word
+  // -----------------------------------------------------------------------------
+  int TestWordEdges()
+  {
+    const bool allDirs[3] = {true, true, true};
+    const bool xOnly[3] = {true, false, false};
+    const bool yzOnly[3] = {false, true, true};
+    for(size_t xDim = 63; xDim <= 65; xDim++)
+    {
+      for(unsigned int direction = 0; direction < 2; direction++)
+      {
+        checkMask(xDim, direction, allDirs);
+        checkMask(xDim, direction, xOnly);
+        checkMask(xDim, direction, yzOnly);
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### ErodeDilateMaskTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestWordEdges());
+  }
+
+public:
+  ErodeDilateMaskTest(const ErodeDilateMaskTest&) = delete;            // Copy Constructor Not Implemented
+  ErodeDilateMaskTest(ErodeDilateMaskTest&&) = delete;                 // Move Constructor Not Implemented
+  ErodeDilateMaskTest& operator=(const ErodeDilateMaskTest&) = delete; // Copy Assignment Not Implemented
+  ErodeDilateMaskTest& operator=(ErodeDilateMaskTest&&) = delete;      // Move Assignment Not Implemented
+};
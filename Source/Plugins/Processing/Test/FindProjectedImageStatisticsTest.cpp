@@ -0,0 +1,205 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class FindProjectedImageStatisticsTest
+{
+
+public:
+  FindProjectedImageStatisticsTest() = default;
+  ~FindProjectedImageStatisticsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindProjectedImageStatistics Filter from the FilterManager
+    QString filtName = "FindProjectedImageStatistics";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // An uneven volume with values on a large offset. The seven Z planes are split into several slabs whenever
+  // more than one thread is available, so the XY projection exercises the merge of the slab moments.
+  // -----------------------------------------------------------------------------
+  float valueAt(size_t x, size_t y, size_t z)
+  {
+    return 1000.0f + static_cast<float>((x * 7 + y * 3 + z * z * 5) % 11) + 0.25f * static_cast<float>(z * x);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on one plane and compares every voxel with a two pass evaluation of its projection line
+  // -----------------------------------------------------------------------------
+  void checkPlane(unsigned int plane)
+  {
+    const size_t dims[3] = {5, 4, 7};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(dims[0] * dims[1] * dims[2], "Data", true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          data->setValue((z * dims[1] + y) * dims[0] + x, valueAt(x, y, z));
+        }
+      }
+    }
+    cellAM->insertOrAssign(data);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindProjectedImageStatistics")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "Data"));
+    DREAM3D_REQUIRE(filter->setProperty("SelectedArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("Plane", plane))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    FloatArrayType::Pointer minArray = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ProjectedImageMin);
+    FloatArrayType::Pointer maxArray = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ProjectedImageMax);
+    FloatArrayType::Pointer avgArray = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ProjectedImageAvg);
+    FloatArrayType::Pointer stdArray = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ProjectedImageStd);
+    FloatArrayType::Pointer varArray = cellAM->getAttributeArrayAs<FloatArrayType>(SIMPL::CellData::ProjectedImageVar);
+    DREAM3D_REQUIRE_VALID_POINTER(minArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(maxArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(avgArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(stdArray.get())
+    DREAM3D_REQUIRE_VALID_POINTER(varArray.get())
+
+    // XY projects along Z, XZ along Y and YZ along X
+    const size_t axis = (plane == 0) ? 2 : ((plane == 1) ? 1 : 0);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          size_t line[3] = {x, y, z};
+          std::vector<double> values(dims[axis]);
+          for(size_t i = 0; i < dims[axis]; i++)
+          {
+            line[axis] = i;
+            values[i] = static_cast<double>(valueAt(line[0], line[1], line[2]));
+          }
+          double mean = 0.0;
+          for(double value : values)
+          {
+            mean += value;
+          }
+          mean /= static_cast<double>(values.size());
+          double var = 0.0;
+          for(double value : values)
+          {
+            var += (value - mean) * (value - mean);
+          }
+          var /= static_cast<double>(values.size());
+
+          size_t index = (z * dims[1] + y) * dims[0] + x;
+          DREAM3D_REQUIRE_EQUAL(minArray->getValue(index), static_cast<float>(*std::min_element(values.begin(), values.end())))
+          DREAM3D_REQUIRE_EQUAL(maxArray->getValue(index), static_cast<float>(*std::max_element(values.begin(), values.end())))
+          DREAM3D_REQUIRE(std::fabs(avgArray->getValue(index) - mean) < 0.0001 * mean)
+          DREAM3D_REQUIRE(std::fabs(varArray->getValue(index) - var) < 0.0001 * std::max(1.0, var))
+          DREAM3D_REQUIRE(std::fabs(stdArray->getValue(index) - std::sqrt(var)) < 0.0001 * std::max(1.0, std::sqrt(var)))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestProjectedPlanes()
+  {
+    checkPlane(0);
+    checkPlane(1);
+    checkPlane(2);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### FindProjectedImageStatisticsTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestProjectedPlanes());
+  }
+
+public:
+  FindProjectedImageStatisticsTest(const FindProjectedImageStatisticsTest&) = delete;            // Copy Constructor Not Implemented
+  FindProjectedImageStatisticsTest(FindProjectedImageStatisticsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindProjectedImageStatisticsTest& operator=(const FindProjectedImageStatisticsTest&) = delete; // Copy Assignment Not Implemented
+  FindProjectedImageStatisticsTest& operator=(FindProjectedImageStatisticsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,229 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class FindRelativeMotionBetweenSlicesTest
+{
+
+public:
+  FindRelativeMotionBetweenSlicesTest() = default;
+  ~FindRelativeMotionBetweenSlicesTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindRelativeMotionBetweenSlices Filter from the FilterManager
+    QString filtName = "FindRelativeMotionBetweenSlices";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds a 16 x 16 x 16 stack whose slices in the given plane are copies of one random texture, each shifted by
+  // (shift1, shift2) from the one before, runs the filter with 4 x 4 patches and one slice step, and checks that every
+  // voxel with a full search window moves by the shift. The motion is normalized and the spacing is 1.
+  // -----------------------------------------------------------------------------
+  void checkShift(uint32_t plane, int64_t shift1, int64_t shift2, int32_t searchSize)
+  {
+    const int64_t dims[3] = {16, 16, 16};
+    const size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    const int64_t textureSize = 96;
+
+    std::mt19937 generator(5489U);
+    std::vector<uint8_t> texture(textureSize * textureSize);
+    for(auto& value : texture)
+    {
+      value = static_cast<uint8_t>(generator() & 0xFF);
+    }
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {static_cast<size_t>(dims[0]), static_cast<size_t>(dims[1]), static_cast<size_t>(dims[2])};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    UInt8ArrayType::Pointer data = UInt8ArrayType::CreateArray(totalPoints, QString("Data"), true);
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          // The slice coordinate and the two in-plane coordinates of the voxel
+          int64_t slice = (plane == 0) ? z : ((plane == 1) ? y : x);
+          int64_t u = (plane == 2) ? y : x;
+          int64_t v = (plane == 0) ? y : z;
+          int64_t texel = (u - shift1 * slice + textureSize / 2) * textureSize + (v - shift2 * slice + textureSize / 2);
+          data->setValue((z * dims[1] + y) * dims[0] + x, texture[texel]);
+        }
+      }
+    }
+    cellAM->insertOrAssign(data);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindRelativeMotionBetweenSlices")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "Data"));
+    DREAM3D_REQUIRE(filter->setProperty("SelectedArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("Plane", plane))
+    DREAM3D_REQUIRE(filter->setProperty("PSize1", 4))
+    DREAM3D_REQUIRE(filter->setProperty("PSize2", 4))
+    DREAM3D_REQUIRE(filter->setProperty("SSize1", searchSize))
+    DREAM3D_REQUIRE(filter->setProperty("SSize2", searchSize))
+    DREAM3D_REQUIRE(filter->setProperty("SliceStep", 1))
+    DREAM3D_REQUIRE(filter->setProperty("MotionDirectionArrayName", QString("MotionDirection")))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    FloatArrayType::Pointer motion = cellAM->getAttributeArrayAs<FloatArrayType>("MotionDirection");
+    DREAM3D_REQUIRE_VALID_POINTER(motion.get())
+
+    // The search offset is (shift1, shift2) in the plane and one slice across it
+    float expected[3] = {1.0f, 1.0f, 1.0f};
+    expected[(plane == 2) ? 1 : 0] = static_cast<float>(shift1);
+    expected[(plane == 0) ? 1 : 2] = static_cast<float>(shift2);
+    float length = std::sqrt(expected[0] * expected[0] + expected[1] * expected[1] + expected[2] * expected[2]);
+
+    // The patch and search halves keep 4 voxels from the in-plane borders, and the last slice has nothing to match
+    const int64_t border = 4;
+    size_t checked = 0;
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          int64_t coords[3] = {x, y, z};
+          bool valid = true;
+          for(size_t d = 0; d < 3; d++)
+          {
+            bool sliceAxis = (d == 2 - plane);
+            valid = valid && (sliceAxis ? coords[d] < dims[d] - 1 : (coords[d] >= border && coords[d] < dims[d] - border));
+          }
+          if(!valid)
+          {
+            continue;
+          }
+          size_t index = static_cast<size_t>((z * dims[1] + y) * dims[0] + x);
+          for(size_t d = 0; d < 3; d++)
+          {
+            DREAM3D_REQUIRE(std::abs(motion->getComponent(index, d) - expected[d] / length) < 1.0E-6f)
+          }
+          checked++;
+        }
+      }
+    }
+    DREAM3D_REQUIRE_EQUAL(checked, static_cast<size_t>(8 * 8 * 15))
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestXYShift()
+  {
+    checkShift(0, 1, -2, 5);
+    // An even search size still covers -2 to 2
+    checkShift(0, 1, -2, 4);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestXZShift()
+  {
+    checkShift(1, -1, 2, 5);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestYZShift()
+  {
+    checkShift(2, 2, 1, 5);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### FindRelativeMotionBetweenSlicesTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestXYShift())
+    DREAM3D_REGISTER_TEST(TestXZShift())
+    DREAM3D_REGISTER_TEST(TestYZShift())
+  }
+
+public:
+  FindRelativeMotionBetweenSlicesTest(const FindRelativeMotionBetweenSlicesTest&) = delete;            // Copy Constructor Not Implemented
+  FindRelativeMotionBetweenSlicesTest(FindRelativeMotionBetweenSlicesTest&&) = delete;                 // Move Constructor Not Implemented
+  FindRelativeMotionBetweenSlicesTest& operator=(const FindRelativeMotionBetweenSlicesTest&) = delete; // Copy Assignment Not Implemented
+  FindRelativeMotionBetweenSlicesTest& operator=(FindRelativeMotionBetweenSlicesTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -1,52 +1,66 @@
-// -----------------------------------------------------------------------------
-// Insert your license & copyright information here
-// -----------------------------------------------------------------------------
-#pragma once
-
-#include <QtCore/QFile>
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
-#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/Filtering/FilterFactory.hpp"
 #include "SIMPLib/Filtering/FilterManager.h"
-#include "SIMPLib/Filtering/FilterPipeline.h"
-#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
-#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
-#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
-
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "UnitTestSupport.hpp"
 
+#include "Processing/ProcessingFilters/FixNonmanifoldVoxels.h"
+
 #include "ProcessingTestFileLocations.h"
 
 class FixNonmanifoldVoxelsTest
 {
 
 public:
-  FixNonmanifoldVoxelsTest()
-  {
-  }
-  virtual ~FixNonmanifoldVoxelsTest()
-  {
-  }
-
-  // -----------------------------------------------------------------------------
-  //
-  // -----------------------------------------------------------------------------
-  void RemoveTestFiles()
-  {
-#if REMOVE_TEST_FILES
-    QFile::remove(UnitTest::FixNonmanifoldVoxelsTest::TestFile1);
-    QFile::remove(UnitTest::FixNonmanifoldVoxelsTest::TestFile2);
-#endif
-  }
+  FixNonmanifoldVoxelsTest() = default;
+  ~FixNonmanifoldVoxelsTest() = default;
 
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
   int TestFilterAvailability()
   {
-    // Now instantiate the FixNonmanifoldVoxelsTest Filter from the FilterManager
+    // Now instantiate the FixNonmanifoldVoxels Filter from the FilterManager
     QString filtName = "FixNonmanifoldVoxels";
     FilterManager* fm = FilterManager::Instance();
     IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
@@ -60,32 +74,111 @@ public:
   }
 
   // -----------------------------------------------------------------------------
-  //
+  // Runs the filter on Feature Ids given as one picture per Z plane, with rows along Y, and checks the number of
+  // non-manifold vertices it reports. Only the vertices shared by a full 2 x 2 x 2 block of voxels are classified.
   // -----------------------------------------------------------------------------
-  int TestFixNonmanifoldVoxelsTest()
+  void checkCount(const std::vector<std::vector<QString>>& featureIdPlanes, size_t expected)
   {
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-    /* Please write FixNonmanifoldVoxelsTest test code here.
-     *
-     * Your IO test files are:
-     * UnitTest::FixNonmanifoldVoxelsTest::TestFile1
-     * UnitTest::FixNonmanifoldVoxelsTest::TestFile2
-     *
-     * SIMPLib provides some macros that will throw exceptions when a test fails
-     * and thus report that during testing. These macros are located in the
-     * SIMPLib/Utilities/UnitTestSupport.hpp file. Some examples are:
-     *
-     * SIMPLib_REQUIRE_EQUAL(foo, 0)
-     * This means that if the variable foo is NOT equal to Zero then test will fail
-     * and the current test will exit immediately. If there are more tests registered
-     * with the SIMPLib_REGISTER_TEST() macro, the next test will execute. There are
-     * lots of examples in the SIMPLib/Test folder to look at.
-     */
-    //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-
-    int foo = 0;
-    DREAM3D_REQUIRE_EQUAL(foo, 0)
+    const size_t dims[3] = {static_cast<size_t>(featureIdPlanes[0][0].size()), featureIdPlanes[0].size(), featureIdPlanes.size()};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims[0] * dims[1] * dims[2], SIMPL::CellData::FeatureIds, true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, featureIdPlanes[z][y][static_cast<int>(x)].digitValue());
+        }
+      }
+    }
+    cellAM->insertOrAssign(featureIds);
+
+    FixNonmanifoldVoxels::Pointer filter = FixNonmanifoldVoxels::New();
+    filter->setDataContainerArray(dca);
+    filter->setFeatureIdsArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(filter->getNonmanifoldVertexCount(), expected)
+  }
 
+  // -----------------------------------------------------------------------------
+  // A Feature that touches itself only across the diagonal of one face of the block, in each of the three face
+  // orientations. The last block holds the diagonal pair of two opposite edges, which is a face diagonal of the side
+  // face between them.
+  // -----------------------------------------------------------------------------
+  int TestFaceDiagonal()
+  {
+    checkCount({{"10", "01"}, {"00", "00"}}, 1);
+    checkCount({{"10", "00"}, {"01", "00"}}, 1);
+    checkCount({{"10", "00"}, {"00", "10"}}, 1);
+    checkCount({{"11", "00"}, {"00", "11"}}, 1);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A Feature at two opposite corners of the block touches itself only at the vertex
+  // -----------------------------------------------------------------------------
+  int TestAntipodalCorners()
+  {
+    checkCount({{"10", "00"}, {"00", "01"}}, 1);
+    checkCount({{"01", "00"}, {"00", "10"}}, 1);
+    checkCount({{"00", "10"}, {"01", "00"}}, 1);
+    checkCount({{"00", "01"}, {"10", "00"}}, 1);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The same configurations with the pair split between two other Features, so only the Feature holding the rest of
+  // the block, the complement of the pair, shows them
+  // -----------------------------------------------------------------------------
+  int TestComplements()
+  {
+    checkCount({{"21", "13"}, {"11", "11"}}, 1);
+    checkCount({{"21", "11"}, {"13", "11"}}, 1);
+    checkCount({{"21", "11"}, {"11", "13"}}, 1);
+    checkCount({{"12", "11"}, {"11", "31"}}, 1);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Blocks where every Feature is face connected within the block
+  // -----------------------------------------------------------------------------
+  int TestManifold()
+  {
+    checkCount({{"00", "00"}, {"00", "00"}}, 0);
+    checkCount({{"10", "00"}, {"00", "00"}}, 0);
+    checkCount({{"11", "00"}, {"00", "00"}}, 0);
+    checkCount({{"11", "10"}, {"00", "00"}}, 0);
+    checkCount({{"11", "11"}, {"00", "00"}}, 0);
+    checkCount({{"12", "30"}, {"45", "67"}}, 0);
+    checkCount({{"11", "10"}, {"10", "00"}}, 0);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Larger volumes with several vertex planes. Border vertices are never counted.
+  // -----------------------------------------------------------------------------
+  int TestAcrossZPlanes()
+  {
+    // A diagonal line of voxels touches itself at one vertex in each of the two inner vertex planes
+    checkCount({{"100", "000", "000"}, {"000", "010", "000"}, {"000", "000", "001"}}, 2);
+    // A staircase in the XZ plane has one face diagonal per step, one step per vertex plane
+    checkCount({{"1000", "1000"}, {"0100", "0100"}, {"0010", "0010"}, {"0001", "0001"}}, 3);
+    // Every inner vertex of a 3D checkerboard is non-manifold
+    checkCount({{"010", "101", "010"}, {"101", "010", "101"}, {"010", "101", "010"}}, 8);
+    // A single slice has no full block, so its face diagonals are not counted
+    checkCount({{"10", "01"}}, 0);
     return EXIT_SUCCESS;
   }
 
@@ -96,14 +189,20 @@ public:
   {
     int err = EXIT_SUCCESS;
 
-    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+    std::cout << "#### FixNonmanifoldVoxelsTest Starting ####" << std::endl;
 
-    DREAM3D_REGISTER_TEST(TestFixNonmanifoldVoxelsTest())
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
-    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+    DREAM3D_REGISTER_TEST(TestFaceDiagonal())
+    DREAM3D_REGISTER_TEST(TestAntipodalCorners())
+    DREAM3D_REGISTER_TEST(TestComplements())
+    DREAM3D_REGISTER_TEST(TestManifold())
+    DREAM3D_REGISTER_TEST(TestAcrossZPlanes())
   }
 
-private:
-  FixNonmanifoldVoxelsTest(const FixNonmanifoldVoxelsTest&); // Copy Constructor Not Implemented
-  void operator=(const FixNonmanifoldVoxelsTest&);           // Operator '=' Not Implemented
+public:
+  FixNonmanifoldVoxelsTest(const FixNonmanifoldVoxelsTest&) = delete;            // Copy Constructor Not Implemented
+  FixNonmanifoldVoxelsTest(FixNonmanifoldVoxelsTest&&) = delete;                 // Move Constructor Not Implemented
+  FixNonmanifoldVoxelsTest& operator=(const FixNonmanifoldVoxelsTest&) = delete; // Copy Assignment Not Implemented
+  FixNonmanifoldVoxelsTest& operator=(FixNonmanifoldVoxelsTest&&) = delete;      // Move Assignment Not Implemented
 };
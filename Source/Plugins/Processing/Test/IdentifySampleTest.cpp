@@ -0,0 +1,196 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "UnitTestSupport.hpp"
+
+#include "ProcessingTestFileLocations.h"
+
+class IdentifySampleTest
+{
+
+public:
+  IdentifySampleTest() = default;
+  ~IdentifySampleTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the IdentifySample Filter from the FilterManager
+    QString filtName = "IdentifySample";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The Processing Requires the use of the " << filtName.toStdString() << " filter which is found in the Processing Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on a mask given as one picture per Z plane, with rows along Y and '1' for a good voxel, and
+  // compares every voxel with the expected pictures
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void checkMask(const std::vector<std::vector<QString>>& input, const std::vector<std::vector<QString>>& expected, bool fillHoles)
+  {
+    const size_t dims[3] = {static_cast<size_t>(input[0][0].size()), input[0].size(), input.size()};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    typename DataArray<T>::Pointer maskArray = DataArray<T>::CreateArray(dims[0] * dims[1] * dims[2], SIMPL::CellData::Mask, true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          maskArray->setValue((z * dims[1] + y) * dims[0] + x, static_cast<T>(input[z][y][static_cast<int>(x)] == '1'));
+        }
+      }
+    }
+    cellAM->insertOrAssign(maskArray);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("IdentifySample")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask));
+    DREAM3D_REQUIRE(filter->setProperty("GoodVoxelsArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("FillHoles", fillHoles))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          bool good = static_cast<bool>(maskArray->getValue((z * dims[1] + y) * dims[0] + x));
+          DREAM3D_REQUIRE_EQUAL(good, expected[z][y][static_cast<int>(x)] == '1')
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // A sample next to a smaller component, with a hole in the Z = 0 boundary plane, a channel that opens to the X = 0
+  // face and two holes in the middle plane that are closed on all six sides
+  // -----------------------------------------------------------------------------
+  int TestSampleAndHoles()
+  {
+    const std::vector<std::vector<QString>> input = {
+        {"111111..", "111111..", "111.11.1", "111111.1", "111111..", "........"},
+        {"111111..", "111.11..", "..1111..", "1111.1..", "111111..", "........"},
+        {"111111..", "111111..", "111111..", "111111..", "111111..", "........"},
+    };
+    const std::vector<std::vector<QString>> sample = {
+        {"111111..", "111111..", "111.11..", "111111..", "111111..", "........"},
+        {"111111..", "111.11..", "..1111..", "1111.1..", "111111..", "........"},
+        {"111111..", "111111..", "111111..", "111111..", "111111..", "........"},
+    };
+    const std::vector<std::vector<QString>> filled = {
+        {"111111..", "111111..", "111.11..", "111111..", "111111..", "........"},
+        {"111111..", "111111..", "..1111..", "111111..", "111111..", "........"},
+        {"111111..", "111111..", "111111..", "111111..", "111111..", "........"},
+    };
+
+    checkMask<bool>(input, sample, false);
+    checkMask<bool>(input, filled, true);
+    checkMask<uint8_t>(input, sample, false);
+    checkMask<uint8_t>(input, filled, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two components of three voxels tie for the largest. The one whose first voxel comes last in voxel order is kept.
+  // Every voxel of a single plane volume touches the boundary, so nothing in it is a hole.
+  // -----------------------------------------------------------------------------
+  int TestLargestComponentTie()
+  {
+    const std::vector<std::vector<QString>> input = {
+        {"1..11..", "1...1..", "1.....1"},
+    };
+    const std::vector<std::vector<QString>> sample = {
+        {"...11..", "....1..", "......."},
+    };
+
+    checkMask<bool>(input, sample, false);
+    checkMask<bool>(input, sample, true);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### IdentifySampleTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestSampleAndHoles());
+    DREAM3D_REGISTER_TEST(TestLargestComponentTie());
+  }
+
+public:
+  IdentifySampleTest(const IdentifySampleTest&) = delete;            // Copy Constructor Not Implemented
+  IdentifySampleTest(IdentifySampleTest&&) = delete;                 // Move Constructor Not Implemented
+  IdentifySampleTest& operator=(const IdentifySampleTest&) = delete; // Copy Assignment Not Implemented
+  IdentifySampleTest& operator=(IdentifySampleTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,184 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "UnitTestSupport.hpp"
+
+#include "Processing/ProcessingFilters/HelperClasses/MajorityNeighborFill.h"
+
+#include "ProcessingTestFileLocations.h"
+
+class MajorityNeighborFillTest
+{
+
+public:
+  MajorityNeighborFillTest() = default;
+  ~MajorityNeighborFillTest() = default;
+
+  // -----------------------------------------------------------------------------
+  // Fills the Feature Ids given as one picture per Z plane, with rows along Y, digits for Feature Ids and '.' for bad
+  // cells, and compares every cell with the expected pictures. A second cell array holds 1.5 times each good Feature
+  // Id, so it shows that every filled cell took its whole tuple from a cell of the chosen Feature.
+  // -----------------------------------------------------------------------------
+  void checkFill(const std::vector<std::vector<QString>>& input, int32_t minSourceFeatureId, const std::vector<std::vector<QString>>& expected)
+  {
+    const int64_t dims[3] = {static_cast<int64_t>(input[0][0].size()), static_cast<int64_t>(input[0].size()), static_cast<int64_t>(input.size())};
+    const size_t totalPoints = static_cast<size_t>(dims[0] * dims[1] * dims[2]);
+    const float k_BadData = -7.0f;
+
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::FeatureIds, true);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(totalPoints, QString("Data"), true);
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = static_cast<size_t>((z * dims[1] + y) * dims[0] + x);
+          QChar cell = input[z][y][static_cast<int>(x)];
+          int32_t featureId = (cell == '.') ? -1 : cell.digitValue();
+          featureIds->setValue(index, featureId);
+          data->setValue(index, (featureId < 0) ? k_BadData : 1.5f * static_cast<float>(featureId));
+        }
+      }
+    }
+
+    AbstractFilter::Pointer filter = AbstractFilter::New();
+    MajorityNeighborFill neighborFill(filter.get(), dims, featureIds->getPointer(0), minSourceFeatureId);
+    neighborFill.execute({featureIds, data});
+
+    for(int64_t z = 0; z < dims[2]; z++)
+    {
+      for(int64_t y = 0; y < dims[1]; y++)
+      {
+        for(int64_t x = 0; x < dims[0]; x++)
+        {
+          size_t index = static_cast<size_t>((z * dims[1] + y) * dims[0] + x);
+          QChar cell = expected[z][y][static_cast<int>(x)];
+          int32_t featureId = (cell == '.') ? -1 : cell.digitValue();
+          DREAM3D_REQUIRE_EQUAL(featureIds->getValue(index), featureId)
+          DREAM3D_REQUIRE_EQUAL(data->getValue(index), (featureId < 0) ? k_BadData : 1.5f * static_cast<float>(featureId))
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // The neighbors are walked in the order -Z, -Y, -X, +X, +Y, +Z. On a tie the Feature that reaches the count first
+  // wins, which is not always the Feature seen first.
+  // -----------------------------------------------------------------------------
+  int TestMajorityTies()
+  {
+    checkFill({{"323", "1.1", "323"}}, 0, {{"323", "111", "323"}});
+    checkFill({{"040", "1.2", "030"}}, 1, {{"040", "142", "030"}});
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A 3 x 3 x 3 hole inside a 5 x 5 x 5 volume of three Features is filled from the outside in over two passes. Each
+  // pass only sees the Feature Ids left by the pass before it.
+  // -----------------------------------------------------------------------------
+  int TestDeepHole()
+  {
+    std::vector<std::vector<QString>> input;
+    std::vector<std::vector<QString>> expected;
+    for(int z = 0; z < 5; z++)
+    {
+      std::vector<QString> plane;
+      for(int y = 0; y < 5; y++)
+      {
+        QString row;
+        for(int x = 0; x < 5; x++)
+        {
+          bool inside = x > 0 && x < 4 && y > 0 && y < 4 && z > 0 && z < 4;
+          int32_t featureId = (x < 2) ? 1 : (y < 3 ? 2 : 3);
+          row.append(inside ? QChar('.') : QChar('0' + featureId));
+        }
+        plane.push_back(row);
+      }
+      input.push_back(plane);
+      expected.push_back({"11222", "11222", "11222", "11333", "11333"});
+    }
+
+    checkFill(input, 1, expected);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // MinSize, MinNeighbors and RemoveFlaggedFeatures fill from Feature 0 as well, FillBadData only from Features 1 and up
+  // -----------------------------------------------------------------------------
+  int TestMinSourceFeatureId()
+  {
+    checkFill({{"00000", "0...0", "0.1.0", "00000"}}, 0, {{"00000", "00000", "00100", "00000"}});
+    checkFill({{"00000", "0...0", "0.1.0", "00000"}}, 1, {{"00000", "01110", "01110", "00000"}});
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Bad cells that never touch a usable source are left bad, and the fill still stops
+  // -----------------------------------------------------------------------------
+  int TestNoSource()
+  {
+    checkFill({{"000000", "0..000", "0..011", "0000.1"}}, 1, {{"000000", "0..000", "0..011", "000011"}});
+    checkFill({{"000000", "0..000", "0..011", "0000.1"}}, 0, {{"000000", "000000", "000011", "000011"}});
+    checkFill({{"...", "..."}, {"...", "..."}}, 0, {{"...", "..."}, {"...", "..."}});
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    std::cout << "#### MajorityNeighborFillTest Starting ####" << std::endl;
+
+    DREAM3D_REGISTER_TEST(TestMajorityTies());
+    DREAM3D_REGISTER_TEST(TestDeepHole());
+    DREAM3D_REGISTER_TEST(TestMinSourceFeatureId());
+    DREAM3D_REGISTER_TEST(TestNoSource());
+  }
+
+public:
+  MajorityNeighborFillTest(const MajorityNeighborFillTest&) = delete;            // Copy Constructor Not Implemented
+  MajorityNeighborFillTest(MajorityNeighborFillTest&&) = delete;                 // Move Constructor Not Implemented
+  MajorityNeighborFillTest& operator=(const MajorityNeighborFillTest&) = delete; // Copy Assignment Not Implemented
+  MajorityNeighborFillTest& operator=(MajorityNeighborFillTest&&) = delete;      // Move Assignment Not Implemented
+};
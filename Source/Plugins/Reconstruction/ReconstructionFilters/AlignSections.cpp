@@ -34,6 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSections.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -46,33 +49,49 @@
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-
-#include <tbb/blocked_range.h>
-#include <tbb/parallel_for.h>
-#include <tbb/task_group.h>
-#include <tbb/tick_count.h>
-#endif
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
+/**
+ * @brief transferSliceData Shifts one slice of a cell array in place so that the cell at (x, y) takes the value of the
+ * cell at (x + xshift, y + yshift). Each row is moved as one contiguous block, and the rows are visited in the order
+ * that never reads a row after it has been overwritten. Cells whose source lies outside the slice are zeroed.
+ */
 template <typename T>
-void initializeArrayValues(IDataArray::Pointer p, size_t index)
+void transferSliceData(IDataArray::Pointer p, const size_t* dims, size_t slice, int64_t xshift, int64_t yshift)
 {
-
   typename DataArray<T>::Pointer ptr = std::dynamic_pointer_cast<DataArray<T>>(p);
-  T var = static_cast<T>(0);
-  ptr->initializeTuple(index, &var);
+  const int64_t xDim = static_cast<int64_t>(dims[0]);
+  const int64_t yDim = static_cast<int64_t>(dims[1]);
+  const size_t numComps = ptr->getNumberOfComponents();
+  const size_t rowSize = static_cast<size_t>(xDim) * numComps;
+  T* sliceData = ptr->getPointer(slice * dims[0] * dims[1] * numComps);
+
+  // Only the cells in [xStart, xEnd) of a row have a source inside the slice
+  const int64_t xStart = std::max<int64_t>(0, -xshift);
+  const int64_t xEnd = std::min<int64_t>(xDim, xDim - xshift);
+  for(int64_t l = 0; l < yDim; l++)
+  {
+    int64_t yspot = (yshift >= 0) ? l : yDim - 1 - l;
+    T* row = sliceData + static_cast<size_t>(yspot) * rowSize;
+    if((yspot + yshift) < 0 || (yspot + yshift) > yDim - 1 || xStart >= xEnd)
+    {
+      std::fill(row, row + rowSize, static_cast<T>(0));
+      continue;
+    }
+    const T* source = sliceData + static_cast<size_t>(yspot + yshift) * rowSize + static_cast<size_t>(xStart + xshift) * numComps;
+    std::memmove(row + xStart * numComps, source, static_cast<size_t>(xEnd - xStart) * numComps * sizeof(T));
+    std::fill(row, row + xStart * numComps, static_cast<T>(0));
+    std::fill(row + xEnd * numComps, row + rowSize, static_cast<T>(0));
+  }
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
+/**
+ * @brief The AlignSectionsTransferDataImpl class applies the shifts to the cell arrays. The range runs over every
+ * (array, slice) pair so the work is spread over both the arrays and the slices of each array.
+ */
 class AlignSectionsTransferDataImpl
 {
 public:
@@ -80,12 +99,13 @@ public:
   AlignSectionsTransferDataImpl(const AlignSectionsTransferDataImpl&) = default; // Copy Constructor Default Implemented
   AlignSectionsTransferDataImpl(AlignSectionsTransferDataImpl&&) = default;      // Move Constructor Default Implemented
 
-  AlignSectionsTransferDataImpl(AlignSections* filter, size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts, IDataArray::Pointer dataArrayPtr)
+  AlignSectionsTransferDataImpl(AlignSections* filter, const size_t* dims, const std::vector<int64_t>& xshifts, const std::vector<int64_t>& yshifts,
+                                const std::vector<IDataArray::Pointer>& dataArrays)
   : m_Filter(filter)
   , m_Dims(dims)
   , m_xshifts(xshifts)
   , m_yshifts(yshifts)
-  , m_DataArrayPtr(dataArrayPtr)
+  , m_DataArrays(dataArrays)
   {
   }
 
@@ -94,69 +114,33 @@ public:
   AlignSectionsTransferDataImpl& operator=(const AlignSectionsTransferDataImpl&) = delete; // Copy Assignment Not Implemented
   AlignSectionsTransferDataImpl& operator=(AlignSectionsTransferDataImpl&&) = delete;      // Move Assignment Not Implemented
 
-  void operator()() const
+  void operator()(const SIMPLRange& range) const
   {
-    size_t progIncrement = m_Dims[2] / 50;
-    size_t prog = 1;
-    size_t slice = 0;
-
-    for(size_t i = 1; i < m_Dims[2]; i++)
+    size_t slicesPerArray = m_Dims[2] - 1;
+    for(size_t index = range.min(); index < range.max(); index++)
     {
-      if(i > prog)
-      {
-        prog = prog + progIncrement;
-        m_Filter->updateProgress(progIncrement);
-      }
       if(m_Filter->getCancel())
       {
         return;
       }
-      slice = (m_Dims[2] - 1) - i;
-      for(size_t l = 0; l < m_Dims[1]; l++)
+      size_t i = 1 + index % slicesPerArray;
+      if(m_xshifts[i] == 0 && m_yshifts[i] == 0)
       {
-        for(size_t n = 0; n < m_Dims[0]; n++)
-        {
-          int64_t xspot = 0, yspot = 0;
-          int64_t newPosition = 0;
-          int64_t currentPosition = 0;
-          if(m_yshifts[i] >= 0)
-          {
-            yspot = static_cast<int64_t>(l);
-          }
-          else if(m_yshifts[i] < 0)
-          {
-            yspot = static_cast<int64_t>(m_Dims[1]) - 1 - static_cast<int64_t>(l);
-          }
-          if(m_xshifts[i] >= 0)
-          {
-            xspot = static_cast<int64_t>(n);
-          }
-          else if(m_xshifts[i] < 0)
-          {
-            xspot = static_cast<int64_t>(m_Dims[0]) - 1 - static_cast<int64_t>(n);
-          }
-          newPosition = (slice * m_Dims[0] * m_Dims[1]) + (yspot * m_Dims[0]) + xspot;
-          currentPosition = (slice * m_Dims[0] * m_Dims[1]) + ((yspot + m_yshifts[i]) * m_Dims[0]) + (xspot + m_xshifts[i]);
-          if((yspot + m_yshifts[i]) >= 0 && (yspot + m_yshifts[i]) <= static_cast<int64_t>(m_Dims[1]) - 1 && (xspot + m_xshifts[i]) >= 0 &&
-             (xspot + m_xshifts[i]) <= static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            m_DataArrayPtr->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-          if((yspot + m_yshifts[i]) < 0 || (yspot + m_yshifts[i]) > static_cast<int64_t>(m_Dims[1] - 1) || (xspot + m_xshifts[i]) < 0 || (xspot + m_xshifts[i]) > static_cast<int64_t>(m_Dims[0]) - 1)
-          {
-            EXECUTE_FUNCTION_TEMPLATE(m_Filter, initializeArrayValues, m_DataArrayPtr, m_DataArrayPtr, newPosition)
-          }
-        }
+        continue;
       }
+      size_t slice = (m_Dims[2] - 1) - i;
+      const IDataArray::Pointer& dataArrayPtr = m_DataArrays[index / slicesPerArray];
+      EXECUTE_FUNCTION_TEMPLATE(m_Filter, transferSliceData, dataArrayPtr, dataArrayPtr, m_Dims, slice, m_xshifts[i], m_yshifts[i])
     }
+    m_Filter->updateProgress(range.max() - range.min());
   }
 
 private:
   AlignSections* m_Filter = nullptr;
-  size_t* m_Dims = nullptr;
-  std::vector<int64_t> m_xshifts;
-  std::vector<int64_t> m_yshifts;
-  IDataArray::Pointer m_DataArrayPtr;
+  const size_t* m_Dims = nullptr;
+  const std::vector<int64_t>& m_xshifts;
+  const std::vector<int64_t>& m_yshifts;
+  const std::vector<IDataArray::Pointer>& m_DataArrays;
 };
 
 // -----------------------------------------------------------------------------
@@ -237,11 +221,28 @@ void AlignSections::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64
 {
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t AlignSections::ComputePyramidLevels(int64_t xDim, int64_t yDim)
+{
+  // Stop coarsening before a section gets too small to hold a meaningful set of samples
+  const int32_t maxLevels = 5;
+  const int64_t minDim = 32;
+  int32_t levels = 0;
+  while(levels < maxLevels && (std::min(xDim, yDim) >> (levels + 1)) >= minDim)
+  {
+    levels++;
+  }
+  return levels;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void AlignSections::updateProgress(size_t p)
 {
+  std::lock_guard<std::mutex> lock(m_ProgressMutex);
   m_Progress += p;
   int32_t progressInt = static_cast<int>((static_cast<float>(m_Progress) / static_cast<float>(m_TotalProgress)) * 100.0f);
   QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
@@ -273,93 +274,32 @@ void AlignSections::execute()
 
   find_shifts(xshifts, yshifts);
 
-#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
-  // The idea for this parallel section is to parallelize over each Data Array that
-  // will need it's data adjusted. This should go faster than before by about 2x.
-  // Better speed up could be achieved if we had better data locality.
+  if(getCancel())
+  {
+    return;
+  }
 
-  std::shared_ptr<tbb::task_group> taskGroup(new tbb::task_group);
   QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
   for(const auto& dataArrayPath : m_IgnoredDataArrayPaths)
   {
     voxelArrayNames.removeAll(dataArrayPath.getDataArrayName());
   }
-  m_TotalProgress = voxelArrayNames.size() * dims[2]; // Total number of slices to update
-  // Create all the tasks
+  std::vector<IDataArray::Pointer> dataArrays;
+  dataArrays.reserve(voxelArrayNames.size());
   for(const auto& arrayName : voxelArrayNames)
   {
-    IDataArray::Pointer dataArrayPtr = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-    taskGroup->run(AlignSectionsTransferDataImpl(this, dims.data(), xshifts, yshifts, dataArrayPtr));
+    dataArrays.push_back(m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName));
   }
-  // Wait for them to complete.
-  taskGroup->wait();
-#else
-
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
-  size_t progIncrement = dims[2] / 100;
-  size_t prog = 1;
-  size_t progressInt = 0;
-  size_t slice = 0;
-
-  for(size_t i = 1; i < dims[2]; i++)
+  if(dims[2] < 2 || dataArrays.empty())
   {
-    if(i > prog)
-    {
-      progressInt = static_cast<int>((static_cast<float>(i) / static_cast<float>(dims[2])) * 100.0f);
-      QString ss = QObject::tr("Transferring Cell Data %1%").arg(progressInt);
-      notifyStatusMessage(ss);
-      prog = prog + progIncrement;
-    }
-    if(getCancel())
-    {
-      return;
-    }
-    slice = (dims[2] - 1) - i;
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
-      {
-        int64_t xspot = 0, yspot = 0;
-        int64_t newPosition = 0;
-        int64_t currentPosition = 0;
-        if(yshifts[i] >= 0)
-        {
-          yspot = static_cast<int64_t>(l);
-        }
-        else if(yshifts[i] < 0)
-        {
-          yspot = static_cast<int64_t>(dims[1]) - 1 - static_cast<int64_t>(l);
-        }
-        if(xshifts[i] >= 0)
-        {
-          xspot = static_cast<int64_t>(n);
-        }
-        else if(xshifts[i] < 0)
-        {
-          xspot = static_cast<int64_t>(dims[0]) - 1 - static_cast<int64_t>(n);
-        }
-        newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-        currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-        if((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= static_cast<int64_t>(dims[1]) - 1 && (xspot + xshifts[i]) >= 0 && (xspot + xshifts[i]) <= static_cast<int64_t>(dims[0]) - 1)
-        {
-          for(const auto& arrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-            p->copyTuple(static_cast<size_t>(currentPosition), static_cast<size_t>(newPosition));
-          }
-        }
-        if((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > static_cast<int64_t>(dims[1] - 1) || (xspot + xshifts[i]) < 0 || (xspot + xshifts[i]) > static_cast<int64_t>(dims[0]) - 1)
-        {
-          for(const auto& arrayName : voxelArrayNames)
-          {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(arrayName);
-            EXECUTE_FUNCTION_TEMPLATE(this, initializeArrayValues, p, p, newPosition)
-          }
-        }
-      }
-    }
+    return;
   }
-#endif
+
+  // Every slice of every array is shifted independently of the others
+  m_TotalProgress = dataArrays.size() * (dims[2] - 1); // Total number of slices to update
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, m_TotalProgress);
+  dataAlg.execute(AlignSectionsTransferDataImpl(this, dims.data(), xshifts, yshifts, dataArrays));
 }
 
 // -----------------------------------------------------------------------------
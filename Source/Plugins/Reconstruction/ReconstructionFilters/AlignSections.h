@@ -36,6 +36,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/Constants.h"
@@ -228,6 +229,15 @@ protected:
    */
   virtual void find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts);
 
+  /**
+   * @brief ComputePyramidLevels Determines how many coarse levels a multi-resolution shift search uses for
+   * sections of the given size. Each level halves the resolution of the level below it.
+   * @param xDim Number of cells along x in a section
+   * @param yDim Number of cells along y in a section
+   * @return Number of levels above the full resolution section
+   */
+  static int32_t ComputePyramidLevels(int64_t xDim, int64_t yDim);
+
 private:
   DataArrayPath m_DataContainerName = {SIMPL::Defaults::ImageDataContainerName, "", ""};
   QString m_CellAttributeMatrixName = {SIMPL::Defaults::CellAttributeMatrixName};
@@ -237,6 +247,7 @@ private:
 
   size_t m_Progress = 0;
   size_t m_TotalProgress = 0;
+  std::mutex m_ProgressMutex;
 
 public:
   AlignSections(const AlignSections&) = delete;            // Copy Constructor Not Implemented
@@ -34,6 +34,7 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsFeature.h"
 
+#include <algorithm>
 #include <fstream>
 
 #include <QtCore/QTextStream>
@@ -45,10 +46,105 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsFeatureShiftsImpl class finds the shift between each slice and the slice above it by hill
+ * climbing over the fraction of voxels whose mask value differs. Each slice pair is independent of the others.
+ */
+class AlignSectionsFeatureShiftsImpl
+{
+public:
+  AlignSectionsFeatureShiftsImpl(AlignSectionsFeature* filter, const int64_t* dims, const bool* goodVoxels, std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_GoodVoxels(goodVoxels)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+
+  void findShifts(int64_t start, int64_t end) const
+  {
+    const int64_t* dims = m_Dims;
+    std::vector<float> misorients(static_cast<size_t>(dims[0] * dims[1]), 0.0f);
+
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      float mindisorientation = std::numeric_limits<float>::max();
+      int64_t slice = (dims[2] - 1) - iter;
+      int32_t oldxshift = -1;
+      int32_t oldyshift = -1;
+      int32_t newxshift = 0;
+      int32_t newyshift = 0;
+      std::fill(misorients.begin(), misorients.end(), 0.0f);
+
+      while(newxshift != oldxshift || newyshift != oldyshift)
+      {
+        oldxshift = newxshift;
+        oldyshift = newyshift;
+        for(int32_t j = -3; j < 4; j++)
+        {
+          for(int32_t k = -3; k < 4; k++)
+          {
+            float disorientation = 0.0f;
+            float count = 0.0f;
+            int64_t idx = (k + oldxshift + dims[0] / 2) * dims[1] + (j + oldyshift + dims[1] / 2);
+            if(misorients[idx] == 0.0f && abs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
+            {
+              for(int64_t l = 0; l < dims[1]; l = l + 4)
+              {
+                for(int64_t n = 0; n < dims[0]; n = n + 4)
+                {
+                  if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
+                  {
+                    int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+                    int64_t curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
+                    if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+                    {
+                      disorientation++;
+                    }
+                    count++;
+                  }
+                }
+              }
+              disorientation = disorientation / count;
+              misorients[idx] = disorientation;
+              if(disorientation < mindisorientation)
+              {
+                newxshift = k + oldxshift;
+                newyshift = j + oldyshift;
+                mindisorientation = disorientation;
+              }
+            }
+          }
+        }
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    findShifts(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  AlignSectionsFeature* m_Filter = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -131,11 +227,6 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -144,88 +235,33 @@ void AlignSectionsFeature::find_shifts(std::vector<int64_t>& xshifts, std::vecto
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int32_t newxshift = 0;
-  int32_t newyshift = 0;
-  int32_t oldxshift = 0;
-  int32_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-  std::vector<std::vector<float>> misorients(dims[0]);
-
-  for(int64_t a = 0; a < dims[0]; a++)
+  // Every slice pair only reads its own two slices, so all of the relative shifts are found concurrently
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, dims[2]);
+  dataAlg.execute(AlignSectionsFeatureShiftsImpl(this, dims, m_GoodVoxels, newxshifts, newyshifts));
+  if(getCancel())
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
+
+  // The absolute shifts are the prefix sums of the relative shifts
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(((float)iter / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0.0f && abs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
-                  {
-                    disorientation++;
-                  }
-                  count++;
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << std::endl;
     }
   }
   if(getWriteAlignmentShifts())
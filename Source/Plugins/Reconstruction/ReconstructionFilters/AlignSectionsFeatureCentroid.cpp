@@ -48,10 +48,72 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsFeatureCentroidImpl class computes the centroid of the good voxels of a range of sections
+ */
+class AlignSectionsFeatureCentroidImpl
+{
+public:
+  AlignSectionsFeatureCentroidImpl(AlignSectionsFeatureCentroid* filter, const size_t* dims, const float* spacing, const bool* goodVoxels, std::vector<float>& xCentroid, std::vector<float>& yCentroid)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_Spacing(spacing)
+  , m_GoodVoxels(goodVoxels)
+  , m_XCentroid(xCentroid)
+  , m_YCentroid(yCentroid)
+  {
+  }
+
+  void findCentroids(size_t start, size_t end) const
+  {
+    const size_t* dims = m_Dims;
+    for(size_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      size_t count = 0;
+      float xCentroid = 0.0f;
+      float yCentroid = 0.0f;
+      size_t slice = static_cast<size_t>((dims[2] - 1) - iter);
+      for(size_t l = 0; l < dims[1]; l++)
+      {
+        for(size_t n = 0; n < dims[0]; n++)
+        {
+          size_t point = ((slice)*dims[0] * dims[1]) + (l * dims[0]) + n;
+          if(m_GoodVoxels[point])
+          {
+            xCentroid = xCentroid + (static_cast<float>(n) * m_Spacing[0]);
+            yCentroid = yCentroid + (static_cast<float>(l) * m_Spacing[1]);
+            count++;
+          }
+        }
+      }
+      m_XCentroid[iter] = xCentroid / static_cast<float>(count);
+      m_YCentroid[iter] = yCentroid / static_cast<float>(count);
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    findCentroids(range.min(), range.max());
+  }
+
+private:
+  AlignSectionsFeatureCentroid* m_Filter = nullptr;
+  const size_t* m_Dims = nullptr;
+  const float* m_Spacing = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  std::vector<float>& m_XCentroid;
+  std::vector<float>& m_YCentroid;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -167,37 +229,19 @@ void AlignSectionsFeatureCentroid::find_shifts(std::vector<int64_t>& xshifts, st
 
   size_t newxshift = 0;
   size_t newyshift = 0;
-  size_t count = 0;
   size_t slice = 0;
-  size_t point = 0;
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
   std::vector<float> xCentroid(dims[2], 0.0f);
   std::vector<float> yCentroid(dims[2], 0.0f);
 
-  for(size_t iter = 0; iter < dims[2]; iter++)
+  // The centroid of each section only depends on that section, so all of them are computed concurrently
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, dims[2]);
+  dataAlg.execute(AlignSectionsFeatureCentroidImpl(this, dims.data(), spacing.data(), m_GoodVoxels, xCentroid, yCentroid));
+  if(getCancel())
   {
-    count = 0;
-    xCentroid[iter] = 0;
-    yCentroid[iter] = 0;
-
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg((static_cast<double>(iter) / dims[2]) * 100);
-    notifyStatusMessage(ss);
-    slice = static_cast<size_t>((dims[2] - 1) - iter);
-    for(size_t l = 0; l < dims[1]; l++)
-    {
-      for(size_t n = 0; n < dims[0]; n++)
-      {
-        point = ((slice)*dims[0] * dims[1]) + (l * dims[0]) + n;
-        if(m_GoodVoxels[point])
-        {
-          xCentroid[iter] = xCentroid[iter] + (static_cast<float>(n) * spacing[0]);
-          yCentroid[iter] = yCentroid[iter] + (static_cast<float>(l) * spacing[1]);
-          count++;
-        }
-      }
-    }
-    xCentroid[iter] = xCentroid[iter] / static_cast<float>(count);
-    yCentroid[iter] = yCentroid[iter] / static_cast<float>(count);
+    return;
   }
 
   bool xWarning = false;
@@ -35,7 +35,9 @@
 
 #include "AlignSectionsMisorientation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 
 #include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
@@ -44,12 +46,14 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/Core/Quaternion.hpp"
 #include "EbsdLib/LaueOps/LaueOps.h"
@@ -57,6 +61,176 @@
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsMisorientationShiftsImpl class finds the shift between each slice and the slice above it
+ * by hill climbing over the fraction of misoriented voxels. Each slice pair is independent of the others.
+ */
+class AlignSectionsMisorientationShiftsImpl
+{
+public:
+  AlignSectionsMisorientationShiftsImpl(AlignSectionsMisorientation* filter, const int64_t* dims, const float* quats, const int32_t* cellPhases, const bool* goodVoxels,
+                                        const uint32_t* crystalStructures, float misorientationTolerance, int32_t pyramidLevels, std::vector<int64_t>& newxshifts,
+                                        std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_Quats(quats)
+  , m_CellPhases(cellPhases)
+  , m_GoodVoxels(goodVoxels)
+  , m_CrystalStructures(crystalStructures)
+  , m_MisorientationTolerance(misorientationTolerance)
+  , m_PyramidLevels(pyramidLevels)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+
+  void findShifts(int64_t start, int64_t end) const
+  {
+    const int64_t* dims = m_Dims;
+    std::vector<LaueOps::Pointer> orientationOps = LaueOps::GetAllOrientationOps();
+
+    // Allocate a 2D Array which will be reused from slice to slice
+    std::vector<bool> misorients(static_cast<size_t>(dims[0] * dims[1]), false);
+
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t slice = (dims[2] - 1) - iter;
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+
+      // Find the shift on the coarsest level first and refine it on each finer level. The shift carried down from a
+      // coarser level is within one of its cells of the best shift, so a finer level only searches one 7x7 grid.
+      for(int32_t level = m_PyramidLevels; level >= 0; level--)
+      {
+        int32_t maxSteps = (level == m_PyramidLevels) ? std::numeric_limits<int32_t>::max() : 1;
+        climb(orientationOps, slice, static_cast<int64_t>(1) << level, maxSteps, misorients, newxshift, newyshift);
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+    }
+  }
+
+  /**
+   * @brief climb Hill climbs from the given shift over a 7x7 neighborhood of candidate shifts until the best shift
+   * stops moving or maxSteps neighborhoods have been searched. On a coarse level the candidates are spaced by the
+   * level's cell size and only every fourth cell of that level is sampled.
+   */
+  void climb(const std::vector<LaueOps::Pointer>& orientationOps, int64_t slice, int64_t unit, int32_t maxSteps, std::vector<bool>& misorients, int64_t& newxshift, int64_t& newyshift) const
+  {
+    const int64_t* dims = m_Dims;
+    const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
+    const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
+    const int64_t stride = 4 * unit;
+
+    std::fill(misorients.begin(), misorients.end(), false);
+
+    float mindisorientation = std::numeric_limits<float>::max();
+    int64_t oldxshift = newxshift + 1;
+    int64_t oldyshift = newyshift;
+    for(int32_t step = 0; step < maxSteps && (newxshift != oldxshift || newyshift != oldyshift); step++)
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          int64_t xshift = k * unit + oldxshift;
+          int64_t yshift = j * unit + oldyshift;
+          if(llabs(xshift) >= halfDim0 || llabs(yshift) >= halfDim1)
+          {
+            continue;
+          }
+          int64_t idx = (dims[0] * (yshift + halfDim1)) + (xshift + halfDim0);
+          if(misorients[idx])
+          {
+            continue;
+          }
+          float disorientation = 0.0f;
+          float count = 0.0f;
+          for(int64_t l = 0; l < dims[1]; l = l + stride)
+          {
+            for(int64_t n = 0; n < dims[0]; n = n + stride)
+            {
+              if((l + yshift) >= 0 && (l + yshift) < dims[1] && (n + xshift) >= 0 && (n + xshift) < dims[0])
+              {
+                count++;
+                int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+                int64_t curposition = (slice * dims[0] * dims[1]) + ((l + yshift) * dims[0]) + (n + xshift);
+                disorientation += compareVoxels(orientationOps, refposition, curposition);
+              }
+            }
+          }
+          disorientation = disorientation / count;
+          misorients[idx] = true;
+          if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(xshift) < llabs(newxshift)) || (llabs(yshift) < llabs(newyshift)))))
+          {
+            newxshift = xshift;
+            newyshift = yshift;
+            mindisorientation = disorientation;
+          }
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    findShifts(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  AlignSectionsMisorientation* m_Filter = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const float* m_Quats = nullptr;
+  const int32_t* m_CellPhases = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  const uint32_t* m_CrystalStructures = nullptr;
+  float m_MisorientationTolerance = 0.0f;
+  int32_t m_PyramidLevels = 0;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+
+  /**
+   * @brief compareVoxels Returns the penalty a pair of voxels adds to the misorientation count of a trial shift
+   */
+  float compareVoxels(const std::vector<LaueOps::Pointer>& orientationOps, int64_t refposition, int64_t curposition) const
+  {
+    float disorientation = 0.0f;
+    if(m_GoodVoxels == nullptr || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
+    {
+      float w = std::numeric_limits<float>::max();
+      if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
+      {
+        const float* currentQuatPtr = m_Quats + refposition * 4;
+        QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+        uint32_t phase1 = m_CrystalStructures[m_CellPhases[refposition]];
+        currentQuatPtr = m_Quats + curposition * 4;
+        QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
+        uint32_t phase2 = m_CrystalStructures[m_CellPhases[curposition]];
+        if(phase1 == phase2 && phase1 < static_cast<uint32_t>(orientationOps.size()))
+        {
+          OrientationF axisAngle = orientationOps[phase1]->calculateMisorientation(q1, q2);
+          w = axisAngle[3];
+        }
+      }
+      if(w > m_MisorientationTolerance)
+      {
+        disorientation++;
+      }
+    }
+    if(m_GoodVoxels != nullptr && m_GoodVoxels[refposition] != m_GoodVoxels[curposition])
+    {
+      disorientation++;
+    }
+    return disorientation;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -89,6 +263,7 @@ void AlignSectionsMisorientation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance (Degrees)", MisorientationTolerance, FilterParameter::Category::Parameter, AlignSectionsMisorientation));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AlignSectionsMisorientation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Multi-Resolution Search", UseMultiResolutionSearch, FilterParameter::Category::Parameter, AlignSectionsMisorientation));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -122,6 +297,7 @@ void AlignSectionsMisorientation::readFilterParameters(AbstractFilterParametersR
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseMultiResolutionSearch(reader->readValue("UseMultiResolutionSearch", getUseMultiResolutionSearch()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
   setMisorientationTolerance(reader->readValue("MisorientationTolerance", getMisorientationTolerance()));
@@ -208,12 +384,6 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -222,142 +392,35 @@ void AlignSectionsMisorientation::find_shifts(std::vector<int64_t>& xshifts, std
       static_cast<int64_t>(udims[2]),
   };
 
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-  float w = 0.0f;
-
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
-  uint32_t phase1 = 0, phase2 = 0;
-  int64_t progInt = 0;
-
-  // Allocate a 2D Array which will be reused from slice to slice
-  BoolArrayType::Pointer misorientsPtr = BoolArrayType::CreateArray(dims[0] * dims[1], std::string("_INTERNAL_USE_ONLY_Misorients"), true);
-  misorientsPtr->initializeWithValue(false);
-  bool* misorients = misorientsPtr->getPointer(0); // Get the raw pointer to use in our calculations for speed.
-
-  int64_t idx = 0; // This will be used to compute the index into the flat array
-  int64_t xIdx = 0;
-  int64_t yIdx = 0;
+  // Every slice pair only reads its own two slices, so all of the relative shifts are found concurrently
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  int32_t pyramidLevels = m_UseMultiResolutionSearch ? ComputePyramidLevels(dims[0], dims[1]) : 0;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, dims[2]);
+  dataAlg.execute(AlignSectionsMisorientationShiftsImpl(this, dims, m_Quats, m_CellPhases, m_UseGoodVoxels ? m_GoodVoxels : nullptr, m_CrystalStructures,
+                                                        m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D, pyramidLevels, newxshifts, newyshifts));
+  if(getCancel())
+  {
+    return;
+  }
 
-  const int64_t halfDim0 = static_cast<int64_t>(dims[0] * 0.5f);
-  const int64_t halfDim1 = static_cast<int64_t>(dims[1] * 0.5f);
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
 
-  // Loop over the Z Direction
+  // The absolute shifts are the prefix sums of the relative shifts
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    progInt = ((float)iter / dims[2]) * 100.0f;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(progInt);
-    notifyStatusMessage(ss);
-    if(getCancel())
-    {
-      return;
-    }
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-
-    misorientsPtr->initializeWithValue(false); // Initialize everything to false
-
-    float misorientationTolerance = m_MisorientationTolerance * SIMPLib::Constants::k_PiOver180D;
-    float* currentQuatPtr = nullptr;
-
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0.0f;
-          count = 0.0f;
-          xIdx = k + oldxshift + halfDim0;
-          yIdx = j + oldyshift + halfDim1;
-          idx = (dims[0] * yIdx) + xIdx;
-          if(!misorients[idx] && llabs(k + oldxshift) < halfDim0 && llabs(j + oldyshift) < halfDim1)
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  count++;
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  if(!m_UseGoodVoxels || (m_GoodVoxels[refposition] && m_GoodVoxels[curposition]))
-                  {
-                    w = std::numeric_limits<float>::max();
-                    if(m_CellPhases[refposition] > 0 && m_CellPhases[curposition] > 0)
-                    {
-
-                      currentQuatPtr = m_Quats + refposition * 4;
-                      QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase1 = m_CrystalStructures[m_CellPhases[refposition]];
-                      currentQuatPtr = m_Quats + curposition * 4;
-                      QuatF q2(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
-                      phase2 = m_CrystalStructures[m_CellPhases[curposition]];
-                      if(phase1 == phase2 && phase1 < static_cast<uint32_t>(m_OrientationOps.size()))
-                      {
-                        OrientationF axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-                        w = axisAngle[3];
-                      }
-                    }
-                    if(w > misorientationTolerance)
-                    {
-                      disorientation++;
-                    }
-                  }
-                  if(m_UseGoodVoxels)
-                  {
-                    if(m_GoodVoxels[refposition] && !m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                    if(!m_GoodVoxels[refposition] && m_GoodVoxels[curposition])
-                    {
-                      disorientation++;
-                    }
-                  }
-                }
-                else
-                {
-                }
-              }
-            }
-            disorientation = disorientation / count;
-            xIdx = k + oldxshift + halfDim0;
-            yIdx = j + oldyshift + halfDim1;
-            idx = (dims[0] * yIdx) + xIdx;
-            misorients[idx] = true;
-            if(disorientation < mindisorientation || (disorientation == mindisorientation && ((llabs(k + oldxshift) < llabs(newxshift)) || (llabs(j + oldyshift) < llabs(newyshift)))))
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
   }
   if(getWriteAlignmentShifts())
@@ -507,6 +570,18 @@ bool AlignSectionsMisorientation::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void AlignSectionsMisorientation::setUseMultiResolutionSearch(bool value)
+{
+  m_UseMultiResolutionSearch = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AlignSectionsMisorientation::getUseMultiResolutionSearch() const
+{
+  return m_UseMultiResolutionSearch;
+}
+
 // -----------------------------------------------------------------------------
 void AlignSectionsMisorientation::setQuatsArrayPath(const DataArrayPath& value)
 {
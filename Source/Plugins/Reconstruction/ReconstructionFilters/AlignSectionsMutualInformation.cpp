@@ -34,7 +34,9 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "AlignSectionsMutualInformation.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
 
 #include <QtCore/QTextStream>
 
@@ -42,6 +44,7 @@
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
@@ -49,12 +52,192 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "EbsdLib/LaueOps/LaueOps.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The AlignSectionsMutualInformationShiftsImpl class finds the shift between each slice and the slice above
+ * it by hill climbing over the mutual information of the per section Feature Ids. Each slice pair is independent of
+ * the others.
+ */
+class AlignSectionsMutualInformationShiftsImpl
+{
+public:
+  AlignSectionsMutualInformationShiftsImpl(AlignSectionsMutualInformation* filter, const int64_t* dims, const int32_t* miFeatureIds, const int32_t* featureCounts, int32_t pyramidLevels,
+                                           std::vector<int64_t>& newxshifts, std::vector<int64_t>& newyshifts)
+  : m_Filter(filter)
+  , m_Dims(dims)
+  , m_MIFeatureIds(miFeatureIds)
+  , m_FeatureCounts(featureCounts)
+  , m_PyramidLevels(pyramidLevels)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+
+  void findShifts(int64_t start, int64_t end) const
+  {
+    const int64_t* dims = m_Dims;
+    std::vector<float> misorients(static_cast<size_t>(dims[0] * dims[1]), 0.0f);
+    std::vector<uint64_t> jointPairs;
+    std::vector<float> mutualinfo1;
+    std::vector<float> mutualinfo2;
+
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t slice = (dims[2] - 1) - iter;
+      int32_t featurecount1 = m_FeatureCounts[slice];
+      int32_t featurecount2 = m_FeatureCounts[slice + 1];
+      mutualinfo1.assign(featurecount1, 0.0f);
+      mutualinfo2.assign(featurecount2, 0.0f);
+
+      int64_t newxshift = 0;
+      int64_t newyshift = 0;
+
+      // Find the shift on the coarsest level first and refine it on each finer level. The shift carried down from a
+      // coarser level is within one of its cells of the best shift, so a finer level only searches one 7x7 grid.
+      for(int32_t level = m_PyramidLevels; level >= 0; level--)
+      {
+        int32_t maxSteps = (level == m_PyramidLevels) ? std::numeric_limits<int32_t>::max() : 1;
+        climb(slice, static_cast<int64_t>(1) << level, maxSteps, misorients, jointPairs, mutualinfo1, mutualinfo2, newxshift, newyshift);
+      }
+      m_NewXShifts[iter] = newxshift;
+      m_NewYShifts[iter] = newyshift;
+    }
+  }
+
+  /**
+   * @brief climb Hill climbs from the given shift over a 7x7 neighborhood of candidate shifts until the best shift
+   * stops moving or maxSteps neighborhoods have been searched. On a coarse level the candidates are spaced by the
+   * level's cell size and only every fourth cell of that level is sampled.
+   *
+   * The joint histogram is kept as a list of observed (cur, ref) Feature pairs that is sorted and run length counted,
+   * so the cost of each candidate follows the number of sampled cells rather than the product of the Feature counts.
+   * The marginal histograms are dense but only the bins touched by a candidate are cleared afterwards.
+   */
+  void climb(int64_t slice, int64_t unit, int32_t maxSteps, std::vector<float>& misorients, std::vector<uint64_t>& jointPairs, std::vector<float>& mutualinfo1, std::vector<float>& mutualinfo2, int64_t& newxshift,
+             int64_t& newyshift) const
+  {
+    const int64_t* dims = m_Dims;
+    const int64_t stride = 4 * unit;
+
+    std::fill(misorients.begin(), misorients.end(), 0.0f);
+
+    float mindisorientation = std::numeric_limits<float>::max();
+    int64_t oldxshift = newxshift + 1;
+    int64_t oldyshift = newyshift;
+    for(int32_t step = 0; step < maxSteps && (newxshift != oldxshift || newyshift != oldyshift); step++)
+    {
+      oldxshift = newxshift;
+      oldyshift = newyshift;
+      for(int32_t j = -3; j < 4; j++)
+      {
+        for(int32_t k = -3; k < 4; k++)
+        {
+          int64_t xshift = k * unit + oldxshift;
+          int64_t yshift = j * unit + oldyshift;
+          if(llabs(xshift) >= (dims[0] / 2) || yshift >= (dims[1] / 2) || yshift < -(dims[1] / 2))
+          {
+            continue;
+          }
+          int64_t idx = (xshift + dims[0] / 2) * dims[1] + (yshift + dims[1] / 2);
+          if(misorients[idx] != 0)
+          {
+            continue;
+          }
+          float count = 0.0f;
+          jointPairs.clear();
+          for(int64_t l = 0; l < dims[1]; l = l + stride)
+          {
+            for(int64_t n = 0; n < dims[0]; n = n + stride)
+            {
+              if((l + yshift) >= 0 && (l + yshift) < dims[1] && (n + xshift) >= 0 && (n + xshift) < dims[0])
+              {
+                int64_t refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
+                int64_t curposition = (slice * dims[0] * dims[1]) + ((l + yshift) * dims[0]) + (n + xshift);
+                int32_t refgnum = m_MIFeatureIds[refposition];
+                int32_t curgnum = m_MIFeatureIds[curposition];
+                if(curgnum >= 0 && refgnum >= 0)
+                {
+                  jointPairs.push_back(JointPairKey(curgnum, refgnum));
+                  mutualinfo1[curgnum]++;
+                  mutualinfo2[refgnum]++;
+                  count++;
+                }
+              }
+              else
+              {
+                jointPairs.push_back(JointPairKey(0, 0));
+                mutualinfo1[0]++;
+                mutualinfo2[0]++;
+              }
+            }
+          }
+
+          // Only observed pairs contribute to the mutual information, so walk the runs of equal pairs
+          std::sort(jointPairs.begin(), jointPairs.end());
+          float disorientation = 0.0f;
+          size_t p = 0;
+          while(p < jointPairs.size())
+          {
+            size_t q = p + 1;
+            while(q < jointPairs.size() && jointPairs[q] == jointPairs[p])
+            {
+              q++;
+            }
+            size_t b = static_cast<size_t>(jointPairs[p] >> 32);
+            size_t c = static_cast<size_t>(jointPairs[p] & 0xFFFFFFFFULL);
+            float joint = static_cast<float>(q - p) / count;
+            float value = joint / ((mutualinfo1[b] / count) * (mutualinfo2[c] / count));
+            disorientation = disorientation + (joint * logf(value));
+            p = q;
+          }
+          for(const uint64_t& pair : jointPairs)
+          {
+            mutualinfo1[pair >> 32] = 0.0f;
+            mutualinfo2[pair & 0xFFFFFFFFULL] = 0.0f;
+          }
+          disorientation = 1.0f / disorientation;
+          misorients[idx] = disorientation;
+          if(disorientation < mindisorientation)
+          {
+            newxshift = xshift;
+            newyshift = yshift;
+            mindisorientation = disorientation;
+          }
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    findShifts(static_cast<int64_t>(range.min()), static_cast<int64_t>(range.max()));
+  }
+
+private:
+  static uint64_t JointPairKey(int32_t curgnum, int32_t refgnum)
+  {
+    return (static_cast<uint64_t>(curgnum) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(refgnum));
+  }
+
+  AlignSectionsMutualInformation* m_Filter = nullptr;
+  const int64_t* m_Dims = nullptr;
+  const int32_t* m_MIFeatureIds = nullptr;
+  const int32_t* m_FeatureCounts = nullptr;
+  int32_t m_PyramidLevels = 0;
+  std::vector<int64_t>& m_NewXShifts;
+  std::vector<int64_t>& m_NewYShifts;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -91,6 +274,7 @@ void AlignSectionsMutualInformation::setupFilterParameters()
   parameters.push_back(SIMPL_NEW_FLOAT_FP("Misorientation Tolerance", MisorientationTolerance, FilterParameter::Category::Parameter, AlignSectionsMutualInformation));
   std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AlignSectionsMutualInformation, linkedProps));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Use Multi-Resolution Search", UseMultiResolutionSearch, FilterParameter::Category::Parameter, AlignSectionsMutualInformation));
   parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 4, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
@@ -123,6 +307,7 @@ void AlignSectionsMutualInformation::readFilterParameters(AbstractFilterParamete
   reader->openFilterGroup(this, index);
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath()));
   setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setUseMultiResolutionSearch(reader->readValue("UseMultiResolutionSearch", getUseMultiResolutionSearch()));
   setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setQuatsArrayPath(reader->readDataArrayPath("QuatsArrayPath", getQuatsArrayPath()));
@@ -216,12 +401,6 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
   m_MIFeaturesPtr->initializeWithZeros();
   int32_t* miFeatureIds = m_MIFeaturesPtr->getPointer(0);
 
-  std::ofstream outFile;
-  if(getWriteAlignmentShifts())
-  {
-    outFile.open(getAlignmentShiftFileName().toLatin1().data());
-  }
-
   SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
 
   int64_t dims[3] = {
@@ -230,180 +409,37 @@ void AlignSectionsMutualInformation::find_shifts(std::vector<int64_t>& xshifts,
       static_cast<int64_t>(udims[2]),
   };
 
-  float disorientation = 0.0f;
-  float mindisorientation = std::numeric_limits<float>::max();
-  float** mutualinfo12 = nullptr;
-  float* mutualinfo1 = nullptr;
-  float* mutualinfo2 = nullptr;
-  int32_t featurecount1 = 0, featurecount2 = 0;
-  int64_t newxshift = 0;
-  int64_t newyshift = 0;
-  int64_t oldxshift = 0;
-  int64_t oldyshift = 0;
-  float count = 0.0f;
-  int64_t slice = 0;
-
-  int32_t refgnum = 0, curgnum = 0;
-  int64_t refposition = 0;
-  int64_t curposition = 0;
-
   form_features_sections();
 
-  std::vector<std::vector<float>> misorients;
-  misorients.resize(dims[0]);
-  for(int64_t a = 0; a < dims[0]; a++)
+  // Every slice pair only reads its own two slices, so all of the relative shifts are found concurrently
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+  std::vector<int64_t> newxshifts(dims[2], 0);
+  std::vector<int64_t> newyshifts(dims[2], 0);
+  int32_t pyramidLevels = m_UseMultiResolutionSearch ? ComputePyramidLevels(dims[0], dims[1]) : 0;
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(1, dims[2]);
+  dataAlg.execute(AlignSectionsMutualInformationShiftsImpl(this, dims, miFeatureIds, featurecounts, pyramidLevels, newxshifts, newyshifts));
+  if(getCancel())
   {
-    misorients[a].assign(dims[1], 0.0f);
+    return;
   }
 
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+  }
+
+  // The absolute shifts are the prefix sums of the relative shifts
   for(int64_t iter = 1; iter < dims[2]; iter++)
   {
-    float prog = ((float)iter / dims[2]) * 100;
-    QString ss = QObject::tr("Aligning Sections || Determining Shifts || %1% Complete").arg(QString::number(prog, 'f', 0));
-    notifyStatusMessage(ss);
-    mindisorientation = std::numeric_limits<float>::max();
-    slice = (dims[2] - 1) - iter;
-    featurecount1 = featurecounts[slice];
-    featurecount2 = featurecounts[slice + 1];
-    mutualinfo12 = new float*[featurecount1];
-    mutualinfo1 = new float[featurecount1];
-    mutualinfo2 = new float[featurecount2];
-
-    for(int32_t a = 0; a < featurecount1; a++)
-    {
-      mutualinfo1[a] = 0.0f;
-      mutualinfo12[a] = new float[featurecount2];
-      for(int32_t b = 0; b < featurecount2; b++)
-      {
-        mutualinfo12[a][b] = 0.0f;
-        mutualinfo2[b] = 0.0f;
-      }
-    }
-    oldxshift = -1;
-    oldyshift = -1;
-    newxshift = 0;
-    newyshift = 0;
-    for(int64_t a = 0; a < dims[0]; a++)
-    {
-      for(int64_t b = 0; b < dims[1]; b++)
-      {
-        misorients[a][b] = 0;
-      }
-    }
-    while(newxshift != oldxshift || newyshift != oldyshift)
-    {
-      oldxshift = newxshift;
-      oldyshift = newyshift;
-      for(int32_t j = -3; j < 4; j++)
-      {
-        for(int32_t k = -3; k < 4; k++)
-        {
-          disorientation = 0;
-          count = 0;
-          if(misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] == 0 && llabs(k + oldxshift) < (dims[0] / 2) && (j + oldyshift) < (dims[1] / 2))
-          {
-            for(int64_t l = 0; l < dims[1]; l = l + 4)
-            {
-              for(int64_t n = 0; n < dims[0]; n = n + 4)
-              {
-                if((l + j + oldyshift) >= 0 && (l + j + oldyshift) < dims[1] && (n + k + oldxshift) >= 0 && (n + k + oldxshift) < dims[0])
-                {
-                  refposition = ((slice + 1) * dims[0] * dims[1]) + (l * dims[0]) + n;
-                  curposition = (slice * dims[0] * dims[1]) + ((l + j + oldyshift) * dims[0]) + (n + k + oldxshift);
-                  refgnum = miFeatureIds[refposition];
-                  curgnum = miFeatureIds[curposition];
-                  if(curgnum >= 0 && refgnum >= 0)
-                  {
-                    mutualinfo12[curgnum][refgnum]++;
-                    mutualinfo1[curgnum]++;
-                    mutualinfo2[refgnum]++;
-                    count++;
-                  }
-                }
-                else
-                {
-                  mutualinfo12[0][0]++;
-                  mutualinfo1[0]++;
-                  mutualinfo2[0]++;
-                }
-              }
-            }
-            float ha = 0.0f;
-            float hb = 0.0f;
-            float hab = 0.0f;
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              mutualinfo1[b] = mutualinfo1[b] / count;
-              if(mutualinfo1[b] != 0)
-              {
-                ha = ha + mutualinfo1[b] * logf(mutualinfo1[b]);
-              }
-            }
-            for(int32_t c = 0; c < featurecount2; c++)
-            {
-              mutualinfo2[c] = mutualinfo2[c] / float(count);
-              if(mutualinfo2[c] != 0)
-              {
-                hb = hb + mutualinfo2[c] * logf(mutualinfo2[c]);
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = mutualinfo12[b][c] / count;
-                if(mutualinfo12[b][c] != 0)
-                {
-                  hab = hab + mutualinfo12[b][c] * logf(mutualinfo12[b][c]);
-                }
-                float value = 0.0f;
-                if(mutualinfo1[b] > 0 && mutualinfo2[c] > 0)
-                {
-                  value = (mutualinfo12[b][c] / (mutualinfo1[b] * mutualinfo2[c]));
-                }
-                if(value != 0)
-                {
-                  disorientation = disorientation + (mutualinfo12[b][c] * logf(value));
-                }
-              }
-            }
-            for(int32_t b = 0; b < featurecount1; b++)
-            {
-              for(int32_t c = 0; c < featurecount2; c++)
-              {
-                mutualinfo12[b][c] = 0.0f;
-                mutualinfo1[b] = 0.0f;
-                mutualinfo2[c] = 0.0f;
-              }
-            }
-            disorientation = 1.0f / disorientation;
-            misorients[k + oldxshift + dims[0] / 2][j + oldyshift + dims[1] / 2] = disorientation;
-            if(disorientation < mindisorientation)
-            {
-              newxshift = k + oldxshift;
-              newyshift = j + oldyshift;
-              mindisorientation = disorientation;
-            }
-          }
-        }
-      }
-    }
-    xshifts[iter] = xshifts[iter - 1] + newxshift;
-    yshifts[iter] = yshifts[iter - 1] + newyshift;
+    int64_t slice = (dims[2] - 1) - iter;
+    xshifts[iter] = xshifts[iter - 1] + newxshifts[iter];
+    yshifts[iter] = yshifts[iter - 1] + newyshifts[iter];
     if(getWriteAlignmentShifts())
     {
-      outFile << slice << "	" << slice + 1 << "	" << newxshift << "	" << newyshift << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
-    }
-    delete[] mutualinfo1;
-    delete[] mutualinfo2;
-    for(int32_t i = 0; i < featurecount1; i++)
-    {
-      delete mutualinfo12[i];
+      outFile << slice << "	" << slice + 1 << "	" << newxshifts[iter] << "	" << newyshifts[iter] << "	" << xshifts[iter] << "	" << yshifts[iter] << "\n";
     }
-    delete[] mutualinfo12;
-    mutualinfo1 = nullptr;
-    mutualinfo2 = nullptr;
-    mutualinfo12 = nullptr;
   }
 
   m->getAttributeMatrix(getCellAttributeMatrixName())->removeAttributeArray(SIMPL::CellData::FeatureIds);
@@ -706,6 +742,18 @@ bool AlignSectionsMutualInformation::getUseGoodVoxels() const
   return m_UseGoodVoxels;
 }
 
+// -----------------------------------------------------------------------------
+void AlignSectionsMutualInformation::setUseMultiResolutionSearch(bool value)
+{
+  m_UseMultiResolutionSearch = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AlignSectionsMutualInformation::getUseMultiResolutionSearch() const
+{
+  return m_UseMultiResolutionSearch;
+}
+
 // -----------------------------------------------------------------------------
 void AlignSectionsMutualInformation::setQuatsArrayPath(const DataArrayPath& value)
 {
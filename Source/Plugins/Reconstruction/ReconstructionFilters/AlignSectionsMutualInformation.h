@@ -62,6 +62,7 @@ class Reconstruction_EXPORT AlignSectionsMutualInformation : public AlignSection
   PYB11_FILTER_NEW_MACRO(AlignSectionsMutualInformation)
   PYB11_PROPERTY(float MisorientationTolerance READ getMisorientationTolerance WRITE setMisorientationTolerance)
   PYB11_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
+  PYB11_PROPERTY(bool UseMultiResolutionSearch READ getUseMultiResolutionSearch WRITE setUseMultiResolutionSearch)
   PYB11_PROPERTY(DataArrayPath QuatsArrayPath READ getQuatsArrayPath WRITE setQuatsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath GoodVoxelsArrayPath READ getGoodVoxelsArrayPath WRITE setGoodVoxelsArrayPath)
@@ -131,6 +132,17 @@ public:
   bool getUseGoodVoxels() const;
   Q_PROPERTY(bool UseGoodVoxels READ getUseGoodVoxels WRITE setUseGoodVoxels)
 
+  /**
+   * @brief Setter property for UseMultiResolutionSearch
+   */
+  void setUseMultiResolutionSearch(bool value);
+  /**
+   * @brief Getter property for UseMultiResolutionSearch
+   * @return Value of UseMultiResolutionSearch
+   */
+  bool getUseMultiResolutionSearch() const;
+  Q_PROPERTY(bool UseMultiResolutionSearch READ getUseMultiResolutionSearch WRITE setUseMultiResolutionSearch)
+
   /**
    * @brief Setter property for QuatsArrayPath
    */
@@ -272,6 +284,7 @@ private:
 
   float m_MisorientationTolerance = {};
   bool m_UseGoodVoxels = {};
+  bool m_UseMultiResolutionSearch = {false};
   DataArrayPath m_QuatsArrayPath = {};
   DataArrayPath m_CellPhasesArrayPath = {};
   DataArrayPath m_GoodVoxelsArrayPath = {};
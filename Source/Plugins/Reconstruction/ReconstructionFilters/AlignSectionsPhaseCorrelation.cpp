@@ -0,0 +1,640 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+#include "AlignSectionsPhaseCorrelation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <thread>
+
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/TemplateHelpers.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+#include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionVersion.h"
+
+namespace
+{
+using ComplexType = std::complex<double>;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t nextPowerOfTwo(size_t value)
+{
+  size_t n = 1;
+  while(n < value)
+  {
+    n <<= 1;
+  }
+  return n;
+}
+
+/**
+ * @brief fft In place iterative radix-2 Fourier transform of n values. n must be a power of two and the inverse
+ * transform is left unscaled.
+ */
+void fft(ComplexType* data, size_t n, bool inverse)
+{
+  for(size_t i = 1, j = 0; i < n; i++)
+  {
+    size_t bit = n >> 1;
+    for(; (j & bit) != 0; bit >>= 1)
+    {
+      j ^= bit;
+    }
+    j ^= bit;
+    if(i < j)
+    {
+      std::swap(data[i], data[j]);
+    }
+  }
+
+  for(size_t len = 2; len <= n; len <<= 1)
+  {
+    double angle = 2.0 * SIMPLib::Constants::k_PiD / static_cast<double>(len) * (inverse ? 1.0 : -1.0);
+    size_t halfLen = len / 2;
+    for(size_t k = 0; k < halfLen; k++)
+    {
+      ComplexType w(std::cos(angle * k), std::sin(angle * k));
+      for(size_t i = 0; i < n; i += len)
+      {
+        ComplexType u = data[i + k];
+        ComplexType v = data[i + k + halfLen] * w;
+        data[i + k] = u + v;
+        data[i + k + halfLen] = u - v;
+      }
+    }
+  }
+}
+
+/**
+ * @brief fft2D Transforms an nx by ny row major image in place, rows first and then columns
+ */
+void fft2D(std::vector<ComplexType>& data, size_t nx, size_t ny, bool inverse, std::vector<ComplexType>& column)
+{
+  for(size_t y = 0; y < ny; y++)
+  {
+    fft(data.data() + y * nx, nx, inverse);
+  }
+  column.resize(ny);
+  for(size_t x = 0; x < nx; x++)
+  {
+    for(size_t y = 0; y < ny; y++)
+    {
+      column[y] = data[y * nx + x];
+    }
+    fft(column.data(), ny, inverse);
+    for(size_t y = 0; y < ny; y++)
+    {
+      data[y * nx + x] = column[y];
+    }
+  }
+}
+
+/**
+ * @brief subPixelOffset Fits a parabola through a peak and its two neighbors and returns the offset of the vertex
+ * from the center sample
+ */
+double subPixelOffset(double left, double center, double right)
+{
+  double denominator = left - 2.0 * center + right;
+  if(denominator >= 0.0)
+  {
+    return 0.0;
+  }
+  double offset = 0.5 * (left - right) / denominator;
+  return std::max(-0.5, std::min(0.5, offset));
+}
+} // namespace
+
+/**
+ * @brief The AlignSectionsPhaseCorrelationImpl class finds the shift between each slice and the slice above it from
+ * the peak of the inverse transform of their normalized cross power spectrum. The slices are mean centered and
+ * tapered with a Hann window before being zero padded to a power of two. The range runs over blocks of consecutive
+ * slice pairs, one block per thread, so each thread allocates its two spectra once and reuses them for its block.
+ */
+template <typename T>
+class AlignSectionsPhaseCorrelationImpl
+{
+public:
+  AlignSectionsPhaseCorrelationImpl(AlignSectionsPhaseCorrelation* filter, const T* data, const bool* goodVoxels, const int64_t* dims, size_t numBlocks, std::vector<double>& newxshifts,
+                                    std::vector<double>& newyshifts)
+  : m_Filter(filter)
+  , m_Data(data)
+  , m_GoodVoxels(goodVoxels)
+  , m_Dims(dims)
+  , m_NumBlocks(numBlocks)
+  , m_NewXShifts(newxshifts)
+  , m_NewYShifts(newyshifts)
+  {
+  }
+
+  void findShifts(int64_t start, int64_t end) const
+  {
+    const int64_t* dims = m_Dims;
+    size_t nx = nextPowerOfTwo(static_cast<size_t>(dims[0]));
+    size_t ny = nextPowerOfTwo(static_cast<size_t>(dims[1]));
+
+    std::vector<double> xWindow = hannWindow(dims[0]);
+    std::vector<double> yWindow = hannWindow(dims[1]);
+
+    std::vector<ComplexType> refSpectrum(nx * ny);
+    std::vector<ComplexType> curSpectrum(nx * ny);
+    std::vector<ComplexType> column(ny);
+
+    // Walking down the stack, the current slice of one pair is the reference slice of the next one
+    int64_t refSlice = -1;
+    for(int64_t iter = start; iter < end; iter++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t slice = (dims[2] - 1) - iter;
+      if(refSlice != slice + 1)
+      {
+        transformSlice(slice + 1, xWindow, yWindow, nx, ny, refSpectrum, column);
+      }
+      transformSlice(slice, xWindow, yWindow, nx, ny, curSpectrum, column);
+
+      // The reference spectrum is not needed past this pair, so the correlation is built in its place
+      std::vector<ComplexType>& correlation = refSpectrum;
+      for(size_t i = 0; i < nx * ny; i++)
+      {
+        ComplexType crossPower = curSpectrum[i] * std::conj(refSpectrum[i]);
+        double magnitude = std::abs(crossPower);
+        correlation[i] = (magnitude > 0.0) ? crossPower / magnitude : ComplexType(0.0, 0.0);
+      }
+      fft2D(correlation, nx, ny, true, column);
+
+      size_t peak = 0;
+      for(size_t i = 1; i < nx * ny; i++)
+      {
+        if(correlation[i].real() > correlation[peak].real())
+        {
+          peak = i;
+        }
+      }
+      size_t px = peak % nx;
+      size_t py = peak / nx;
+      double dx = subPixelOffset(correlation[py * nx + (px + nx - 1) % nx].real(), correlation[peak].real(), correlation[py * nx + (px + 1) % nx].real());
+      double dy = subPixelOffset(correlation[((py + ny - 1) % ny) * nx + px].real(), correlation[peak].real(), correlation[((py + 1) % ny) * nx + px].real());
+
+      // The transform is periodic so peaks past the middle are negative shifts
+      m_NewXShifts[iter] = static_cast<double>(px > nx / 2 ? static_cast<int64_t>(px) - static_cast<int64_t>(nx) : static_cast<int64_t>(px)) + dx;
+      m_NewYShifts[iter] = static_cast<double>(py > ny / 2 ? static_cast<int64_t>(py) - static_cast<int64_t>(ny) : static_cast<int64_t>(py)) + dy;
+
+      std::swap(refSpectrum, curSpectrum);
+      refSlice = slice;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    // Consecutive blocks hold consecutive slice pairs, so a range of blocks is walked as one run of pairs
+    const size_t numPairs = static_cast<size_t>(m_Dims[2] - 1);
+    int64_t start = 1 + static_cast<int64_t>(numPairs * range.min() / m_NumBlocks);
+    int64_t end = 1 + static_cast<int64_t>(numPairs * range.max() / m_NumBlocks);
+    findShifts(start, end);
+  }
+
+private:
+  AlignSectionsPhaseCorrelation* m_Filter = nullptr;
+  const T* m_Data = nullptr;
+  const bool* m_GoodVoxels = nullptr;
+  const int64_t* m_Dims = nullptr;
+  size_t m_NumBlocks = 1;
+  std::vector<double>& m_NewXShifts;
+  std::vector<double>& m_NewYShifts;
+
+  /**
+   * @brief hannWindow Returns the Hann taper for a row or column of the given length
+   */
+  static std::vector<double> hannWindow(int64_t length)
+  {
+    std::vector<double> window(static_cast<size_t>(length), 1.0);
+    if(length > 1)
+    {
+      for(int64_t i = 0; i < length; i++)
+      {
+        window[i] = 0.5 - 0.5 * std::cos(2.0 * SIMPLib::Constants::k_PiD * static_cast<double>(i) / static_cast<double>(length - 1));
+      }
+    }
+    return window;
+  }
+
+  /**
+   * @brief transformSlice Copies a mean centered, windowed slice into the zero padded buffer and transforms it
+   */
+  void transformSlice(int64_t slice, const std::vector<double>& xWindow, const std::vector<double>& yWindow, size_t nx, size_t ny, std::vector<ComplexType>& spectrum,
+                      std::vector<ComplexType>& column) const
+  {
+    const int64_t* dims = m_Dims;
+    int64_t sliceOffset = slice * dims[0] * dims[1];
+
+    double sum = 0.0;
+    size_t count = 0;
+    for(int64_t i = sliceOffset; i < sliceOffset + dims[0] * dims[1]; i++)
+    {
+      if(m_GoodVoxels == nullptr || m_GoodVoxels[i])
+      {
+        sum += static_cast<double>(m_Data[i]);
+        count++;
+      }
+    }
+    double mean = (count > 0) ? sum / static_cast<double>(count) : 0.0;
+
+    std::fill(spectrum.begin(), spectrum.end(), ComplexType(0.0, 0.0));
+    for(int64_t y = 0; y < dims[1]; y++)
+    {
+      for(int64_t x = 0; x < dims[0]; x++)
+      {
+        int64_t index = sliceOffset + y * dims[0] + x;
+        if(m_GoodVoxels == nullptr || m_GoodVoxels[index])
+        {
+          spectrum[y * nx + x] = ComplexType((static_cast<double>(m_Data[index]) - mean) * xWindow[x] * yWindow[y], 0.0);
+        }
+      }
+    }
+    fft2D(spectrum, nx, ny, false, column);
+  }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+void findPhaseCorrelationShifts(AlignSectionsPhaseCorrelation* filter, IDataArray::Pointer inDataPtr, const bool* goodVoxels, const int64_t* dims, std::vector<double>& newxshifts,
+                                std::vector<double>& newyshifts)
+{
+  typename DataArray<T>::Pointer dataPtr = std::dynamic_pointer_cast<DataArray<T>>(inDataPtr);
+
+  // Every block keeps two padded spectra alive, so there are never more blocks than threads
+  size_t numPairs = static_cast<size_t>(dims[2] - 1);
+  size_t numBlocks = std::min<size_t>(numPairs, std::max(1u, std::thread::hardware_concurrency()));
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numBlocks);
+  dataAlg.execute(AlignSectionsPhaseCorrelationImpl<T>(filter, dataPtr->getPointer(0), goodVoxels, dims, numBlocks, newxshifts, newyshifts));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AlignSectionsPhaseCorrelation::AlignSectionsPhaseCorrelation() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AlignSectionsPhaseCorrelation::~AlignSectionsPhaseCorrelation() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::setupFilterParameters()
+{
+  // getting the current parameters that were set by the parent and adding to it before resetting it
+  AlignSections::setupFilterParameters();
+  FilterParameterVectorType parameters = getFilterParameters();
+  std::vector<QString> linkedProps = {"GoodVoxelsArrayPath"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Mask Array", UseGoodVoxels, FilterParameter::Category::Parameter, AlignSectionsPhaseCorrelation, linkedProps));
+  parameters.push_back(SeparatorFilterParameter::Create("Cell Data", FilterParameter::Category::RequiredArray));
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::Defaults::AnyPrimitive, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Attribute Array to Correlate", SelectedArrayPath, FilterParameter::Category::RequiredArray, AlignSectionsPhaseCorrelation, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Bool, 1, AttributeMatrix::Type::Cell, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Mask", GoodVoxelsArrayPath, FilterParameter::Category::RequiredArray, AlignSectionsPhaseCorrelation, req));
+  }
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  AlignSections::readFilterParameters(reader, index);
+  reader->openFilterGroup(this, index);
+  setSelectedArrayPath(reader->readDataArrayPath("SelectedArrayPath", getSelectedArrayPath()));
+  setUseGoodVoxels(reader->readValue("UseGoodVoxels", getUseGoodVoxels()));
+  setGoodVoxelsArrayPath(reader->readDataArrayPath("GoodVoxelsArrayPath", getGoodVoxelsArrayPath()));
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::initialize()
+{
+  m_GoodVoxels = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::dataCheck()
+{
+  clearErrorCode();
+  clearWarningCode();
+  initialize();
+
+  // Set the DataContainerName and AttributematrixName for the Parent Class (AlignSections) to Use.
+  setDataContainerName(DataArrayPath(m_SelectedArrayPath.getDataContainerName(), "", ""));
+  setCellAttributeMatrixName(m_SelectedArrayPath.getAttributeMatrixName());
+
+  AlignSections::dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  QVector<DataArrayPath> dataArrayPaths;
+
+  m_InDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath(this, getSelectedArrayPath());
+  if(nullptr != m_InDataPtr.lock())
+  {
+    if(TemplateHelpers::CanDynamicCast<BoolArrayType>()(m_InDataPtr.lock()))
+    {
+      QString ss = QObject::tr("Selected array cannot be of type bool.  The path is %1").arg(getSelectedArrayPath().serialize());
+      setErrorCondition(-3011, ss);
+    }
+    else if(m_InDataPtr.lock()->getNumberOfComponents() != 1)
+    {
+      QString ss = QObject::tr("Selected array must be a scalar array with a single component.  The path is %1").arg(getSelectedArrayPath().serialize());
+      setErrorCondition(-3012, ss);
+    }
+  }
+  if(getErrorCode() >= 0)
+  {
+    dataArrayPaths.push_back(getSelectedArrayPath());
+  }
+
+  if(m_UseGoodVoxels)
+  {
+    std::vector<size_t> cDims(1, 1);
+    m_GoodVoxelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<bool>>(this, getGoodVoxelsArrayPath(), cDims);
+    if(nullptr != m_GoodVoxelsPtr.lock())
+    {
+      m_GoodVoxels = m_GoodVoxelsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getGoodVoxelsArrayPath());
+    }
+  }
+
+  getDataContainerArray()->validateNumberOfTuples(this, dataArrayPaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::find_shifts(std::vector<int64_t>& xshifts, std::vector<int64_t>& yshifts)
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+
+  SizeVec3Type udims = m->getGeometryAs<ImageGeom>()->getDimensions();
+
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
+
+  // Every slice pair only reads its own two slices, so all of the relative shifts are found concurrently
+  notifyStatusMessage("Aligning Sections || Determining Shifts");
+  std::vector<double> newxshifts(dims[2], 0.0);
+  std::vector<double> newyshifts(dims[2], 0.0);
+  EXECUTE_FUNCTION_TEMPLATE(this, findPhaseCorrelationShifts, m_InDataPtr.lock(), this, m_InDataPtr.lock(), m_GoodVoxels, dims, newxshifts, newyshifts);
+  if(getCancel() || getErrorCode() < 0)
+  {
+    return;
+  }
+
+  std::ofstream outFile;
+  if(getWriteAlignmentShifts())
+  {
+    outFile.open(getAlignmentShiftFileName().toLatin1().data());
+    outFile << "#"
+            << "Slice_A,Slice_B,New X Shift,New Y Shift,X Shift,Y Shift" << std::endl;
+  }
+
+  // The sub-cell shifts are accumulated before rounding so the rounding error does not build up along the stack
+  double xshift = 0.0;
+  double yshift = 0.0;
+  for(int64_t iter = 1; iter < dims[2]; iter++)
+  {
+    int64_t slice = (dims[2] - 1) - iter;
+    xshift += newxshifts[iter];
+    yshift += newyshifts[iter];
+    xshifts[iter] = static_cast<int64_t>(std::llround(xshift));
+    yshifts[iter] = static_cast<int64_t>(std::llround(yshift));
+    if(getWriteAlignmentShifts())
+    {
+      outFile << slice << "," << slice + 1 << "," << newxshifts[iter] << "," << newyshifts[iter] << "," << xshifts[iter] << "," << yshifts[iter] << std::endl;
+    }
+  }
+  if(getWriteAlignmentShifts())
+  {
+    outFile.close();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::execute()
+{
+  clearErrorCode();
+  clearWarningCode();
+
+  dataCheck();
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  AlignSections::execute();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer AlignSectionsPhaseCorrelation::newFilterInstance(bool copyFilterParameters) const
+{
+  AlignSectionsPhaseCorrelation::Pointer filter = AlignSectionsPhaseCorrelation::New();
+  if(copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getCompiledLibraryName() const
+{
+  return ReconstructionConstants::ReconstructionBaseName;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getBrandingString() const
+{
+  return "Reconstruction";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getFilterVersion() const
+{
+  QString version;
+  QTextStream vStream(&version);
+  vStream << Reconstruction::Version::Major() << "." << Reconstruction::Version::Minor() << "." << Reconstruction::Version::Patch();
+  return version;
+}
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getGroupName() const
+{
+  return SIMPL::FilterGroups::ReconstructionFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QUuid AlignSectionsPhaseCorrelation::getUuid() const
+{
+  return QUuid("{b1a3cb20-d28e-5b2c-887d-83f184eaa5f9}");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getSubGroupName() const
+{
+  return SIMPL::FilterSubGroups::AlignmentFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getHumanLabel() const
+{
+  return "Align Sections (Phase Correlation)";
+}
+
+// -----------------------------------------------------------------------------
+AlignSectionsPhaseCorrelation::Pointer AlignSectionsPhaseCorrelation::NullPointer()
+{
+  return Pointer(static_cast<Self*>(nullptr));
+}
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<AlignSectionsPhaseCorrelation> AlignSectionsPhaseCorrelation::New()
+{
+  struct make_shared_enabler : public AlignSectionsPhaseCorrelation
+  {
+  };
+  std::shared_ptr<make_shared_enabler> val = std::make_shared<make_shared_enabler>();
+  val->setupFilterParameters();
+  return val;
+}
+
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::getNameOfClass() const
+{
+  return QString("AlignSectionsPhaseCorrelation");
+}
+
+// -----------------------------------------------------------------------------
+QString AlignSectionsPhaseCorrelation::ClassName()
+{
+  return QString("AlignSectionsPhaseCorrelation");
+}
+
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::setSelectedArrayPath(const DataArrayPath& value)
+{
+  m_SelectedArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath AlignSectionsPhaseCorrelation::getSelectedArrayPath() const
+{
+  return m_SelectedArrayPath;
+}
+
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::setUseGoodVoxels(bool value)
+{
+  m_UseGoodVoxels = value;
+}
+
+// -----------------------------------------------------------------------------
+bool AlignSectionsPhaseCorrelation::getUseGoodVoxels() const
+{
+  return m_UseGoodVoxels;
+}
+
+// -----------------------------------------------------------------------------
+void AlignSectionsPhaseCorrelation::setGoodVoxelsArrayPath(const DataArrayPath& value)
+{
+  m_GoodVoxelsArrayPath = value;
+}
+
+// -----------------------------------------------------------------------------
+DataArrayPath AlignSectionsPhaseCorrelation::getGoodVoxelsArrayPath() const
+{
+  return m_GoodVoxelsArrayPath;
+}
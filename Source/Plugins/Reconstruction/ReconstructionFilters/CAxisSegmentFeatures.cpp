@@ -313,7 +313,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -340,9 +339,6 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -351,6 +347,27 @@ int64_t CAxisSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 //
 // -----------------------------------------------------------------------------
 bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+{
+  if(m_FeatureIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::isSeedable(int64_t point) const
+{
+  return (!m_UseGoodVoxels || m_GoodVoxels[point]) && m_CellPhases[point] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool CAxisSegmentFeatures::compareVoxels(int64_t referencepoint, int64_t neighborpoint) const
 {
   bool group = false;
   float w = std::numeric_limits<float>::max();
@@ -363,7 +380,7 @@ bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t nei
   float c1[3] = {0.0f, 0.0f, 0.0f};
   float c2[3] = {0.0f, 0.0f, 0.0f};
   float* currentQuatPtr = nullptr;
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  if(!m_UseGoodVoxels || m_GoodVoxels[neighborpoint])
   {
     currentQuatPtr = m_Quats + referencepoint * 4;
     QuatF q1(currentQuatPtr[0], currentQuatPtr[1], currentQuatPtr[2], currentQuatPtr[3]);
@@ -393,7 +410,6 @@ bool CAxisSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t nei
       if(w <= m_MisoTolerance || (SIMPLib::Constants::k_PiD - w) <= m_MisoTolerance)
       {
         group = true;
-        m_FeatureIds[neighborpoint] = gnum;
       }
     }
   }
@@ -437,7 +453,15 @@ void CAxisSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  // Segment with the block parallel labeling; it produces the same Features as the serial burn algorithm
+  int32_t totalSegmented = executeParallel(m_FeatureIds);
+  if(totalSegmented < 0)
+  {
+    return;
+  }
+  tDims[0] = static_cast<size_t>(totalSegmented);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
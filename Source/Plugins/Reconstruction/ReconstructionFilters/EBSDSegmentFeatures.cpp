@@ -296,7 +296,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -323,9 +322,6 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -334,6 +330,27 @@ int64_t EBSDSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 //
 // -----------------------------------------------------------------------------
 bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+{
+  if(m_FeatureIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::isSeedable(int64_t point) const
+{
+  return (!m_UseGoodVoxels || m_GoodVoxels[point]) && m_CellPhases[point] > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool EBSDSegmentFeatures::compareVoxels(int64_t referencepoint, int64_t neighborpoint) const
 {
   bool group = false;
 
@@ -347,7 +364,7 @@ bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neig
   }
   float* currentQuatPtr = nullptr;
 
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  if(!m_UseGoodVoxels || m_GoodVoxels[neighborpoint])
   {
     float w = std::numeric_limits<float>::max();
     currentQuatPtr = m_Quats + referencepoint * 4;
@@ -363,7 +380,6 @@ bool EBSDSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neig
     if(w < m_MisoTolerance)
     {
       group = true;
-      m_FeatureIds[neighborpoint] = gnum;
     }
   }
   return group;
@@ -405,7 +421,15 @@ void EBSDSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  // Segment with the block parallel labeling; it produces the same Features as the serial burn algorithm
+  int32_t totalSegmented = executeParallel(m_FeatureIds);
+  if(totalSegmented < 0)
+  {
+    return;
+  }
+  tDims[0] = static_cast<size_t>(totalSegmented);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
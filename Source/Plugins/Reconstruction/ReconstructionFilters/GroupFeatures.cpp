@@ -42,9 +42,114 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
+#include "Reconstruction/ReconstructionFilters/util/ConcurrentUnionFind.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The GroupFeaturesEvaluatePairsImpl class evaluates compareFeatures for every neighbor list entry and caches
+ * the decision for each entry. A non-contiguous list is built with the reach of its own Feature, so a Feature may list
+ * a neighbor that does not list it back and every directed entry has to be evaluated.
+ */
+class GroupFeaturesEvaluatePairsImpl
+{
+public:
+  GroupFeaturesEvaluatePairsImpl(GroupFeatures* filter, NeighborList<int32_t>& contiguousNeighbors, NeighborList<int32_t>* nonContiguousNeighbors, const std::vector<size_t>& pairOffsets,
+                                 std::vector<uint8_t>& decisions)
+  : m_Filter(filter)
+  , m_ContiguousNeighbors(contiguousNeighbors)
+  , m_NonContiguousNeighbors(nonContiguousNeighbors)
+  , m_PairOffsets(pairOffsets)
+  , m_Decisions(decisions)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t feature = range.min(); feature < range.max(); feature++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int32_t featureId = static_cast<int32_t>(feature);
+      size_t offset = evaluateList(featureId, m_ContiguousNeighbors[featureId], m_PairOffsets[feature]);
+      if(m_NonContiguousNeighbors != nullptr)
+      {
+        evaluateList(featureId, m_NonContiguousNeighbors->getListReference(featureId), offset);
+      }
+    }
+  }
+
+private:
+  GroupFeatures* m_Filter = nullptr;
+  NeighborList<int32_t>& m_ContiguousNeighbors;
+  NeighborList<int32_t>* m_NonContiguousNeighbors = nullptr;
+  const std::vector<size_t>& m_PairOffsets;
+  std::vector<uint8_t>& m_Decisions;
+
+  size_t evaluateList(int32_t feature, const std::vector<int32_t>& neighbors, size_t offset) const
+  {
+    for(const auto& neighbor : neighbors)
+    {
+      m_Decisions[offset] = (neighbor != feature && m_Filter->compareFeatures(feature, neighbor)) ? 1 : 0;
+      offset++;
+    }
+    return offset;
+  }
+};
+
+/**
+ * @brief The GroupFeaturesUnitePairsImpl class merges the Features of every accepted neighbor pair.
+ */
+class GroupFeaturesUnitePairsImpl
+{
+public:
+  GroupFeaturesUnitePairsImpl(NeighborList<int32_t>& contiguousNeighbors, NeighborList<int32_t>* nonContiguousNeighbors, const std::vector<size_t>& pairOffsets, const std::vector<uint8_t>& decisions,
+                              ConcurrentUnionFind& unionFind)
+  : m_ContiguousNeighbors(contiguousNeighbors)
+  , m_NonContiguousNeighbors(nonContiguousNeighbors)
+  , m_PairOffsets(pairOffsets)
+  , m_Decisions(decisions)
+  , m_UnionFind(unionFind)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t feature = range.min(); feature < range.max(); feature++)
+    {
+      int32_t featureId = static_cast<int32_t>(feature);
+      size_t offset = uniteList(featureId, m_ContiguousNeighbors[featureId], m_PairOffsets[feature]);
+      if(m_NonContiguousNeighbors != nullptr)
+      {
+        uniteList(featureId, m_NonContiguousNeighbors->getListReference(featureId), offset);
+      }
+    }
+  }
+
+private:
+  NeighborList<int32_t>& m_ContiguousNeighbors;
+  NeighborList<int32_t>* m_NonContiguousNeighbors = nullptr;
+  const std::vector<size_t>& m_PairOffsets;
+  const std::vector<uint8_t>& m_Decisions;
+  ConcurrentUnionFind& m_UnionFind;
+
+  size_t uniteList(int32_t feature, const std::vector<int32_t>& neighbors, size_t offset) const
+  {
+    for(const auto& neighbor : neighbors)
+    {
+      if(m_Decisions[offset] != 0)
+      {
+        m_UnionFind.unite(feature, neighbor);
+      }
+      offset++;
+    }
+    return offset;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -134,6 +239,14 @@ bool GroupFeatures::determineGrouping(int32_t referenceFeature, int32_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const
+{
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -163,6 +276,14 @@ void GroupFeatures::execute()
     return;
   }
 
+  executeSerial();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GroupFeatures::executeSerial()
+{
   NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
   NeighborList<int32_t>* nonContigNeighList = m_NonContiguousNeighborList.lock().get();
 
@@ -250,6 +371,67 @@ void GroupFeatures::execute()
     }
     grouplist.clear();
   }
+
+  return parentcount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GroupFeatures::executeParallel(int32_t* featureParentIds)
+{
+  NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
+  NeighborList<int32_t>* nonContigNeighList = m_UseNonContiguousNeighbors ? m_NonContiguousNeighborList.lock().get() : nullptr;
+
+  size_t numFeatures = neighborlist.getNumberOfTuples();
+  if(numFeatures < 2)
+  {
+    if(numFeatures == 1)
+    {
+      featureParentIds[0] = 0;
+    }
+    return 1;
+  }
+
+  // Each Feature owns a contiguous run of decisions, one per entry of its neighbor lists
+  std::vector<size_t> pairOffsets(numFeatures + 1, 0);
+  for(size_t feature = 0; feature < numFeatures; feature++)
+  {
+    size_t listSize = neighborlist[static_cast<int32_t>(feature)].size();
+    if(nonContigNeighList != nullptr)
+    {
+      listSize += nonContigNeighList->getListSize(static_cast<int32_t>(feature));
+    }
+    pairOffsets[feature + 1] = pairOffsets[feature] + listSize;
+  }
+
+  notifyStatusMessage("Evaluating Feature Pairs");
+  std::vector<uint8_t> decisions(pairOffsets[numFeatures], 0);
+  ParallelDataAlgorithm evaluateAlg;
+  evaluateAlg.setRange(1, numFeatures);
+  evaluateAlg.execute(GroupFeaturesEvaluatePairsImpl(this, neighborlist, nonContigNeighList, pairOffsets, decisions));
+  if(getCancel())
+  {
+    return -1;
+  }
+
+  notifyStatusMessage("Merging Feature Groups");
+  ConcurrentUnionFind unionFind(numFeatures);
+  ParallelDataAlgorithm uniteAlg;
+  uniteAlg.setRange(1, numFeatures);
+  uniteAlg.execute(GroupFeaturesUnitePairsImpl(neighborlist, nonContigNeighList, pairOffsets, decisions, unionFind));
+
+  // Every root is the smallest Feature of its group, so it is always numbered before the rest of the group
+  featureParentIds[0] = 0;
+  int32_t parentcount = 1;
+  for(size_t feature = 1; feature < numFeatures; feature++)
+  {
+    int32_t featureId = static_cast<int32_t>(feature);
+    int32_t root = unionFind.find(featureId);
+    featureParentIds[feature] = (root == featureId) ? parentcount++ : featureParentIds[root];
+  }
+
+  return parentcount;
 }
 
 // -----------------------------------------------------------------------------
@@ -242,6 +242,32 @@ protected:
    */
   virtual bool growGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+  /**
+   * @brief executeSerial Groups the Features one parent at a time from the seeds returned by getSeed. The new
+   * Feature Attribute Matrix is not touched while the groups are grown, so callers size it once from the returned count.
+   * @return Number of parent Features including the 0 parent
+   */
+  int32_t executeSerial();
+
+  /**
+   * @brief compareFeatures Side effect free form of determineGrouping used by the parallel grouping path. The
+   * comparison must be symmetric and may not depend on the order in which Features are grouped
+   * @param referenceFeature Feature of the growing group
+   * @param neighborFeature Feature to be compared for adding
+   * @return Boolean check for whether the two Features belong to the same parent
+   */
+  virtual bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const;
+
+  /**
+   * @brief executeParallel Groups the Features as the connected components of the neighbor graph instead of
+   * growing one parent at a time. compareFeatures is evaluated concurrently once for every neighbor list entry, the
+   * cached decisions are merged with a lock free union-find and the parents are numbered in order of their smallest
+   * Feature. Patch grouping and running averages are not supported by this path.
+   * @param featureParentIds Parent Ids array that receives the grouping
+   * @return Number of parent Features including the 0 parent, or -1 if the grouping was canceled
+   */
+  int32_t executeParallel(int32_t* featureParentIds);
+
 private:
   DataArrayPath m_ContiguousNeighborListArrayPath = {"", "", ""};
   DataArrayPath m_NonContiguousNeighborListArrayPath = {"", "", ""};
@@ -251,6 +277,8 @@ private:
   NeighborList<int32_t>::WeakPointer m_ContiguousNeighborList;
   NeighborList<int32_t>::WeakPointer m_NonContiguousNeighborList;
 
+  friend class GroupFeaturesEvaluatePairsImpl;
+
 public:
   GroupFeatures(const GroupFeatures&) = delete;            // Copy Constructor Not Implemented
   GroupFeatures(GroupFeatures&&) = delete;                 // Move Constructor Not Implemented
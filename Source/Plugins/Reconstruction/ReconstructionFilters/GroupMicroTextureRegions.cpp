@@ -375,9 +375,6 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
   if(seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    std::vector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
 
     if(m_UseRunningAverage)
     {
@@ -498,7 +495,11 @@ void GroupMicroTextureRegions::execute()
   m_AvgCAxes[1] = 0.0f;
   m_AvgCAxes[2] = 0.0f;
 
-  GroupFeatures::execute();
+  // Grow all of the parent Features first and size the new Feature Attribute Matrix once at the end
+  int32_t numGroups = executeSerial();
+  std::vector<size_t> tDims(1, static_cast<size_t>(numGroups));
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if(totalFeatures < 2)
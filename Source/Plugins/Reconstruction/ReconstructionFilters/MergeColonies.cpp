@@ -371,9 +371,6 @@ int32_t MergeColonies::getSeed(int32_t newFid)
   if(seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    std::vector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -382,13 +379,26 @@ int32_t MergeColonies::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if(m_FeatureParentIds[neighborFeature] == -1 && compareFeatures(referenceFeature, neighborFeature))
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const
 {
   double w = 0.0f;
   bool colony = false;
 
   // QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  if(m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if(m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     w = std::numeric_limits<double>::max();
     float* avgQuatPtr = m_AvgQuats + referenceFeature * 4;
@@ -437,29 +447,15 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
       {
         colony = true;
       }
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return colony;
     }
-    else if(EbsdLib::CrystalStructure::Cubic_High == phase2 && EbsdLib::CrystalStructure::Hexagonal_High == phase1)
+    if(EbsdLib::CrystalStructure::Cubic_High == phase2 && EbsdLib::CrystalStructure::Hexagonal_High == phase1)
     {
-      colony = check_for_burgers(q2, q1);
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return check_for_burgers(q2, q1);
     }
-    else if(EbsdLib::CrystalStructure::Cubic_High == phase1 && EbsdLib::CrystalStructure::Hexagonal_High == phase2)
+    if(EbsdLib::CrystalStructure::Cubic_High == phase1 && EbsdLib::CrystalStructure::Hexagonal_High == phase2)
     {
-      colony = check_for_burgers(q1, q2);
-      if(colony)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return check_for_burgers(q1, q2);
     }
   }
   return false;
@@ -597,7 +593,15 @@ void MergeColonies::execute()
 
   m_AxisToleranceRad = m_AxisTolerance * SIMPLib::Constants::k_PiD / 180.0f;
 
-  GroupFeatures::execute();
+  // Group all of the parent Features first and size the new Feature Attribute Matrix once at the end
+  int32_t numGroups = executeParallel(m_FeatureParentIds);
+  if(numGroups < 0)
+  {
+    return;
+  }
+  std::vector<size_t> tDims(1, static_cast<size_t>(numGroups));
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if(totalFeatures < 2)
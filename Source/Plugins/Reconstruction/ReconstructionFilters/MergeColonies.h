@@ -343,6 +343,11 @@ protected:
    */
   bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid) override;
 
+  /**
+   * @brief compareFeatures Reimplemented from @see GroupFeatures class
+   */
+  bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const override;
+
   /**
    * @brief check_for_burgers Checks the Burgers vector between two quaternions
    * @param betaQuat Beta quaterion
@@ -84,6 +84,8 @@ MergeTwins::MergeTwins()
 , m_FeatureParentIdsArrayName(SIMPL::FeatureData::ParentIds)
 , m_ActiveArrayName(SIMPL::FeatureData::Active)
 {
+  m_OrientationOps = LaueOps::GetAllOrientationOps();
+
   initialize();
 }
 
@@ -296,9 +298,6 @@ int32_t MergeTwins::getSeed(int32_t newFid)
   if(seed >= 0)
   {
     m_FeatureParentIds[seed] = newFid;
-    std::vector<size_t> tDims(1, newFid + 1);
-    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -308,41 +307,42 @@ int32_t MergeTwins::getSeed(int32_t newFid)
 // -----------------------------------------------------------------------------
 bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
 {
-  // float w = 0.0f;
-  // float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  bool twin = false;
-  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
-  float* currentAvgQuatPtr = nullptr;
-
-  if(m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if(m_FeatureParentIds[neighborFeature] == -1 && compareFeatures(referenceFeature, neighborFeature))
   {
-    uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
 
-    currentAvgQuatPtr = m_AvgQuats + referenceFeature * 4;
-    QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
-    currentAvgQuatPtr = m_AvgQuats + neighborFeature * 4;
-    QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const
+{
+  if(m_FeaturePhases[referenceFeature] <= 0 || m_FeaturePhases[neighborFeature] <= 0)
+  {
+    return false;
+  }
 
-    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
-    if(phase1 == phase2 && (phase1 == EbsdLib::CrystalStructure::Cubic_High))
-    {
-      OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
-      double w = axisAngle[3];
-      w = w * (SIMPLib::Constants::k_180OverPiD);
-      double axisdiff111 = acosf(fabs(axisAngle[0]) * 0.57735f + fabs(axisAngle[1]) * 0.57735f + fabs(axisAngle[2]) * 0.57735f);
-      double angdiff60 = fabs(w - 60.0f);
-      if(axisdiff111 < m_AxisToleranceRad && angdiff60 < m_AngleTolerance)
-      {
-        twin = true;
-      }
-      if(twin)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
-    }
+  uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
+  uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
+  if(phase1 != phase2 || phase1 != EbsdLib::CrystalStructure::Cubic_High)
+  {
+    return false;
   }
-  return false;
+
+  const float* currentAvgQuatPtr = m_AvgQuats + referenceFeature * 4;
+  QuatF q1(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
+  currentAvgQuatPtr = m_AvgQuats + neighborFeature * 4;
+  QuatF q2(currentAvgQuatPtr[0], currentAvgQuatPtr[1], currentAvgQuatPtr[2], currentAvgQuatPtr[3]);
+
+  OrientationD axisAngle = m_OrientationOps[phase1]->calculateMisorientation(q1, q2);
+  double w = axisAngle[3];
+  w = w * (SIMPLib::Constants::k_180OverPiD);
+  double axisdiff111 = acosf(fabs(axisAngle[0]) * 0.57735f + fabs(axisAngle[1]) * 0.57735f + fabs(axisAngle[2]) * 0.57735f);
+  double angdiff60 = fabs(w - 60.0f);
+  return axisdiff111 < m_AxisToleranceRad && angdiff60 < m_AngleTolerance;
 }
 
 // -----------------------------------------------------------------------------
@@ -380,7 +380,15 @@ void MergeTwins::execute()
 
   m_FeatureParentIds[0] = 0; // set feature 0 to be parent 0
 
-  GroupFeatures::execute();
+  // Group all of the parent Features first and size the new Feature Attribute Matrix once at the end
+  int32_t numGroups = executeParallel(m_FeatureParentIds);
+  if(numGroups < 0)
+  {
+    return;
+  }
+  std::vector<size_t> tDims(1, static_cast<size_t>(numGroups));
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if(totalFeatures < 2)
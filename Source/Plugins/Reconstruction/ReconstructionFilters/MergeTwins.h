@@ -44,6 +44,10 @@
 #include "Reconstruction/ReconstructionDLLExport.h"
 #include "Reconstruction/ReconstructionFilters/GroupFeatures.h"
 
+class LaueOps;
+using LaueOpsShPtrType = std::shared_ptr<LaueOps>;
+using LaueOpsContainer = std::vector<LaueOpsShPtrType>;
+
 /**
  * @brief The MergeTwins class. See [Filter documentation](@ref mergetwins) for details.
  */
@@ -295,6 +299,11 @@ protected:
    */
   bool determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid) override;
 
+  /**
+   * @brief compareFeatures Reimplemented from @see GroupFeatures class
+   */
+  bool compareFeatures(int32_t referenceFeature, int32_t neighborFeature) const override;
+
   /**
    * @brief characterize_twins Characterizes twins; CURRENTLY NOT IMPLEMENTED
    */
@@ -328,6 +337,8 @@ private:
   QString m_FeatureParentIdsArrayName = {};
   QString m_ActiveArrayName = {};
 
+  LaueOpsContainer m_OrientationOps;
+
   float m_AxisToleranceRad = 0.0f;
 
   /**
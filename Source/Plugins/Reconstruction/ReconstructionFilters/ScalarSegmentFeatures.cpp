@@ -73,7 +73,7 @@ class CompareFunctor
 public:
   virtual ~CompareFunctor() = default;
 
-  virtual bool operator()(int64_t index, int64_t neighIndex, int32_t gnum) // call using () operator
+  virtual bool operator()(int64_t index, int64_t neighIndex) const // call using () operator
   {
     return false;
   }
@@ -85,15 +85,14 @@ public:
 class TSpecificCompareFunctorBool : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance, int32_t* featureIds)
+  TSpecificCompareFunctorBool(void* data, int64_t length, bool tolerance)
   : m_Length(length)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<bool*>(data);
   }
   virtual ~TSpecificCompareFunctorBool() = default;
 
-  bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum) override
+  bool operator()(int64_t referencepoint, int64_t neighborpoint) const override
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -101,21 +100,15 @@ public:
       return false;
     }
 
-    if(m_Data[neighborpoint] == m_Data[referencepoint])
-    {
-      m_FeatureIds[neighborpoint] = gnum;
-      return true;
-    }
-    return false;
+    return m_Data[neighborpoint] == m_Data[referencepoint];
   }
 
 protected:
   TSpecificCompareFunctorBool() = default;
 
 private:
-  bool* m_Data = nullptr;          // The data that is being compared
-  int64_t m_Length = 0;            // Length of the Data Array
-  int32_t* m_FeatureIds = nullptr; // The Feature Ids
+  bool* m_Data = nullptr; // The data that is being compared
+  int64_t m_Length = 0;   // Length of the Data Array
 };
 
 /**
@@ -125,16 +118,15 @@ template <class T>
 class TSpecificCompareFunctor : public CompareFunctor
 {
 public:
-  TSpecificCompareFunctor(void* data, int64_t length, T tolerance, int32_t* featureIds)
+  TSpecificCompareFunctor(void* data, int64_t length, T tolerance)
   : m_Length(length)
   , m_Tolerance(tolerance)
-  , m_FeatureIds(featureIds)
   {
     m_Data = reinterpret_cast<T*>(data);
   }
   virtual ~TSpecificCompareFunctor() = default;
 
-  bool operator()(int64_t referencepoint, int64_t neighborpoint, int32_t gnum) override
+  bool operator()(int64_t referencepoint, int64_t neighborpoint) const override
   {
     // Sanity check the indices that are being passed in.
     if(referencepoint >= m_Length || neighborpoint >= m_Length)
@@ -144,21 +136,9 @@ public:
 
     if(m_Data[referencepoint] >= m_Data[neighborpoint])
     {
-      if((m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance)
-      {
-        m_FeatureIds[neighborpoint] = gnum;
-        return true;
-      }
-    }
-    else
-    {
-      if((m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance)
-      {
-        m_FeatureIds[neighborpoint] = gnum;
-        return true;
-      }
+      return (m_Data[referencepoint] - m_Data[neighborpoint]) <= m_Tolerance;
     }
-    return false;
+    return (m_Data[neighborpoint] - m_Data[referencepoint]) <= m_Tolerance;
   }
 
 protected:
@@ -168,7 +148,6 @@ private:
   T* m_Data = nullptr;               // The data that is being compared
   int64_t m_Length = 0;              // Length of the Data Array
   T m_Tolerance = static_cast<T>(0); // The tolerance of the comparison
-  int32_t* m_FeatureIds = nullptr;   // The Feature Ids
 };
 
 // -----------------------------------------------------------------------------
@@ -377,7 +356,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -404,9 +382,6 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -416,10 +391,31 @@ int64_t ScalarSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 // -----------------------------------------------------------------------------
 bool ScalarSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
 {
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  if(m_FeatureIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::isSeedable(int64_t point) const
+{
+  return !m_UseGoodVoxels || m_GoodVoxels[point];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScalarSegmentFeatures::compareVoxels(int64_t referencepoint, int64_t neighborpoint) const
+{
+  if(!m_UseGoodVoxels || m_GoodVoxels[neighborpoint])
   {
-    CompareFunctor* func = m_Compare.get();
-    return (*func)((size_t)(referencepoint), (size_t)(neighborpoint), gnum);
+    const CompareFunctor* func = m_Compare.get();
+    return (*func)(referencepoint, neighborpoint);
     //     | Functor  ||calling the operator() method of the CompareFunctor Class |
   }
 
@@ -465,47 +461,47 @@ void ScalarSegmentFeatures::execute()
   }
   else if(dType.compare("int8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, static_cast<int8_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int8_t>>(new TSpecificCompareFunctor<int8_t>(m_InputData, inDataPoints, static_cast<int8_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, static_cast<uint8_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint8_t>>(new TSpecificCompareFunctor<uint8_t>(m_InputData, inDataPoints, static_cast<uint8_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("bool") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, static_cast<bool>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctorBool>(new TSpecificCompareFunctorBool(m_InputData, inDataPoints, static_cast<bool>(m_ScalarTolerance)));
   }
   else if(dType.compare("int16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, static_cast<int16_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int16_t>>(new TSpecificCompareFunctor<int16_t>(m_InputData, inDataPoints, static_cast<int16_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, static_cast<uint16_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint16_t>>(new TSpecificCompareFunctor<uint16_t>(m_InputData, inDataPoints, static_cast<uint16_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("int32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, static_cast<int32_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int32_t>>(new TSpecificCompareFunctor<int32_t>(m_InputData, inDataPoints, static_cast<int32_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, static_cast<uint32_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint32_t>>(new TSpecificCompareFunctor<uint32_t>(m_InputData, inDataPoints, static_cast<uint32_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("int64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, static_cast<int64_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<int64_t>>(new TSpecificCompareFunctor<int64_t>(m_InputData, inDataPoints, static_cast<int64_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, static_cast<uint64_t>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<uint64_t>>(new TSpecificCompareFunctor<uint64_t>(m_InputData, inDataPoints, static_cast<uint64_t>(m_ScalarTolerance)));
   }
   else if(dType.compare("float") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance, m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<float>>(new TSpecificCompareFunctor<float>(m_InputData, inDataPoints, m_ScalarTolerance));
   }
   else if(dType.compare("double") == 0)
   {
-    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, static_cast<double>(m_ScalarTolerance), m_FeatureIds));
+    m_Compare = std::shared_ptr<TSpecificCompareFunctor<double>>(new TSpecificCompareFunctor<double>(m_InputData, inDataPoints, static_cast<double>(m_ScalarTolerance)));
   }
 
   // Generate the random voxel indices that will be used for the seed points to start a new grain growth/agglomeration
@@ -513,7 +509,15 @@ void ScalarSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  // Segment with the block parallel labeling; it produces the same Features as the serial burn algorithm
+  int32_t totalSegmented = executeParallel(m_FeatureIds);
+  if(totalSegmented < 0)
+  {
+    return;
+  }
+  tDims[0] = static_cast<size_t>(totalSegmented);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int64_t totalFeatures = static_cast<int64_t>(m_ActivePtr.lock()->getNumberOfTuples());
   if(totalFeatures < 2)
@@ -34,16 +34,227 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "SegmentFeatures.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "Reconstruction/ReconstructionConstants.h"
+#include "Reconstruction/ReconstructionFilters/util/ConcurrentUnionFind.h"
 #include "Reconstruction/ReconstructionVersion.h"
 
+/**
+ * @brief The SegmentFeaturesLabelBlocksImpl class flood fills each block of rows independently, writing
+ * block local Feature Ids. Neighbors outside of the block are ignored; those seams are merged afterwards.
+ */
+class SegmentFeaturesLabelBlocksImpl
+{
+public:
+  SegmentFeaturesLabelBlocksImpl(SegmentFeatures* filter, int32_t* featureIds, const int64_t* dims, int64_t rowsPerBlock, std::vector<int32_t>& blockCounts)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_RowsPerBlock(rowsPerBlock)
+  , m_BlockCounts(blockCounts)
+  {
+  }
+
+  void label(size_t start, size_t end) const
+  {
+    int64_t numRows = m_Dims[1] * m_Dims[2];
+    int64_t neighpoints[6] = {-(m_Dims[0] * m_Dims[1]), -m_Dims[0], -1, 1, m_Dims[0], (m_Dims[0] * m_Dims[1])};
+    std::vector<int64_t> voxelslist;
+    for(size_t block = start; block < end; block++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t firstPoint = static_cast<int64_t>(block) * m_RowsPerBlock * m_Dims[0];
+      int64_t lastPoint = std::min(static_cast<int64_t>(block + 1) * m_RowsPerBlock, numRows) * m_Dims[0];
+      int32_t gnum = 0;
+      for(int64_t seed = firstPoint; seed < lastPoint; seed++)
+      {
+        if(m_FeatureIds[seed] != 0 || !m_Filter->isSeedable(seed))
+        {
+          continue;
+        }
+        gnum++;
+        m_FeatureIds[seed] = gnum;
+        voxelslist.push_back(seed);
+        while(!voxelslist.empty())
+        {
+          int64_t currentpoint = voxelslist.back();
+          voxelslist.pop_back();
+          int64_t col = currentpoint % m_Dims[0];
+          int64_t row = (currentpoint / m_Dims[0]) % m_Dims[1];
+          int64_t plane = currentpoint / (m_Dims[0] * m_Dims[1]);
+          for(int32_t i = 0; i < 6; i++)
+          {
+            if((i == 0 && plane == 0) || (i == 5 && plane == (m_Dims[2] - 1)) || (i == 1 && row == 0) || (i == 4 && row == (m_Dims[1] - 1)) || (i == 2 && col == 0) ||
+               (i == 3 && col == (m_Dims[0] - 1)))
+            {
+              continue;
+            }
+            int64_t neighbor = currentpoint + neighpoints[i];
+            if(neighbor < firstPoint || neighbor >= lastPoint || m_FeatureIds[neighbor] != 0)
+            {
+              continue;
+            }
+            if(m_Filter->compareVoxels(currentpoint, neighbor))
+            {
+              m_FeatureIds[neighbor] = gnum;
+              voxelslist.push_back(neighbor);
+            }
+          }
+        }
+      }
+      m_BlockCounts[block] = gnum;
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    label(range.min(), range.max());
+  }
+
+private:
+  SegmentFeatures* m_Filter = nullptr;
+  int32_t* m_FeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int64_t m_RowsPerBlock = 1;
+  std::vector<int32_t>& m_BlockCounts;
+};
+
+/**
+ * @brief The SegmentFeaturesMergeSeamsImpl class compares every face that a block shares with the blocks
+ * before it and unites the provisional Features on either side when they should be grouped.
+ */
+class SegmentFeaturesMergeSeamsImpl
+{
+public:
+  SegmentFeaturesMergeSeamsImpl(SegmentFeatures* filter, int32_t* featureIds, const int64_t* dims, int64_t rowsPerBlock, const std::vector<int32_t>& blockOffsets, ConcurrentUnionFind& unionFind)
+  : m_Filter(filter)
+  , m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_RowsPerBlock(rowsPerBlock)
+  , m_BlockOffsets(blockOffsets)
+  , m_UnionFind(unionFind)
+  {
+  }
+
+  void merge(size_t start, size_t end) const
+  {
+    int64_t numRows = m_Dims[1] * m_Dims[2];
+    for(size_t block = start; block < end; block++)
+    {
+      if(m_Filter->getCancel())
+      {
+        return;
+      }
+      int64_t firstRow = static_cast<int64_t>(block) * m_RowsPerBlock;
+      int64_t lastRow = std::min(firstRow + m_RowsPerBlock, numRows);
+      // Only rows within one plane of the start of the block can have a face neighbor in an earlier block
+      int64_t seamEnd = std::min(lastRow, firstRow + m_Dims[1]);
+      for(int64_t r = firstRow; r < seamEnd; r++)
+      {
+        int64_t row = r % m_Dims[1];
+        int64_t plane = r / m_Dims[1];
+        for(int64_t col = 0; col < m_Dims[0]; col++)
+        {
+          int64_t point = r * m_Dims[0] + col;
+          if(m_FeatureIds[point] == 0)
+          {
+            continue;
+          }
+          if(plane > 0)
+          {
+            uniteIfGrouped(point, point - m_Dims[0] * m_Dims[1], block);
+          }
+          if(r == firstRow && row > 0)
+          {
+            uniteIfGrouped(point, point - m_Dims[0], block);
+          }
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    merge(range.min(), range.max());
+  }
+
+private:
+  SegmentFeatures* m_Filter = nullptr;
+  int32_t* m_FeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int64_t m_RowsPerBlock = 1;
+  const std::vector<int32_t>& m_BlockOffsets;
+  ConcurrentUnionFind& m_UnionFind;
+
+  void uniteIfGrouped(int64_t point, int64_t neighbor, size_t block) const
+  {
+    if(m_FeatureIds[neighbor] == 0 || !m_Filter->compareVoxels(point, neighbor))
+    {
+      return;
+    }
+    size_t neighborBlock = static_cast<size_t>((neighbor / m_Dims[0]) / m_RowsPerBlock);
+    m_UnionFind.unite(m_FeatureIds[point] + m_BlockOffsets[block], m_FeatureIds[neighbor] + m_BlockOffsets[neighborBlock]);
+  }
+};
+
+/**
+ * @brief The SegmentFeaturesRelabelImpl class replaces the block local Feature Ids with the final Feature Ids
+ */
+class SegmentFeaturesRelabelImpl
+{
+public:
+  SegmentFeaturesRelabelImpl(int32_t* featureIds, int64_t blockPoints, int64_t totalPoints, const std::vector<int32_t>& blockOffsets, const std::vector<int32_t>& newIds)
+  : m_FeatureIds(featureIds)
+  , m_BlockPoints(blockPoints)
+  , m_TotalPoints(totalPoints)
+  , m_BlockOffsets(blockOffsets)
+  , m_NewIds(newIds)
+  {
+  }
+
+  void relabel(size_t start, size_t end) const
+  {
+    for(size_t block = start; block < end; block++)
+    {
+      int64_t firstPoint = static_cast<int64_t>(block) * m_BlockPoints;
+      int64_t lastPoint = std::min(firstPoint + m_BlockPoints, m_TotalPoints);
+      int32_t offset = m_BlockOffsets[block];
+      for(int64_t point = firstPoint; point < lastPoint; point++)
+      {
+        if(m_FeatureIds[point] > 0)
+        {
+          m_FeatureIds[point] = m_NewIds[m_FeatureIds[point] + offset];
+        }
+      }
+    }
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    relabel(range.min(), range.max());
+  }
+
+private:
+  int32_t* m_FeatureIds = nullptr;
+  int64_t m_BlockPoints = 1;
+  int64_t m_TotalPoints = 0;
+  const std::vector<int32_t>& m_BlockOffsets;
+  const std::vector<int32_t>& m_NewIds;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -97,6 +308,100 @@ bool SegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighbor
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::isSeedable(int64_t point) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SegmentFeatures::compareVoxels(int64_t referencepoint, int64_t neighborpoint) const
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t SegmentFeatures::executeParallel(int32_t* featureIds)
+{
+  if(m_BlockVoxelCount <= 0)
+  {
+    return executeSerial();
+  }
+
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
+
+  SizeVec3Type udims = m->getGeometryAs<IGeometryGrid>()->getDimensions();
+
+  int64_t dims[3] = {
+      static_cast<int64_t>(udims[0]),
+      static_cast<int64_t>(udims[1]),
+      static_cast<int64_t>(udims[2]),
+  };
+
+  // Blocks are whole rows so that each block is a contiguous index range and the block local
+  // Feature Ids are ordered the same way as the seeds of the serial burn algorithm
+  int64_t numRows = dims[1] * dims[2];
+  int64_t rowsPerBlock = std::max(static_cast<int64_t>(1), m_BlockVoxelCount / dims[0]);
+  size_t numBlocks = static_cast<size_t>((numRows + rowsPerBlock - 1) / rowsPerBlock);
+
+  notifyStatusMessage("Labeling Blocks");
+  std::vector<int32_t> blockCounts(numBlocks, 0);
+  ParallelDataAlgorithm labelAlg;
+  labelAlg.setRange(0, numBlocks);
+  labelAlg.execute(SegmentFeaturesLabelBlocksImpl(this, featureIds, dims, rowsPerBlock, blockCounts));
+  if(getCancel())
+  {
+    return -1;
+  }
+
+  // Provisional Feature Ids are the block local Ids shifted by the number of Features in all earlier blocks
+  std::vector<int32_t> blockOffsets(numBlocks, 0);
+  int64_t provisionalCount = 0;
+  for(size_t block = 0; block < numBlocks; block++)
+  {
+    blockOffsets[block] = static_cast<int32_t>(provisionalCount);
+    provisionalCount += blockCounts[block];
+    if(provisionalCount >= std::numeric_limits<int32_t>::max())
+    {
+      setErrorCondition(-87001, "The number of provisional Features exceeds the range of the Feature Ids array");
+      return -1;
+    }
+  }
+
+  notifyStatusMessage("Merging Block Seams");
+  ConcurrentUnionFind unionFind(static_cast<size_t>(provisionalCount + 1));
+  ParallelDataAlgorithm mergeAlg;
+  mergeAlg.setRange(1, numBlocks);
+  mergeAlg.execute(SegmentFeaturesMergeSeamsImpl(this, featureIds, dims, rowsPerBlock, blockOffsets, unionFind));
+  if(getCancel())
+  {
+    return -1;
+  }
+
+  // Each root is the provisional Feature holding the smallest seed of its set, so numbering the roots in
+  // order reproduces the Feature Ids of the serial path
+  std::vector<int32_t> newIds(static_cast<size_t>(provisionalCount + 1), 0);
+  int32_t gnum = 1;
+  for(int32_t id = 1; id <= provisionalCount; id++)
+  {
+    int32_t root = unionFind.find(id);
+    newIds[id] = (root == id) ? gnum++ : newIds[root];
+  }
+
+  ParallelDataAlgorithm relabelAlg;
+  relabelAlg.setRange(0, numBlocks);
+  relabelAlg.execute(SegmentFeaturesRelabelImpl(featureIds, rowsPerBlock * dims[0], numRows * dims[0], blockOffsets, newIds));
+
+  notifyStatusMessage(QObject::tr("Total Features: %1").arg(gnum - 1));
+  return gnum;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -110,6 +415,14 @@ void SegmentFeatures::execute()
     return;
   }
 
+  executeSerial();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t SegmentFeatures::executeSerial()
+{
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   SizeVec3Type udims = m->getGeometryAs<IGeometryGrid>()->getDimensions();
@@ -215,9 +528,11 @@ void SegmentFeatures::execute()
     }
     if(getCancel())
     {
-      break;
+      return -1;
     }
   }
+
+  return gnum;
 }
 
 // -----------------------------------------------------------------------------
@@ -331,3 +646,15 @@ QString SegmentFeatures::getDataContainerName() const
 {
   return m_DataContainerName;
 }
+
+// -----------------------------------------------------------------------------
+void SegmentFeatures::setBlockVoxelCount(int64_t value)
+{
+  m_BlockVoxelCount = value;
+}
+
+// -----------------------------------------------------------------------------
+int64_t SegmentFeatures::getBlockVoxelCount() const
+{
+  return m_BlockVoxelCount;
+}
@@ -104,6 +104,18 @@ public:
 
   Q_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
 
+  /**
+   * @brief Setter property for BlockVoxelCount. The parallel segmentation labels blocks of whole rows holding about
+   * this many voxels as separate tasks, or uses the serial burn algorithm when it is 0. This is not a filter
+   * parameter; the Feature Ids do not depend on it.
+   */
+  void setBlockVoxelCount(int64_t value);
+  /**
+   * @brief Getter property for BlockVoxelCount
+   * @return Value of BlockVoxelCount
+   */
+  int64_t getBlockVoxelCount() const;
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -188,6 +200,40 @@ protected:
    */
   virtual bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum);
 
+  /**
+   * @brief isSeedable Determines if a point may start a new Feature. Used by the parallel segmentation path
+   * @param point Point to check
+   * @return Boolean check for whether the point may be a seed
+   */
+  virtual bool isSeedable(int64_t point) const;
+
+  /**
+   * @brief compareVoxels Side effect free form of determineGrouping used by the parallel segmentation path. The
+   * comparison must be symmetric and must only accept neighbors that are themselves seedable
+   * @param referencepoint Point of growing seed
+   * @param neighborpoint Point to be compared for adding
+   * @return Boolean check for whether the two points belong to the same Feature
+   */
+  virtual bool compareVoxels(int64_t referencepoint, int64_t neighborpoint) const;
+
+  /**
+   * @brief executeSerial Segments the grid with the serial burn algorithm, growing one Feature at a time from the
+   * seeds returned by getSeed. The Feature Attribute Matrix is not touched while the Features are grown, so callers
+   * size it once from the returned count.
+   * @return Number of Features including the 0 Feature, or -1 if the segmentation was canceled
+   */
+  int32_t executeSerial();
+
+  /**
+   * @brief executeParallel Segments the grid with a block parallel connected component labeling instead of the
+   * serial burn algorithm. Blocks of rows are labeled concurrently using compareVoxels, the block seams are merged
+   * with a lock free union-find and the Features are then renumbered so that the Feature Ids match the ones the
+   * serial path would produce. Falls back to executeSerial when BlockVoxelCount is 0.
+   * @param featureIds Zero initialized Feature Ids array that receives the segmentation
+   * @return Number of Features including the 0 Feature, or -1 if the segmentation was canceled or failed
+   */
+  int32_t executeParallel(int32_t* featureIds);
+
 public:
   SegmentFeatures(const SegmentFeatures&) = delete;            // Copy Constructor Not Implemented
   SegmentFeatures(SegmentFeatures&&) = delete;                 // Move Constructor Not Implemented
@@ -196,4 +242,8 @@ public:
 
 private:
   QString m_DataContainerName = {SIMPL::Defaults::ImageDataContainerName};
+  int64_t m_BlockVoxelCount = 262144;
+
+  friend class SegmentFeaturesLabelBlocksImpl;
+  friend class SegmentFeaturesMergeSeamsImpl;
 };
@@ -244,7 +244,15 @@ void SineParamsSegmentFeatures::execute()
   const size_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  // Grow all of the Features first and size the Feature Attribute Matrix once at the end
+  int32_t totalSegmented = executeSerial();
+  if(totalSegmented < 0)
+  {
+    return;
+  }
+  tDims[0] = static_cast<size_t>(totalSegmented);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->getNumberOfTuples();
   if(totalFeatures < 2)
@@ -312,7 +320,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -339,9 +346,6 @@ int64_t SineParamsSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
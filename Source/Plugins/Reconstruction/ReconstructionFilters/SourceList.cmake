@@ -36,6 +36,7 @@ set(_PublicFilters
   AlignSectionsList
   AlignSectionsMisorientation
   AlignSectionsMutualInformation
+  AlignSectionsPhaseCorrelation
   CAxisSegmentFeatures
   EBSDSegmentFeatures
   MergeColonies
@@ -77,5 +78,7 @@ foreach(f ${_PrivateFilters} )
                         ${${PLUGIN_NAME}_SOURCE_DIR}/Documentation/${_filterGroupName}/${f}.md FALSE)
 endforeach()
 
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/ConcurrentUnionFind.h)
+
 SIMPL_END_FILTER_GROUP(${Reconstruction_BINARY_DIR} "${_filterGroupName}" "Reconstruction Filters")
 
@@ -265,7 +265,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 {
   clearErrorCode();
   clearWarningCode();
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   int64_t seed = -1;
@@ -292,9 +291,6 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
   if(seed >= 0)
   {
     m_FeatureIds[seed] = gnum;
-    std::vector<size_t> tDims(1, gnum + 1);
-    m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
-    updateFeatureInstancePointers();
   }
   return seed;
 }
@@ -303,11 +299,32 @@ int64_t VectorSegmentFeatures::getSeed(int32_t gnum, int64_t nextSeed)
 //
 // -----------------------------------------------------------------------------
 bool VectorSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum)
+{
+  if(m_FeatureIds[neighborpoint] == 0 && compareVoxels(referencepoint, neighborpoint))
+  {
+    m_FeatureIds[neighborpoint] = gnum;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::isSeedable(int64_t point) const
+{
+  return !m_UseGoodVoxels || m_GoodVoxels[point];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VectorSegmentFeatures::compareVoxels(int64_t referencepoint, int64_t neighborpoint) const
 {
   bool group = false;
   float v1[3] = {0.0f, 0.0f, 0.0f};
   float v2[3] = {0.0f, 0.0f, 0.0f};
-  if(m_FeatureIds[neighborpoint] == 0 && (!m_UseGoodVoxels || m_GoodVoxels[neighborpoint]))
+  if(!m_UseGoodVoxels || m_GoodVoxels[neighborpoint])
   {
     v1[0] = m_Vectors[3 * referencepoint + 0];
     v1[1] = m_Vectors[3 * referencepoint + 1];
@@ -332,7 +349,6 @@ bool VectorSegmentFeatures::determineGrouping(int64_t referencepoint, int64_t ne
     if(w < m_AngleToleranceRad)
     {
       group = true;
-      m_FeatureIds[neighborpoint] = gnum;
     }
   }
   return group;
@@ -377,7 +393,15 @@ void VectorSegmentFeatures::execute()
   const int64_t rangeMax = totalPoints - 1;
   initializeVoxelSeedGenerator(rangeMin, rangeMax);
 
-  SegmentFeatures::execute();
+  // Segment with the block parallel labeling; it produces the same Features as the serial burn algorithm
+  int32_t totalSegmented = executeParallel(m_FeatureIds);
+  if(totalSegmented < 0)
+  {
+    return;
+  }
+  tDims[0] = static_cast<size_t>(totalSegmented);
+  m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   int32_t totalFeatures = static_cast<int32_t>(m->getAttributeMatrix(getCellFeatureAttributeMatrixName())->getNumberOfTuples());
   if(totalFeatures < 2)
@@ -268,6 +268,16 @@ protected:
    */
   bool determineGrouping(int64_t referencepoint, int64_t neighborpoint, int32_t gnum) override;
 
+  /**
+   * @brief isSeedable Reimplemented from @see SegmentFeatures class
+   */
+  bool isSeedable(int64_t point) const override;
+
+  /**
+   * @brief compareVoxels Reimplemented from @see SegmentFeatures class
+   */
+  bool compareVoxels(int64_t referencepoint, int64_t neighborpoint) const override;
+
 private:
   std::weak_ptr<DataArray<float>> m_VectorsPtr;
   float* m_Vectors = nullptr;
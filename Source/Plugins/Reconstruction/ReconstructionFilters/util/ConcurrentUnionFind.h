@@ -0,0 +1,98 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The ConcurrentUnionFind class is a lock free disjoint set over the ids [0, size). Sets are always linked
+ * under their smallest member, so the final roots do not depend on the order in which threads merge them and a
+ * root is always the smallest id of its set.
+ */
+class ConcurrentUnionFind
+{
+public:
+  explicit ConcurrentUnionFind(size_t size)
+  : m_Parents(size)
+  {
+    for(size_t i = 0; i < size; i++)
+    {
+      m_Parents[i].store(static_cast<int32_t>(i), std::memory_order_relaxed);
+    }
+  }
+
+  int32_t find(int32_t id)
+  {
+    int32_t parent = m_Parents[id].load();
+    while(parent != id)
+    {
+      // Path halving; parents only ever move towards smaller ids so a failed exchange is harmless
+      int32_t grandParent = m_Parents[parent].load();
+      m_Parents[id].compare_exchange_weak(parent, grandParent);
+      id = grandParent;
+      parent = m_Parents[id].load();
+    }
+    return id;
+  }
+
+  void unite(int32_t id1, int32_t id2)
+  {
+    while(true)
+    {
+      id1 = find(id1);
+      id2 = find(id2);
+      if(id1 == id2)
+      {
+        return;
+      }
+      if(id1 > id2)
+      {
+        std::swap(id1, id2);
+      }
+      int32_t expected = id2;
+      if(m_Parents[id2].compare_exchange_strong(expected, id1))
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<int32_t>> m_Parents;
+};
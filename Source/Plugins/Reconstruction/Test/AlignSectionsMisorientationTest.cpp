@@ -0,0 +1,210 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "Reconstruction/ReconstructionFilters/AlignSectionsMisorientation.h"
+#include "Reconstruction/Test/ReconstructionTestFileLocations.h"
+#include "Reconstruction/Test/UnitTestSupport.hpp"
+
+class AlignSectionsMisorientationTest
+{
+
+public:
+  AlignSectionsMisorientationTest() = default;
+  ~AlignSectionsMisorientationTest() = default;
+  AlignSectionsMisorientationTest(const AlignSectionsMisorientationTest&) = delete;            // Copy Constructor
+  AlignSectionsMisorientationTest(AlignSectionsMisorientationTest&&) = delete;                 // Move Constructor
+  AlignSectionsMisorientationTest& operator=(const AlignSectionsMisorientationTest&) = delete; // Copy Assignment
+  AlignSectionsMisorientationTest& operator=(AlignSectionsMisorientationTest&&) = delete;      // Move Assignment
+
+  // 128 cells per side gives the multi-resolution search two coarse levels
+  const int64_t k_XDim = 128;
+  const int64_t k_YDim = 128;
+  const int64_t k_ZDim = 3;
+  // Offset of the grain map in each section. These are also the shifts an exhaustive search over every candidate
+  // position finds, and the top section is the reference and is not moved.
+  const int64_t k_XOffsets[3] = {5, -14, 0};
+  const int64_t k_YOffsets[3] = {-4, 11, 0};
+  const QString k_GrainIdsName = QString("GrainIds");
+
+  // -----------------------------------------------------------------------------
+  // Voronoi grain map of eight grains
+  // -----------------------------------------------------------------------------
+  int32_t grainId(int64_t x, int64_t y) const
+  {
+    const double seeds[8][2] = {{20.0, 30.0}, {70.0, 15.0}, {110.0, 40.0}, {40.0, 80.0}, {90.0, 75.0}, {15.0, 120.0}, {64.0, 115.0}, {118.0, 105.0}};
+    int32_t nearest = 0;
+    double nearestDistance = std::numeric_limits<double>::max();
+    for(int32_t i = 0; i < 8; i++)
+    {
+      double dx = static_cast<double>(x) - seeds[i][0];
+      double dy = static_cast<double>(y) - seeds[i][1];
+      double distance = dx * dx + dy * dy;
+      if(distance < nearestDistance)
+      {
+        nearest = i;
+        nearestDistance = distance;
+      }
+    }
+    return nearest + 1;
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(k_XDim, k_YDim, k_ZDim));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {static_cast<size_t>(k_XDim), static_cast<size_t>(k_YDim), static_cast<size_t>(k_ZDim)};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    size_t totalPoints = static_cast<size_t>(k_XDim * k_YDim * k_ZDim);
+    Int32ArrayType::Pointer grainIds = Int32ArrayType::CreateArray(totalPoints, k_GrainIdsName, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases, true);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 4), SIMPL::CellData::Quats, true);
+    phases->initializeWithValue(1);
+    for(int64_t z = 0; z < k_ZDim; z++)
+    {
+      for(int64_t y = 0; y < k_YDim; y++)
+      {
+        for(int64_t x = 0; x < k_XDim; x++)
+        {
+          size_t index = static_cast<size_t>((z * k_YDim + y) * k_XDim + x);
+          int32_t grain = grainId(x - k_XOffsets[z], y - k_YOffsets[z]);
+          grainIds->setValue(index, grain);
+
+          // Each grain is rotated about Z by a multiple of 11 degrees, so any two grains are more than the 5 degree
+          // tolerance apart under cubic symmetry
+          double halfAngle = 0.5 * 11.0 * static_cast<double>(grain) * SIMPLib::Constants::k_PiOver180D;
+          quats->setComponent(index, 0, 0.0f);
+          quats->setComponent(index, 1, 0.0f);
+          quats->setComponent(index, 2, static_cast<float>(std::sin(halfAngle)));
+          quats->setComponent(index, 3, static_cast<float>(std::cos(halfAngle)));
+        }
+      }
+    }
+    cellAM->insertOrAssign(grainIds);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(quats);
+
+    tDims = {2};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // After alignment every section must hold the grain map of the top section wherever its shifted source lies inside
+  // the section, and the cells shifted in from outside are zero
+  // -----------------------------------------------------------------------------
+  int runAlignment(bool useMultiResolutionSearch)
+  {
+    DataContainerArray::Pointer dca = createTestData();
+
+    AlignSectionsMisorientation::Pointer filter = AlignSectionsMisorientation::New();
+    filter->setDataContainerArray(dca);
+    filter->setQuatsArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats));
+    filter->setCellPhasesArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases));
+    filter->setCrystalStructuresArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures));
+    filter->setUseGoodVoxels(false);
+    filter->setMisorientationTolerance(5.0f);
+    filter->setUseMultiResolutionSearch(useMultiResolutionSearch);
+    filter->setWriteAlignmentShifts(false);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    Int32ArrayType::Pointer grainIds =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<Int32ArrayType>(k_GrainIdsName);
+    DREAM3D_REQUIRE_VALID_POINTER(grainIds.get())
+
+    for(int64_t z = 0; z < k_ZDim; z++)
+    {
+      for(int64_t y = 0; y < k_YDim; y++)
+      {
+        for(int64_t x = 0; x < k_XDim; x++)
+        {
+          int64_t sourceX = x + k_XOffsets[z];
+          int64_t sourceY = y + k_YOffsets[z];
+          bool inside = sourceX >= 0 && sourceX < k_XDim && sourceY >= 0 && sourceY < k_YDim;
+          int32_t expected = inside ? grainId(x, y) : 0;
+          DREAM3D_REQUIRE_EQUAL(grainIds->getValue(static_cast<size_t>((z * k_YDim + y) * k_XDim + x)), expected)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestFullResolutionSearch()
+  {
+    return runAlignment(false);
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestMultiResolutionSearch()
+  {
+    return runAlignment(true);
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFullResolutionSearch())
+    DREAM3D_REGISTER_TEST(TestMultiResolutionSearch())
+  }
+};
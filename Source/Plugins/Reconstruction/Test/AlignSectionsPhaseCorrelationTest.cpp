@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "Reconstruction/ReconstructionFilters/AlignSectionsPhaseCorrelation.h"
+#include "Reconstruction/Test/ReconstructionTestFileLocations.h"
+#include "Reconstruction/Test/UnitTestSupport.hpp"
+
+class AlignSectionsPhaseCorrelationTest
+{
+
+public:
+  AlignSectionsPhaseCorrelationTest() = default;
+  ~AlignSectionsPhaseCorrelationTest() = default;
+  AlignSectionsPhaseCorrelationTest(const AlignSectionsPhaseCorrelationTest&) = delete;            // Copy Constructor
+  AlignSectionsPhaseCorrelationTest(AlignSectionsPhaseCorrelationTest&&) = delete;                 // Move Constructor
+  AlignSectionsPhaseCorrelationTest& operator=(const AlignSectionsPhaseCorrelationTest&) = delete; // Copy Assignment
+  AlignSectionsPhaseCorrelationTest& operator=(AlignSectionsPhaseCorrelationTest&&) = delete;      // Move Assignment
+
+  const int64_t k_XDim = 32;
+  const int64_t k_YDim = 32;
+  const int64_t k_ZDim = 4;
+  // Offset of the pattern in each section. The top section is the reference and is not moved.
+  const int64_t k_XOffsets[4] = {4, 1, -1, 0};
+  const int64_t k_YOffsets[4] = {-3, -1, 2, 0};
+
+  // -----------------------------------------------------------------------------
+  // Three Gaussian spots of different sizes, so the pattern has a single best match
+  // -----------------------------------------------------------------------------
+  float pattern(double x, double y) const
+  {
+    double spot1 = 100.0 * std::exp(-((x - 20.0) * (x - 20.0) + (y - 14.0) * (y - 14.0)) / 18.0);
+    double spot2 = 60.0 * std::exp(-((x - 11.0) * (x - 11.0) + (y - 22.0) * (y - 22.0)) / 8.0);
+    double spot3 = 40.0 * std::exp(-((x - 24.0) * (x - 24.0) + (y - 24.0) * (y - 24.0)) / 12.0);
+    return static_cast<float>(spot1 + spot2 + spot3);
+  }
+
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(k_XDim, k_YDim, k_ZDim));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {static_cast<size_t>(k_XDim), static_cast<size_t>(k_YDim), static_cast<size_t>(k_ZDim)};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    FloatArrayType::Pointer intensity = FloatArrayType::CreateArray(tDims, std::vector<size_t>(1, 1), std::string("Intensity"), true);
+    for(int64_t z = 0; z < k_ZDim; z++)
+    {
+      for(int64_t y = 0; y < k_YDim; y++)
+      {
+        for(int64_t x = 0; x < k_XDim; x++)
+        {
+          intensity->setValue((z * k_YDim + y) * k_XDim + x, pattern(static_cast<double>(x - k_XOffsets[z]), static_cast<double>(y - k_YOffsets[z])));
+        }
+      }
+    }
+    cellAM->insertOrAssign(intensity);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // After alignment every section must match the top section wherever its shifted source lies inside the section,
+  // and the cells shifted in from outside are zero
+  // -----------------------------------------------------------------------------
+  int TestSyntheticShift()
+  {
+    DataContainerArray::Pointer dca = createTestData();
+
+    AlignSectionsPhaseCorrelation::Pointer filter = AlignSectionsPhaseCorrelation::New();
+    filter->setDataContainerArray(dca);
+    filter->setSelectedArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "Intensity"));
+    filter->setUseGoodVoxels(false);
+    filter->setWriteAlignmentShifts(false);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    FloatArrayType::Pointer intensity =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<FloatArrayType>("Intensity");
+    DREAM3D_REQUIRE_VALID_POINTER(intensity.get())
+
+    for(int64_t z = 0; z < k_ZDim; z++)
+    {
+      for(int64_t y = 0; y < k_YDim; y++)
+      {
+        for(int64_t x = 0; x < k_XDim; x++)
+        {
+          int64_t sourceX = x + k_XOffsets[z];
+          int64_t sourceY = y + k_YOffsets[z];
+          bool inside = sourceX >= 0 && sourceX < k_XDim && sourceY >= 0 && sourceY < k_YDim;
+          float expected = inside ? pattern(static_cast<double>(x), static_cast<double>(y)) : 0.0f;
+          DREAM3D_REQUIRE_EQUAL(intensity->getValue((z * k_YDim + y) * k_XDim + x), expected)
+        }
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSyntheticShift())
+  }
+};
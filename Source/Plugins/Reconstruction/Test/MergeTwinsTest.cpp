@@ -0,0 +1,208 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+
+#include <QtCore/QFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "Reconstruction/ReconstructionFilters/MergeTwins.h"
+#include "Reconstruction/Test/ReconstructionTestFileLocations.h"
+#include "Reconstruction/Test/UnitTestSupport.hpp"
+
+namespace
+{
+const QString k_DataContainerName("DataContainer");
+const QString k_CellDataName("CellData");
+const QString k_FeatureDataName("CellFeatureData");
+const QString k_EnsembleDataName("CellEnsembleData");
+} // namespace
+
+class MergeTwinsTest
+{
+
+public:
+  MergeTwinsTest() = default;
+  ~MergeTwinsTest() = default;
+  MergeTwinsTest(const MergeTwinsTest&) = delete;            // Copy Constructor
+  MergeTwinsTest(MergeTwinsTest&&) = delete;                 // Move Constructor
+  MergeTwinsTest& operator=(const MergeTwinsTest&) = delete; // Copy Assignment
+  MergeTwinsTest& operator=(MergeTwinsTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  void setNeighborList(NeighborList<int32_t>& neighborList, int32_t feature, const std::vector<int32_t>& neighbors)
+  {
+    NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>(neighbors));
+    neighborList.setList(feature, list);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Four Features in a row of Cells. Features 1, 2 and 4 share an orientation and Feature 3 is their 60 degree <111>
+  // twin. The contiguous neighbors are 1-3 and 1-4, so only Features 1 and 3 are twins through them. Feature 3 also
+  // lists Feature 2 as a non-contiguous neighbor, but Feature 2 does not list Feature 3 back.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(4, 1, 1));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {4, 1, 1};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, k_CellDataName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(4, SIMPL::CellData::FeatureIds, true);
+    for(size_t i = 0; i < 4; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i + 1));
+    }
+    cellAM->insertOrAssign(featureIds);
+
+    tDims = {5};
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(tDims, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(5, SIMPL::FeatureData::Phases, true);
+    phases->initializeWithValue(1);
+    phases->setValue(0, 0);
+    featureAM->insertOrAssign(phases);
+
+    std::vector<size_t> cDims = {4};
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(5, cDims, SIMPL::FeatureData::AvgQuats, true);
+    const float twin = 0.5f / std::sqrt(3.0f);
+    const float identityQuat[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    const float twinQuat[4] = {twin, twin, twin, std::sqrt(3.0f) * 0.5f};
+    for(size_t feature = 0; feature < 5; feature++)
+    {
+      const float* quat = (feature == 3) ? twinQuat : identityQuat;
+      for(size_t c = 0; c < 4; c++)
+      {
+        avgQuats->setComponent(feature, c, quat[c]);
+      }
+    }
+    featureAM->insertOrAssign(avgQuats);
+
+    NeighborList<int32_t>::Pointer contiguousNeighbors = NeighborList<int32_t>::CreateArray(5, SIMPL::FeatureData::NeighborList, true);
+    setNeighborList(*contiguousNeighbors, 0, {});
+    setNeighborList(*contiguousNeighbors, 1, {3, 4});
+    setNeighborList(*contiguousNeighbors, 2, {});
+    setNeighborList(*contiguousNeighbors, 3, {1});
+    setNeighborList(*contiguousNeighbors, 4, {1});
+    featureAM->insertOrAssign(contiguousNeighbors);
+
+    NeighborList<int32_t>::Pointer nonContiguousNeighbors = NeighborList<int32_t>::CreateArray(5, SIMPL::FeatureData::NeighborhoodList, true);
+    setNeighborList(*nonContiguousNeighbors, 0, {});
+    setNeighborList(*nonContiguousNeighbors, 1, {});
+    setNeighborList(*nonContiguousNeighbors, 2, {});
+    setNeighborList(*nonContiguousNeighbors, 3, {2});
+    setNeighborList(*nonContiguousNeighbors, 4, {});
+    featureAM->insertOrAssign(nonContiguousNeighbors);
+
+    tDims = {2};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(tDims, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  Int32ArrayType::Pointer runMergeTwins(bool useNonContiguousNeighbors)
+  {
+    DataContainerArray::Pointer dca = createTestData();
+
+    MergeTwins::Pointer filter = MergeTwins::New();
+    filter->setDataContainerArray(dca);
+    filter->setUseNonContiguousNeighbors(useNonContiguousNeighbors);
+    filter->setContiguousNeighborListArrayPath(DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::NeighborList));
+    filter->setNonContiguousNeighborListArrayPath(DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::NeighborhoodList));
+    filter->setFeatureIdsArrayPath(DataArrayPath(k_DataContainerName, k_CellDataName, SIMPL::CellData::FeatureIds));
+    filter->setFeaturePhasesArrayPath(DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::Phases));
+    filter->setAvgQuatsArrayPath(DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::AvgQuats));
+    filter->setCrystalStructuresArrayPath(DataArrayPath(k_DataContainerName, k_EnsembleDataName, SIMPL::EnsembleData::CrystalStructures));
+    filter->setAxisTolerance(5.0f);
+    filter->setAngleTolerance(5.0f);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    Int32ArrayType::Pointer parentIds = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_FeatureDataName, ""))->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::ParentIds);
+    DREAM3D_REQUIRE_VALID_POINTER(parentIds.get())
+    return parentIds;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The parent ids are shuffled after the grouping, so only which Features share a parent is checked
+  // -----------------------------------------------------------------------------
+  int TestContiguousNeighbors()
+  {
+    Int32ArrayType::Pointer parentIds = runMergeTwins(false);
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(0), 0)
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(1), parentIds->getValue(3))
+    DREAM3D_REQUIRE_NE(parentIds->getValue(1), parentIds->getValue(2))
+    DREAM3D_REQUIRE_NE(parentIds->getValue(1), parentIds->getValue(4))
+    DREAM3D_REQUIRE_NE(parentIds->getValue(2), parentIds->getValue(4))
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestAsymmetricNonContiguousNeighbors()
+  {
+    Int32ArrayType::Pointer parentIds = runMergeTwins(true);
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(0), 0)
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(1), parentIds->getValue(3))
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(2), parentIds->getValue(3))
+    DREAM3D_REQUIRE_NE(parentIds->getValue(1), parentIds->getValue(4))
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestContiguousNeighbors())
+    DREAM3D_REGISTER_TEST(TestAsymmetricNonContiguousNeighbors())
+  }
+};
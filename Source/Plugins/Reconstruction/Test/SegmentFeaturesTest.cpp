@@ -0,0 +1,448 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "EbsdLib/Core/EbsdLibConstants.h"
+
+#include "Reconstruction/ReconstructionFilters/CAxisSegmentFeatures.h"
+#include "Reconstruction/ReconstructionFilters/EBSDSegmentFeatures.h"
+#include "Reconstruction/ReconstructionFilters/ScalarSegmentFeatures.h"
+#include "Reconstruction/ReconstructionFilters/VectorSegmentFeatures.h"
+#include "Reconstruction/Test/ReconstructionTestFileLocations.h"
+#include "Reconstruction/Test/UnitTestSupport.hpp"
+
+class SegmentFeaturesTest
+{
+public:
+  SegmentFeaturesTest() = default;
+  ~SegmentFeaturesTest() = default;
+  SegmentFeaturesTest(const SegmentFeaturesTest&) = delete;            // Copy Constructor
+  SegmentFeaturesTest(SegmentFeaturesTest&&) = delete;                 // Move Constructor
+  SegmentFeaturesTest& operator=(const SegmentFeaturesTest&) = delete; // Copy Assignment
+  SegmentFeaturesTest& operator=(SegmentFeaturesTest&&) = delete;      // Move Assignment
+
+  enum class Segmenter
+  {
+    Scalar,
+    Vector,
+    EBSD,
+    CAxis
+  };
+
+  // Cells with the same label belong to the same Feature and Cells with different labels never do. Cells that are not
+  // good, or that have phase 0, can not seed or join a Feature.
+  struct Fixture
+  {
+    size_t dims[3] = {1, 1, 1};
+    std::vector<int32_t> labels;
+    std::vector<bool> good;
+    std::vector<int32_t> phases;
+  };
+
+  const QString k_ScalarsName = QString("Scalars");
+  const QString k_VectorsName = QString("Vectors");
+
+  // -----------------------------------------------------------------------------
+  // A spiral arm at z = 0 whose two ends are joined through a U at z = 1, and a bar at z = 2 that joins both legs of
+  // the U. Labeled one row at a time, every part of Feature 1 only meets the rest of it across block seams.
+  // -----------------------------------------------------------------------------
+  Fixture createSpiral(int unseedable)
+  {
+    const char* k_Spiral[9] = {"111111111", "000000001", "111111101", "100000101", "101110101", "101000101", "101111101", "100000001", "111111111"};
+
+    Fixture fixture;
+    fixture.dims[0] = 9;
+    fixture.dims[1] = 9;
+    fixture.dims[2] = 3;
+    fixture.labels.resize(243);
+    fixture.good.assign(243, true);
+    fixture.phases.assign(243, 1);
+    for(size_t z = 0; z < 3; z++)
+    {
+      for(size_t y = 0; y < 9; y++)
+      {
+        for(size_t x = 0; x < 9; x++)
+        {
+          size_t index = (z * 9 + y) * 9 + x;
+          int32_t label = 3;
+          if(z == 0)
+          {
+            label = (k_Spiral[y][x] == '1') ? 1 : 2;
+          }
+          else if(z == 1)
+          {
+            label = (x == 0 || x == 8 || y == 8) ? 1 : 3;
+          }
+          else if(y == 0)
+          {
+            label = 1;
+          }
+          fixture.labels[index] = label;
+
+          // A masked row cuts through the spiral, so the masked Cells split Features that would otherwise be whole
+          if(unseedable > 0 && ((y == 4 && x < 7 && z < 2) || (x * 5 + y * 3 + z) % 13 == 0))
+          {
+            fixture.good[index] = false;
+          }
+          if(unseedable > 1 && (x + 2 * y + z) % 11 == 5)
+          {
+            fixture.phases[index] = 0;
+          }
+        }
+      }
+    }
+    return fixture;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Diagonal bands three Cells wide, so each band crosses many rows and one row per block gives many more blocks than
+  // there are threads
+  // -----------------------------------------------------------------------------
+  Fixture createBands()
+  {
+    Fixture fixture;
+    fixture.dims[0] = 6;
+    fixture.dims[1] = 30;
+    fixture.dims[2] = 5;
+    size_t totalPoints = 900;
+    fixture.labels.resize(totalPoints);
+    fixture.good.assign(totalPoints, true);
+    fixture.phases.assign(totalPoints, 1);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      size_t x = i % 6;
+      size_t y = (i / 6) % 30;
+      size_t z = i / 180;
+      fixture.labels[i] = static_cast<int32_t>(((x + y + z) / 3) % 2);
+    }
+    return fixture;
+  }
+
+  // -----------------------------------------------------------------------------
+  // A volume that is a single line of Cells along x, y or z
+  // -----------------------------------------------------------------------------
+  Fixture createLine(size_t dimX, size_t dimY, size_t dimZ)
+  {
+    Fixture fixture;
+    fixture.dims[0] = dimX;
+    fixture.dims[1] = dimY;
+    fixture.dims[2] = dimZ;
+    size_t totalPoints = dimX * dimY * dimZ;
+    fixture.labels.resize(totalPoints);
+    fixture.good.assign(totalPoints, true);
+    fixture.phases.assign(totalPoints, 1);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      fixture.labels[i] = static_cast<int32_t>((i / 3) % 2 + (i % 7 == 0 ? 2 : 0));
+    }
+    return fixture;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Labels that step by small amounts, so with a tolerance of 1 the Scalar segmentation chains Cells whose labels differ
+  // by more than the tolerance through the Cells between them
+  // -----------------------------------------------------------------------------
+  Fixture createNoise()
+  {
+    Fixture fixture;
+    fixture.dims[0] = 7;
+    fixture.dims[1] = 11;
+    fixture.dims[2] = 4;
+    size_t totalPoints = 308;
+    fixture.labels.resize(totalPoints);
+    fixture.good.assign(totalPoints, true);
+    fixture.phases.assign(totalPoints, 1);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      size_t x = i % 7;
+      size_t y = (i / 7) % 11;
+      size_t z = i / 77;
+      fixture.labels[i] = static_cast<int32_t>((x * y + z * 3) % 7);
+    }
+    return fixture;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Labels 0 to 3 map to orientations at least 15 degrees apart, to c-axes at least 20 degrees apart and to vectors at
+  // least 36 degrees apart. The vectors have exact integer lengths so equal vectors compare at exactly 0 degrees.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData(const Fixture& fixture, Segmenter segmenter)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(fixture.dims[0], fixture.dims[1], fixture.dims[2]));
+    dc->setGeometry(imageGeom);
+
+    size_t totalPoints = fixture.labels.size();
+    std::vector<size_t> tDims = {fixture.dims[0], fixture.dims[1], fixture.dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+
+    const float k_Vectors[4][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {3.0f, 4.0f, 0.0f}};
+
+    Int32ArrayType::Pointer scalars = Int32ArrayType::CreateArray(totalPoints, k_ScalarsName, true);
+    FloatArrayType::Pointer vectors = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 3), k_VectorsName, true);
+    FloatArrayType::Pointer quats = FloatArrayType::CreateArray(totalPoints, std::vector<size_t>(1, 4), SIMPL::CellData::Quats, true);
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(totalPoints, SIMPL::CellData::Phases, true);
+    BoolArrayType::Pointer mask = BoolArrayType::CreateArray(totalPoints, SIMPL::CellData::Mask, true);
+    for(size_t i = 0; i < totalPoints; i++)
+    {
+      int32_t label = fixture.labels[i];
+      scalars->setValue(i, label);
+      phases->setValue(i, fixture.phases[i]);
+      mask->setValue(i, fixture.good[i]);
+
+      const float* vector = k_Vectors[label % 4];
+      for(size_t c = 0; c < 3; c++)
+      {
+        vectors->setComponent(i, c, vector[c]);
+      }
+
+      // EBSD rotates about z by 15 degree steps and CAxis tilts the c-axis about x by 20 degree steps. The quaternions
+      // are stored as (x, y, z, w).
+      float halfAngle = static_cast<float>(label) * ((segmenter == Segmenter::CAxis) ? 10.0f : 7.5f) * SIMPLib::Constants::k_PiOver180F;
+      float quat[4] = {0.0f, 0.0f, std::sin(halfAngle), std::cos(halfAngle)};
+      if(segmenter == Segmenter::CAxis)
+      {
+        quat[0] = quat[2];
+        quat[2] = 0.0f;
+      }
+      for(size_t c = 0; c < 4; c++)
+      {
+        quats->setComponent(i, c, quat[c]);
+      }
+    }
+    cellAM->insertOrAssign(scalars);
+    cellAM->insertOrAssign(vectors);
+    cellAM->insertOrAssign(quats);
+    cellAM->insertOrAssign(phases);
+    cellAM->insertOrAssign(mask);
+
+    tDims = {2};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(2, SIMPL::EnsembleData::CrystalStructures, true);
+    crystalStructures->setValue(0, EbsdLib::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, (segmenter == Segmenter::CAxis) ? EbsdLib::CrystalStructure::Hexagonal_High : EbsdLib::CrystalStructure::Cubic_High);
+    ensembleAM->insertOrAssign(crystalStructures);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  SegmentFeatures::Pointer createSegmenter(Segmenter segmenter, float tolerance)
+  {
+    DataArrayPath cellPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, "");
+    DataArrayPath maskPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Mask);
+    DataArrayPath phasesPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases);
+    DataArrayPath quatsPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Quats);
+    DataArrayPath crystalStructuresPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, SIMPL::EnsembleData::CrystalStructures);
+
+    if(segmenter == Segmenter::Scalar)
+    {
+      ScalarSegmentFeatures::Pointer filter = ScalarSegmentFeatures::New();
+      filter->setScalarArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, k_ScalarsName));
+      filter->setScalarTolerance(tolerance);
+      filter->setCellFeatureAttributeMatrixName(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      filter->setUseGoodVoxels(true);
+      filter->setGoodVoxelsArrayPath(maskPath);
+      filter->setFeatureIdsArrayName(SIMPL::CellData::FeatureIds);
+      filter->setActiveArrayName(SIMPL::FeatureData::Active);
+      filter->setRandomizeFeatureIds(false);
+      return filter;
+    }
+    if(segmenter == Segmenter::Vector)
+    {
+      VectorSegmentFeatures::Pointer filter = VectorSegmentFeatures::New();
+      filter->setSelectedVectorArrayPath(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, k_VectorsName));
+      filter->setAngleTolerance(tolerance);
+      filter->setCellFeatureAttributeMatrixName(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      filter->setUseGoodVoxels(true);
+      filter->setGoodVoxelsArrayPath(maskPath);
+      filter->setFeatureIdsArrayName(SIMPL::CellData::FeatureIds);
+      filter->setActiveArrayName(SIMPL::FeatureData::Active);
+      filter->setRandomizeFeatureIds(false);
+      return filter;
+    }
+    if(segmenter == Segmenter::EBSD)
+    {
+      EBSDSegmentFeatures::Pointer filter = EBSDSegmentFeatures::New();
+      filter->setMisorientationTolerance(tolerance);
+      filter->setCellPhasesArrayPath(phasesPath);
+      filter->setQuatsArrayPath(quatsPath);
+      filter->setCrystalStructuresArrayPath(crystalStructuresPath);
+      filter->setCellFeatureAttributeMatrixName(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+      filter->setUseGoodVoxels(true);
+      filter->setGoodVoxelsArrayPath(maskPath);
+      filter->setFeatureIdsArrayName(SIMPL::CellData::FeatureIds);
+      filter->setActiveArrayName(SIMPL::FeatureData::Active);
+      filter->setRandomizeFeatureIds(false);
+      return filter;
+    }
+
+    CAxisSegmentFeatures::Pointer filter = CAxisSegmentFeatures::New();
+    filter->setMisorientationTolerance(tolerance);
+    filter->setCellPhasesArrayPath(phasesPath);
+    filter->setQuatsArrayPath(quatsPath);
+    filter->setCrystalStructuresArrayPath(crystalStructuresPath);
+    filter->setCellFeatureAttributeMatrixName(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    filter->setUseGoodVoxels(true);
+    filter->setGoodVoxelsArrayPath(maskPath);
+    filter->setFeatureIdsArrayName(SIMPL::CellData::FeatureIds);
+    filter->setActiveArrayName(SIMPL::FeatureData::Active);
+    filter->setRandomizeFeatureIds(false);
+    return filter;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs one segmentation and returns the Feature Ids. The number of Features, counting Feature 0, is returned through
+  // numFeatures.
+  // -----------------------------------------------------------------------------
+  std::vector<int32_t> runSegmentation(const Fixture& fixture, Segmenter segmenter, float tolerance, int64_t blockVoxelCount, size_t& numFeatures)
+  {
+    DataContainerArray::Pointer dca = createTestData(fixture, segmenter);
+
+    SegmentFeatures::Pointer filter = createSegmenter(segmenter, tolerance);
+    filter->setDataContainerArray(dca);
+    filter->setBlockVoxelCount(blockVoxelCount);
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    AttributeMatrix::Pointer cellAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""));
+    Int32ArrayType::Pointer featureIds = cellAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::CellData::FeatureIds);
+    DREAM3D_REQUIRE_VALID_POINTER(featureIds.get())
+
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE_VALID_POINTER(featureAM.get())
+    numFeatures = featureAM->getNumberOfTuples();
+
+    int32_t* ids = featureIds->getPointer(0);
+    return std::vector<int32_t>(ids, ids + featureIds->getNumberOfTuples());
+  }
+
+  // -----------------------------------------------------------------------------
+  // The serial burn algorithm is the reference. Every block size must reproduce its Feature Ids exactly, from one row per
+  // block up to the default block size, which holds each of these volumes in a single block.
+  // -----------------------------------------------------------------------------
+  void checkSegmentation(const Fixture& fixture, Segmenter segmenter, float tolerance, size_t expectedFeatures)
+  {
+    size_t serialFeatures = 0;
+    std::vector<int32_t> serialIds = runSegmentation(fixture, segmenter, tolerance, 0, serialFeatures);
+    DREAM3D_REQUIRE_EQUAL(serialFeatures, expectedFeatures)
+
+    // Cells that can not seed a Feature are never part of one, and every other Cell is
+    for(size_t i = 0; i < serialIds.size(); i++)
+    {
+      bool seedable = fixture.good[i] && fixture.phases[i] > 0;
+      DREAM3D_REQUIRE_EQUAL(serialIds[i] > 0, seedable)
+    }
+
+    int64_t dimX = static_cast<int64_t>(fixture.dims[0]);
+    const std::vector<int64_t> blockVoxelCounts = {1, 2 * dimX + 1, 5 * dimX, SegmentFeatures::New()->getBlockVoxelCount()};
+    for(int64_t blockVoxelCount : blockVoxelCounts)
+    {
+      size_t parallelFeatures = 0;
+      std::vector<int32_t> parallelIds = runSegmentation(fixture, segmenter, tolerance, blockVoxelCount, parallelFeatures);
+      DREAM3D_REQUIRE_EQUAL(parallelFeatures, serialFeatures)
+      DREAM3D_REQUIRE(parallelIds == serialIds)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestScalarSegmentFeatures()
+  {
+    checkSegmentation(createSpiral(0), Segmenter::Scalar, 0.0f, 4);
+    checkSegmentation(createSpiral(1), Segmenter::Scalar, 0.0f, 10);
+    checkSegmentation(createBands(), Segmenter::Scalar, 0.0f, 14);
+    checkSegmentation(createLine(40, 1, 1), Segmenter::Scalar, 0.0f, 23);
+    checkSegmentation(createLine(1, 40, 1), Segmenter::Scalar, 0.0f, 23);
+    checkSegmentation(createLine(1, 1, 40), Segmenter::Scalar, 0.0f, 23);
+    checkSegmentation(createNoise(), Segmenter::Scalar, 1.0f, 102);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestVectorSegmentFeatures()
+  {
+    checkSegmentation(createSpiral(0), Segmenter::Vector, 5.0f, 4);
+    checkSegmentation(createSpiral(1), Segmenter::Vector, 5.0f, 10);
+    checkSegmentation(createBands(), Segmenter::Vector, 5.0f, 14);
+    checkSegmentation(createLine(40, 1, 1), Segmenter::Vector, 5.0f, 23);
+    checkSegmentation(createLine(1, 1, 40), Segmenter::Vector, 5.0f, 23);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestEBSDSegmentFeatures()
+  {
+    checkSegmentation(createSpiral(0), Segmenter::EBSD, 5.0f, 4);
+    checkSegmentation(createSpiral(2), Segmenter::EBSD, 5.0f, 15);
+    checkSegmentation(createBands(), Segmenter::EBSD, 5.0f, 14);
+    checkSegmentation(createLine(40, 1, 1), Segmenter::EBSD, 5.0f, 23);
+    checkSegmentation(createLine(1, 1, 40), Segmenter::EBSD, 5.0f, 23);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  int TestCAxisSegmentFeatures()
+  {
+    checkSegmentation(createSpiral(0), Segmenter::CAxis, 5.0f, 4);
+    checkSegmentation(createSpiral(2), Segmenter::CAxis, 5.0f, 15);
+    checkSegmentation(createBands(), Segmenter::CAxis, 5.0f, 14);
+    checkSegmentation(createLine(40, 1, 1), Segmenter::CAxis, 5.0f, 23);
+    checkSegmentation(createLine(1, 1, 40), Segmenter::CAxis, 5.0f, 23);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    std::cout << "#### SegmentFeaturesTest Starting ####" << std::endl;
+
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestScalarSegmentFeatures())
+    DREAM3D_REGISTER_TEST(TestVectorSegmentFeatures())
+    DREAM3D_REGISTER_TEST(TestEBSDSegmentFeatures())
+    DREAM3D_REGISTER_TEST(TestCAxisSegmentFeatures())
+  }
+};
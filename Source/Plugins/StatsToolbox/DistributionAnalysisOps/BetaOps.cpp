@@ -129,6 +129,34 @@ int BetaOps::calculateCorrelatedParameters(std::vector<std::vector<float>>& data
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BetaOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& data, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float alpha = 0;
+  float beta = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < data.size(); i++)
+  {
+    alpha = 0;
+    beta = 0;
+    if(data[i].getCount() > 1)
+    {
+      float avg = static_cast<float>(data[i].getMean());
+      float variance = static_cast<float>(data[i].getVariance());
+      if(variance != 0)
+      {
+        alpha = avg * (((avg * (1 - avg)) / variance) - 1);
+        beta = (1 - avg) * (((avg * (1 - avg)) / variance) - 1);
+      }
+    }
+    outputs[0]->setValue(i, alpha);
+    outputs[1]->setValue(i, beta);
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 BetaOps::Pointer BetaOps::NullPointer()
 {
@@ -86,6 +86,14 @@ public:
    */
   int calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs) override;
 
+  /**
+   * @brief calculateCorrelatedParameters
+   * @param data
+   * @param outputs
+   * @return
+   */
+  int calculateCorrelatedParameters(const std::vector<DistributionMoments>& data, VectorOfFloatArray outputs) override;
+
 protected:
   BetaOps();
 
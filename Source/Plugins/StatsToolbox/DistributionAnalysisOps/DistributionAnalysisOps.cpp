@@ -70,6 +70,26 @@ void DistributionAnalysisOps::determineMaxAndMinValues(std::vector<float>& data,
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionAnalysisOps::determineMaxAndMinValues(const DistributionMoments& data, float& max, float& min)
+{
+  min = std::numeric_limits<float>::max();
+  max = std::numeric_limits<float>::min();
+  if(data.getCount() > 0)
+  {
+    if(data.getMax() > max)
+    {
+      max = data.getMax();
+    }
+    if(data.getMin() < min)
+    {
+      min = data.getMin();
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
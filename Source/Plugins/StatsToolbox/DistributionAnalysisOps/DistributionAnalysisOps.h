@@ -43,7 +43,7 @@
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/StatsData/StatsData.h"
 
-#include "DistributionAnalysisOps/DistributionAnalysisOps.h"
+#include "DistributionAnalysisOps/DistributionMoments.h"
 
 /*
  *
@@ -72,7 +72,14 @@ public:
   virtual int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs) = 0;
   virtual int calculateCorrelatedParameters(std::vector<std::vector<float>>& data, VectorOfFloatArray outputs) = 0;
 
+  /**
+   * @brief calculateCorrelatedParameters Fits one distribution per bin from the accumulated moments of the bin
+   * instead of from the values themselves
+   */
+  virtual int calculateCorrelatedParameters(const std::vector<DistributionMoments>& data, VectorOfFloatArray outputs) = 0;
+
   static void determineMaxAndMinValues(std::vector<float>& data, float& max, float& min);
+  static void determineMaxAndMinValues(const DistributionMoments& data, float& max, float& min);
   static void determineBinNumbers(float& max, float& min, float& numbins, FloatArrayType::Pointer binnumbers);
 
 protected:
@@ -0,0 +1,153 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DistributionMoments.h"
+
+#include <cmath>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionMoments::add(float value)
+{
+  if(m_Count == 0)
+  {
+    m_Min = value;
+    m_Max = value;
+  }
+  else
+  {
+    m_Min = value < m_Min ? value : m_Min;
+    m_Max = value > m_Max ? value : m_Max;
+  }
+  m_Count++;
+  double n = static_cast<double>(m_Count);
+
+  double delta = static_cast<double>(value) - m_Mean;
+  m_Mean += delta / n;
+  m_M2 += delta * (static_cast<double>(value) - m_Mean);
+
+  double logValue = std::log(static_cast<double>(value));
+  double logDelta = logValue - m_LogMean;
+  m_LogMean += logDelta / n;
+  m_LogM2 += logDelta * (logValue - m_LogMean);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionMoments::merge(const DistributionMoments& other)
+{
+  if(other.m_Count == 0)
+  {
+    return;
+  }
+  if(m_Count == 0)
+  {
+    *this = other;
+    return;
+  }
+  double na = static_cast<double>(m_Count);
+  double nb = static_cast<double>(other.m_Count);
+  double n = na + nb;
+
+  double delta = other.m_Mean - m_Mean;
+  m_Mean += delta * nb / n;
+  m_M2 += other.m_M2 + delta * delta * na * nb / n;
+
+  double logDelta = other.m_LogMean - m_LogMean;
+  m_LogMean += logDelta * nb / n;
+  m_LogM2 += other.m_LogM2 + logDelta * logDelta * na * nb / n;
+
+  m_Min = other.m_Min < m_Min ? other.m_Min : m_Min;
+  m_Max = other.m_Max > m_Max ? other.m_Max : m_Max;
+  m_Count += other.m_Count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t DistributionMoments::getCount() const
+{
+  return m_Count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float DistributionMoments::getMin() const
+{
+  return m_Min;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float DistributionMoments::getMax() const
+{
+  return m_Max;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getMean() const
+{
+  return m_Mean;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getVariance() const
+{
+  return m_Count > 0 ? m_M2 / static_cast<double>(m_Count) : 0.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getLogMean() const
+{
+  return m_LogMean;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getLogVariance() const
+{
+  return m_Count > 0 ? m_LogM2 / static_cast<double>(m_Count) : 0.0;
+}
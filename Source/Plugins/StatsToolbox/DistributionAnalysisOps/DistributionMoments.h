@@ -0,0 +1,82 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief The DistributionMoments class accumulates the count, range and the running (Welford) mean and sum of
+ * squared deviations of a set of values and of their logarithms, which is everything the distribution fits need.
+ * Two accumulators of disjoint sets of values can be merged, so the values can be gathered in parallel.
+ */
+class DistributionMoments
+{
+public:
+  /**
+   * @brief add Adds a single value
+   */
+  void add(float value);
+
+  /**
+   * @brief merge Adds all of the values of another accumulator
+   */
+  void merge(const DistributionMoments& other);
+
+  uint64_t getCount() const;
+  float getMin() const;
+  float getMax() const;
+  double getMean() const;
+
+  /**
+   * @brief getVariance Returns the population variance of the values
+   */
+  double getVariance() const;
+  double getLogMean() const;
+
+  /**
+   * @brief getLogVariance Returns the population variance of the logarithms of the values
+   */
+  double getLogVariance() const;
+
+private:
+  uint64_t m_Count = 0;
+  float m_Min = 0.0f;
+  float m_Max = 0.0f;
+  double m_Mean = 0.0;
+  double m_M2 = 0.0;
+  double m_LogMean = 0.0;
+  double m_LogM2 = 0.0;
+};
@@ -125,6 +125,33 @@ int LogNormalOps::calculateCorrelatedParameters(std::vector<std::vector<float>>&
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogNormalOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& data, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float avg = 0;
+  float stddev = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < data.size(); i++)
+  {
+    avg = 0;
+    stddev = 0;
+    if(data[i].getCount() > 1)
+    {
+      avg = static_cast<float>(data[i].getLogMean());
+      stddev = static_cast<float>(sqrt(data[i].getLogVariance()));
+    }
+    else if(data[i].getCount() == 1)
+    {
+      avg = data[i].getMin();
+    }
+    outputs[0]->setValue(i, avg);
+    outputs[1]->setValue(i, stddev);
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 LogNormalOps::Pointer LogNormalOps::NullPointer()
 {
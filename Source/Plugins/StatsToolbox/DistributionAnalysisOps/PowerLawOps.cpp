@@ -123,6 +123,36 @@ int PowerLawOps::calculateCorrelatedParameters(std::vector<std::vector<float>>&
   return err;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PowerLawOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& data, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float alpha = 0;
+  float min = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < data.size(); i++)
+  {
+    alpha = 0;
+    min = 0;
+    if(data[i].getCount() > 1)
+    {
+      // The sum of log(x / min) follows from the mean of the logarithms
+      double count = static_cast<double>(data[i].getCount());
+      min = data[i].getMin();
+      alpha = static_cast<float>(count * (data[i].getLogMean() - log(static_cast<double>(min))));
+      if(alpha != 0.0f)
+      {
+        alpha = 1.0f / alpha;
+      }
+      alpha = 1.0f + (alpha * data[i].getCount());
+    }
+    outputs[0]->setValue(i, alpha);
+    outputs[1]->setValue(i, min);
+  }
+  return err;
+}
+
 // -----------------------------------------------------------------------------
 PowerLawOps::Pointer PowerLawOps::NullPointer()
 {
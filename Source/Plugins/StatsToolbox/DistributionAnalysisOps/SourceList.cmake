@@ -36,6 +36,7 @@
 set(DistributionAnalysisOps_HDRS
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/BetaOps.h
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/DistributionAnalysisOps.h
+  ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/DistributionMoments.h
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/LogNormalOps.h
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/PowerLawOps.h
 )
@@ -43,6 +44,7 @@ set(DistributionAnalysisOps_HDRS
 set(DistributionAnalysisOps_SRCS
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/BetaOps.cpp
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/DistributionAnalysisOps.cpp
+  ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/DistributionMoments.cpp
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/LogNormalOps.cpp
   ${${PLUGIN_NAME}_SOURCE_DIR}/DistributionAnalysisOps/PowerLawOps.cpp
   )
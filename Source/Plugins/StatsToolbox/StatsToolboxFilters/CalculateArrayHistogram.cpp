@@ -51,6 +51,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/ParallelHistogram.hpp"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
 enum createdPathID : RenameDataPath::DataID_t
@@ -237,7 +238,6 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
 
   T* inputArrayPtr = inputDataPtr->getPointer(0);
   size_t numPoints = inputDataPtr->getNumberOfTuples();
-  int32_t bin = 0;
   float min = std::numeric_limits<float>::max();
   float max = -1.0 * std::numeric_limits<float>::max();
   if(userRange)
@@ -247,17 +247,7 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // min and max in the input array
-    {
-      if(static_cast<float>(inputArrayPtr[i]) > max)
-      {
-        max = static_cast<float>(inputArrayPtr[i]);
-      }
-      if(static_cast<float>(inputArrayPtr[i]) < min)
-      {
-        min = static_cast<float>(inputArrayPtr[i]);
-      }
-    }
+    ParallelHistogram::FindRange(inputArrayPtr, 0, numPoints, min, max); // min and max in the input array
   }
 
   float increment = (max - min) / (numberOfBins);
@@ -268,17 +258,16 @@ void findHistogram(IDataArray::Pointer inDataPtr, int32_t numberOfBins, bool use
   }
   else
   {
-    for(size_t i = 0; i < numPoints; i++) // sort into bins to create the histogram
+    // Values are truncated toward zero into their bin, anything that lands outside of the bins is an overflow
+    auto binOf = [inputArrayPtr, min, increment, numberOfBins](size_t i) -> int64_t {
+      auto offset = (inputArrayPtr[i] - min) / increment;
+      return (offset > -1 && offset < numberOfBins) ? static_cast<int64_t>(offset) : -1;
+    };
+    std::vector<uint64_t> counts;
+    overflow = static_cast<int>(ParallelHistogram::Count(binOf, 0, numPoints, static_cast<size_t>(numberOfBins), counts));
+    for(int32_t i = 0; i < numberOfBins; i++)
     {
-      bin = size_t((inputArrayPtr[i] - min) / increment); // find bin for this input array value
-      if((bin >= 0) && (bin < numberOfBins))              // make certain bin is in range
-      {
-        newDataArrayPtr[bin * 2 + 1]++; // increment histogram element corresponding to this input array value
-      }
-      else
-      {
-        overflow++;
-      }
+      newDataArrayPtr[i * 2 + 1] = static_cast<double>(counts[i]);
     }
   }
 
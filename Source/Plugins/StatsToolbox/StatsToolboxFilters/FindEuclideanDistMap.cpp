@@ -42,6 +42,11 @@
 #include <tbb/tick_count.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -56,6 +61,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
@@ -72,6 +78,143 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID36 = 36,
 };
 
+namespace
+{
+/**
+ * @brief distanceTransformLine Computes the lower envelope of the parabolas rooted at the finite entries of one line
+ * (Felzenszwalb and Huttenlocher), giving every entry its squared distance to the nearest seed of the line
+ * @param f Squared distances of the line from the previous passes, infinite where no seed was reached
+ * @param fNearest Nearest seed of each entry of f
+ * @param size Number of entries in the line
+ * @param spacing Distance between two entries of the line
+ * @param vertices Scratch space of at least size entries
+ * @param bounds Scratch space of at least size + 1 entries
+ */
+void distanceTransformLine(const double* f, const int32_t* fNearest, size_t size, double spacing, double* d, int32_t* dNearest, size_t* vertices, double* bounds)
+{
+  const double infinity = std::numeric_limits<double>::infinity();
+  int64_t k = -1;
+  for(size_t q = 0; q < size; q++)
+  {
+    if(f[q] == infinity)
+    {
+      continue;
+    }
+    double xq = static_cast<double>(q) * spacing;
+    while(true)
+    {
+      if(k < 0)
+      {
+        k = 0;
+        vertices[0] = q;
+        bounds[0] = -infinity;
+        bounds[1] = infinity;
+        break;
+      }
+      double xv = static_cast<double>(vertices[k]) * spacing;
+      double intersection = ((f[q] + xq * xq) - (f[vertices[k]] + xv * xv)) / (2.0 * (xq - xv));
+      if(intersection <= bounds[k])
+      {
+        k--;
+        continue;
+      }
+      k++;
+      vertices[k] = q;
+      bounds[k] = intersection;
+      bounds[k + 1] = infinity;
+      break;
+    }
+  }
+
+  if(k < 0)
+  {
+    std::fill(d, d + size, infinity);
+    std::fill(dNearest, dNearest + size, -1);
+    return;
+  }
+
+  int64_t j = 0;
+  for(size_t p = 0; p < size; p++)
+  {
+    double xp = static_cast<double>(p) * spacing;
+    while(bounds[j + 1] < xp)
+    {
+      j++;
+    }
+    double dx = xp - static_cast<double>(vertices[j]) * spacing;
+    d[p] = dx * dx + f[vertices[j]];
+    dNearest[p] = fNearest[vertices[j]];
+  }
+}
+} // namespace
+
+/**
+ * @brief The EuclideanDistancePassImpl class runs the one dimensional distance transform over a range of the lines
+ * along one axis of the volume. Each pass leaves the exact squared distance over the axes done so far.
+ */
+class EuclideanDistancePassImpl
+{
+public:
+  EuclideanDistancePassImpl(double* squaredDistances, int32_t* nearest, const int64_t dims[3], int32_t axis, double spacing)
+  : m_SquaredDistances(squaredDistances)
+  , m_Nearest(nearest)
+  , m_Dims(dims)
+  , m_Axis(axis)
+  , m_Spacing(spacing)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    const int64_t plane = m_Dims[0] * m_Dims[1];
+    const size_t size = static_cast<size_t>(m_Dims[m_Axis]);
+    const int64_t stride = (m_Axis == 0) ? 1 : ((m_Axis == 1) ? m_Dims[0] : plane);
+
+    std::vector<double> f(size);
+    std::vector<int32_t> fNearest(size);
+    std::vector<double> d(size);
+    std::vector<int32_t> dNearest(size);
+    std::vector<size_t> vertices(size);
+    std::vector<double> bounds(size + 1);
+
+    for(size_t line = range.min(); line < range.max(); line++)
+    {
+      int64_t start = 0;
+      if(m_Axis == 0)
+      {
+        start = static_cast<int64_t>(line) * m_Dims[0];
+      }
+      else if(m_Axis == 1)
+      {
+        start = (static_cast<int64_t>(line) / m_Dims[0]) * plane + static_cast<int64_t>(line) % m_Dims[0];
+      }
+      else
+      {
+        start = static_cast<int64_t>(line);
+      }
+
+      for(size_t q = 0; q < size; q++)
+      {
+        f[q] = m_SquaredDistances[start + q * stride];
+        fNearest[q] = m_Nearest[start + q * stride];
+      }
+      distanceTransformLine(f.data(), fNearest.data(), size, m_Spacing, d.data(), dNearest.data(), vertices.data(), bounds.data());
+      for(size_t q = 0; q < size; q++)
+      {
+        m_SquaredDistances[start + q * stride] = d[q];
+        m_Nearest[start + q * stride] = dNearest[q];
+      }
+    }
+  }
+
+private:
+  double* m_SquaredDistances = nullptr;
+  int32_t* m_Nearest = nullptr;
+  const int64_t* m_Dims = nullptr;
+  int32_t m_Axis = 0;
+  double m_Spacing = 1.0;
+};
+
 /**
  * @brief The ComputeDistanceMapImpl class implements a threaded algorithm that computes the  distance map
  * for each point in the supplied volume
@@ -103,189 +246,149 @@ public:
 
   virtual ~ComputeDistanceMapImpl() = default;
 
-  void operator()() const
+  /**
+   * @brief computeManhattanDistances Grows the distances one layer at a time through the Features from the voxels at
+   * distance 0. Every voxel is visited once, so the cost does not depend on how far the Features reach.
+   */
+  void computeManhattanDistances(T* distances, int32_t* voxelNearestNeighbor, const int64_t dims[3], size_t totalPoints) const
   {
-    ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
-    size_t totalPoints = imageGeom->getNumberOfElements();
-    double Distance = 0.0;
-    size_t count = 1;
-    size_t changed = 1;
-    size_t neighpoint = 0;
-    int64_t nearestneighbor;
-    int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
-    int64_t xpoints = static_cast<int64_t>(imageGeom->getXPoints());
-    int64_t ypoints = static_cast<int64_t>(imageGeom->getYPoints());
-    int64_t zpoints = static_cast<int64_t>(imageGeom->getZPoints());
-    FloatVec3Type spacing = imageGeom->getSpacing();
-
-    neighbors[0] = -xpoints * ypoints;
-    neighbors[1] = -xpoints;
-    neighbors[2] = -1;
-    neighbors[3] = 1;
-    neighbors[4] = xpoints;
-    neighbors[5] = xpoints * ypoints;
-
-    // Use a std::vector to get an auto cleaned up array thus not needing the 'delete' keyword later on.
-    std::vector<int32_t> voxNN(totalPoints, 0);
-    int32_t* voxel_NearestNeighbor = &(voxNN.front());
-    std::vector<double> voxEDist(totalPoints, 0.0);
-    double* voxel_Distance = &(voxEDist.front());
-
-    Distance = 0;
+    const int64_t plane = dims[0] * dims[1];
+    std::vector<int64_t> frontier;
+    std::vector<int64_t> nextFrontier;
     for(size_t a = 0; a < totalPoints; ++a)
     {
-      if(m_NearestNeighbors[a * 3 + static_cast<uint32_t>(m_MapType)] >= 0)
+      if(distances[a] == 0)
       {
-        voxel_NearestNeighbor[a] = static_cast<int32_t>(a);
-      } // if voxel is boundary voxel, then want to use itself as nearest boundary voxel
-      else
-      {
-        voxel_NearestNeighbor[a] = -1;
-      }
-      if(m_MapType == FindEuclideanDistMap::MapType::FeatureBoundary)
-      {
-        voxel_Distance[a] = static_cast<double>(m_GBManhattanDistances[a]);
-      }
-      else if(m_MapType == FindEuclideanDistMap::MapType::TripleJunction)
-      {
-        voxel_Distance[a] = static_cast<double>(m_TJManhattanDistances[a]);
-      }
-      else if(m_MapType == FindEuclideanDistMap::MapType::QuadPoint)
-      {
-        voxel_Distance[a] = static_cast<double>(m_QPManhattanDistances[a]);
+        voxelNearestNeighbor[a] = static_cast<int32_t>(a);
+        frontier.push_back(static_cast<int64_t>(a));
       }
     }
 
-    // ------------- Calculate the Manhattan Distance ----------------
-    count = 1;
-    changed = 1;
-    int64_t i = 0;
-    int64_t zBlock = xpoints * ypoints;
-    int64_t zStride = 0, yStride = 0;
-    char mask[6] = {0, 0, 0, 0, 0, 0};
-    while(count > 0 && changed > 0)
+    int64_t neighbors[6] = {0, 0, 0, 0, 0, 0};
+    T distance = 0;
+    while(!frontier.empty())
     {
-      count = 0;
-      changed = 0;
-      Distance++;
-
-      for(int64_t z = 0; z < zpoints; ++z)
+      distance++;
+      nextFrontier.clear();
+      for(const auto& point : frontier)
       {
-        zStride = z * zBlock;
-        mask[0] = mask[5] = 1;
-        if(z == 0)
+        const int64_t x = point % dims[0];
+        const int64_t y = (point / dims[0]) % dims[1];
+        const int64_t z = point / plane;
+        int32_t numNeighbors = 0;
+        if(z > 0)
         {
-          mask[0] = 0;
+          neighbors[numNeighbors++] = point - plane;
         }
-        if(z == zpoints - 1)
+        if(y > 0)
         {
-          mask[5] = 0;
+          neighbors[numNeighbors++] = point - dims[0];
         }
-
-        for(int64_t y = 0; y < ypoints; ++y)
+        if(x > 0)
         {
-          yStride = y * xpoints;
-          mask[1] = mask[4] = 1;
-          if(y == 0)
-          {
-            mask[1] = 0;
-          }
-          if(y == ypoints - 1)
-          {
-            mask[4] = 0;
-          }
-
-          for(int64_t x = 0; x < xpoints; ++x)
-          {
-            mask[2] = mask[3] = 1;
-            if(x == 0)
-            {
-              mask[2] = 0;
-            }
-            if(x == xpoints - 1)
-            {
-              mask[3] = 0;
-            }
-
-            i = zStride + yStride + x;
-            if(voxel_NearestNeighbor[i] == -1 && m_FeatureIds[i] > 0)
-            {
-              count++;
-              for(int32_t j = 0; j < 6; j++)
-              {
-                neighpoint = i + neighbors[j];
-                if(mask[j] == 1)
-                {
-                  if(voxel_Distance[neighpoint] != -1.0)
-                  {
-                    voxel_NearestNeighbor[i] = voxel_NearestNeighbor[neighpoint];
-                  }
-                }
-              }
-            }
-          }
+          neighbors[numNeighbors++] = point - 1;
         }
-      }
-      for(size_t j = 0; j < totalPoints; ++j)
-      {
-        if(voxel_NearestNeighbor[j] != -1 && voxel_Distance[j] == -1.0 && m_FeatureIds[j] > 0)
+        if(x < dims[0] - 1)
         {
-          changed++;
-          voxel_Distance[j] = Distance;
+          neighbors[numNeighbors++] = point + 1;
+        }
+        if(y < dims[1] - 1)
+        {
+          neighbors[numNeighbors++] = point + dims[0];
+        }
+        if(z < dims[2] - 1)
+        {
+          neighbors[numNeighbors++] = point + plane;
         }
-      }
-    }
-
-    // ------------- Calculate the Euclidian Distance ----------------
 
-    if(m_CalcManhattanDist == false)
-    {
-      double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0, z1 = 0.0, z2 = 0.0;
-      double dist = 0.0;
-      double oneOverzBlock = 1.0 / double(zBlock);
-      double oneOverxpoints = 1.0 / double(xpoints);
-      for(int64_t m = 0; m < zpoints; m++)
-      {
-        zStride = m * zBlock;
-        for(int64_t n = 0; n < ypoints; n++)
+        for(int32_t j = 0; j < numNeighbors; j++)
         {
-          yStride = n * xpoints;
-          for(int64_t p = 0; p < xpoints; p++)
+          const int64_t neighpoint = neighbors[j];
+          if(voxelNearestNeighbor[neighpoint] == -1 && m_FeatureIds[neighpoint] > 0)
           {
-            x1 = static_cast<double>(p) * spacing[0];
-            y1 = static_cast<double>(n) * spacing[1];
-            z1 = static_cast<double>(m) * spacing[2];
-            nearestneighbor = voxel_NearestNeighbor[zStride + yStride + p];
-            if(nearestneighbor >= 0)
-            {
-              x2 = spacing[0] * double(nearestneighbor % xpoints);                           // find_xcoord(nearestneighbor);
-              y2 = spacing[1] * double(int64_t(nearestneighbor * oneOverxpoints) % ypoints); // find_ycoord(nearestneighbor);
-              z2 = spacing[2] * floor(nearestneighbor * oneOverzBlock);                      // find_zcoord(nearestneighbor);
-              dist = ((x1 - x2) * (x1 - x2)) + ((y1 - y2) * (y1 - y2)) + ((z1 - z2) * (z1 - z2));
-              dist = sqrt(dist);
-              voxel_Distance[zStride + yStride + p] = dist;
-            }
+            voxelNearestNeighbor[neighpoint] = voxelNearestNeighbor[point];
+            distances[neighpoint] = distance;
+            nextFrontier.push_back(neighpoint);
           }
         }
       }
+      frontier.swap(nextFrontier);
     }
+  }
+
+  /**
+   * @brief computeEuclideanDistances Computes the exact distance from every Feature voxel to the nearest voxel at
+   * distance 0 with one separable pass per axis, each running its lines in parallel.
+   */
+  void computeEuclideanDistances(T* distances, int32_t* voxelNearestNeighbor, const int64_t dims[3], size_t totalPoints, const FloatVec3Type& spacing) const
+  {
+    std::vector<double> squaredDistances(totalPoints, std::numeric_limits<double>::infinity());
     for(size_t a = 0; a < totalPoints; ++a)
     {
-      m_NearestNeighbors[a * 3 + static_cast<uint32_t>(m_MapType)] = voxel_NearestNeighbor[a];
-      if(m_MapType == FindEuclideanDistMap::MapType::FeatureBoundary)
+      if(distances[a] == 0)
       {
-        m_GBManhattanDistances[a] = static_cast<T>(voxel_Distance[a]);
+        squaredDistances[a] = 0.0;
+        voxelNearestNeighbor[a] = static_cast<int32_t>(a);
       }
-      else if(m_MapType == FindEuclideanDistMap::MapType::TripleJunction)
+    }
+
+    for(int32_t axis = 0; axis < 3; axis++)
+    {
+      size_t numLines = static_cast<size_t>(totalPoints / dims[axis]);
+      ParallelDataAlgorithm dataAlg;
+      dataAlg.setRange(0, numLines);
+      dataAlg.execute(EuclideanDistancePassImpl(squaredDistances.data(), voxelNearestNeighbor, dims, axis, static_cast<double>(spacing[axis])));
+    }
+
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      if(m_FeatureIds[a] > 0 && voxelNearestNeighbor[a] >= 0)
       {
-        m_TJManhattanDistances[a] = static_cast<T>(voxel_Distance[a]);
+        distances[a] = static_cast<T>(std::sqrt(squaredDistances[a]));
       }
-      else if(m_MapType == FindEuclideanDistMap::MapType::QuadPoint)
+      else
       {
-        m_QPManhattanDistances[a] = static_cast<T>(voxel_Distance[a]);
+        voxelNearestNeighbor[a] = -1;
       }
     }
   }
+
+  void operator()() const
+  {
+    ImageGeom::Pointer imageGeom = m_DataContainer->getGeometryAs<ImageGeom>();
+    size_t totalPoints = imageGeom->getNumberOfElements();
+    int64_t dims[3] = {
+        static_cast<int64_t>(imageGeom->getXPoints()),
+        static_cast<int64_t>(imageGeom->getYPoints()),
+        static_cast<int64_t>(imageGeom->getZPoints()),
+    };
+
+    T* distances = m_GBManhattanDistances;
+    if(m_MapType == FindEuclideanDistMap::MapType::TripleJunction)
+    {
+      distances = m_TJManhattanDistances;
+    }
+    else if(m_MapType == FindEuclideanDistMap::MapType::QuadPoint)
+    {
+      distances = m_QPManhattanDistances;
+    }
+
+    // The voxels of this map at distance 0 are its seeds and every other voxel starts out unreached
+    std::vector<int32_t> voxNN(totalPoints, -1);
+    if(m_CalcManhattanDist)
+    {
+      computeManhattanDistances(distances, voxNN.data(), dims, totalPoints);
+    }
+    else
+    {
+      computeEuclideanDistances(distances, voxNN.data(), dims, totalPoints, imageGeom->getSpacing());
+    }
+
+    for(size_t a = 0; a < totalPoints; ++a)
+    {
+      m_NearestNeighbors[a * 3 + static_cast<uint32_t>(m_MapType)] = voxNN[a];
+    }
+  }
 };
 
 // -----------------------------------------------------------------------------
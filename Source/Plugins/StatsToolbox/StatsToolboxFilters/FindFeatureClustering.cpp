@@ -34,7 +34,13 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindFeatureClustering.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QTextStream>
 
@@ -44,6 +50,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/FloatFilterParameter.h"
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedPathCreationFilterParameter.h"
@@ -53,6 +60,7 @@
 #include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Math/RadialDistributionFunction.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
@@ -65,6 +73,296 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+namespace
+{
+/**
+ * @brief The SeparationPartial struct holds the separation distance range and RDF counts
+ * gathered by one chunk of the clustered Features.
+ */
+struct SeparationPartial
+{
+  float min = std::numeric_limits<float>::max();
+  float max = 0.0f;
+  size_t count = 0;
+  std::vector<uint64_t> histogram;
+};
+
+/**
+ * @brief The ClusteringPairFinder class enumerates the separation distances between the
+ * centroids of the clustered Features. When a maximum separation distance is used the
+ * centroids are bucketed into uniform cells of that size and only the adjacent cells are
+ * searched.
+ */
+class ClusteringPairFinder
+{
+public:
+  ClusteringPairFinder(const std::vector<int32_t>& features, const float* centroids, bool useMaxDistance, float maxDistance)
+  : m_Features(features)
+  , m_Centroids(centroids)
+  , m_UseMaxDistance(useMaxDistance)
+  , m_MaxDistance(maxDistance)
+  {
+    if(m_UseMaxDistance && !m_Features.empty())
+    {
+      buildGrid();
+    }
+  }
+
+  size_t size() const
+  {
+    return m_Features.size();
+  }
+
+  float distance(size_t a, size_t b) const
+  {
+    const float* c1 = m_Centroids + 3 * m_Features[std::min(a, b)];
+    const float* c2 = m_Centroids + 3 * m_Features[std::max(a, b)];
+    return sqrtf((c1[0] - c2[0]) * (c1[0] - c2[0]) + (c1[1] - c2[1]) * (c1[1] - c2[1]) + (c1[2] - c2[2]) * (c1[2] - c2[2]));
+  }
+
+  /**
+   * @brief forEachPartner Calls func(b, distance) for every partner b of the Feature at position a.
+   * @param upperOnly Only visit partners after a, so that every pair is visited once
+   */
+  template <typename Func>
+  void forEachPartner(size_t a, bool upperOnly, Func&& func) const
+  {
+    if(!m_UseMaxDistance)
+    {
+      for(size_t b = upperOnly ? a + 1 : 0; b < m_Features.size(); b++)
+      {
+        if(b != a)
+        {
+          func(b, distance(a, b));
+        }
+      }
+      return;
+    }
+
+    const float* c1 = m_Centroids + 3 * m_Features[a];
+    int64_t cellMin[3] = {0, 0, 0};
+    int64_t cellMax[3] = {0, 0, 0};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      cellMin[axis] = cellCoordinate(c1[axis] - m_MaxDistance, axis);
+      cellMax[axis] = cellCoordinate(c1[axis] + m_MaxDistance, axis);
+    }
+    for(int64_t cz = cellMin[2]; cz <= cellMax[2]; cz++)
+    {
+      for(int64_t cy = cellMin[1]; cy <= cellMax[1]; cy++)
+      {
+        size_t rowStart = static_cast<size_t>((cz * m_Dims[1] + cy) * m_Dims[0]);
+        for(size_t f = m_CellStarts[rowStart + cellMin[0]]; f < m_CellStarts[rowStart + cellMax[0] + 1]; f++)
+        {
+          size_t b = m_Members[f];
+          if(upperOnly ? b <= a : b == a)
+          {
+            continue;
+          }
+          float r = distance(a, b);
+          if(r <= m_MaxDistance)
+          {
+            func(b, r);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const std::vector<int32_t>& m_Features;
+  const float* m_Centroids = nullptr;
+  bool m_UseMaxDistance = false;
+  float m_MaxDistance = 0.0f;
+
+  float m_CellSize = 1.0f;
+  float m_Origin[3] = {0.0f, 0.0f, 0.0f};
+  int64_t m_Dims[3] = {1, 1, 1};
+  std::vector<size_t> m_CellStarts;
+  std::vector<size_t> m_Members;
+
+  int64_t cellCoordinate(float coordinate, size_t axis) const
+  {
+    float cell = std::floor((coordinate - m_Origin[axis]) / m_CellSize);
+    return static_cast<int64_t>(std::min(std::max(cell, 0.0f), static_cast<float>(m_Dims[axis] - 1)));
+  }
+
+  void buildGrid()
+  {
+    float maxCorner[3] = {0.0f, 0.0f, 0.0f};
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      m_Origin[axis] = m_Centroids[3 * m_Features[0] + axis];
+      maxCorner[axis] = m_Origin[axis];
+    }
+    for(int32_t feature : m_Features)
+    {
+      for(size_t axis = 0; axis < 3; axis++)
+      {
+        m_Origin[axis] = std::min(m_Origin[axis], m_Centroids[3 * feature + axis]);
+        maxCorner[axis] = std::max(maxCorner[axis], m_Centroids[3 * feature + axis]);
+      }
+    }
+
+    // Never let the grid hold more cells than Features
+    float extent = std::max({maxCorner[0] - m_Origin[0], maxCorner[1] - m_Origin[1], maxCorner[2] - m_Origin[2]});
+    m_CellSize = m_MaxDistance > 0.0f ? m_MaxDistance : 1.0f;
+    while(true)
+    {
+      double numCells = 1.0;
+      for(size_t axis = 0; axis < 3; axis++)
+      {
+        m_Dims[axis] = static_cast<int64_t>((maxCorner[axis] - m_Origin[axis]) / m_CellSize) + 1;
+        numCells *= static_cast<double>(m_Dims[axis]);
+      }
+      if(numCells <= static_cast<double>(m_Features.size()) || m_CellSize > extent)
+      {
+        break;
+      }
+      m_CellSize *= 2.0f;
+    }
+
+    size_t numCells = static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+    std::vector<size_t> cellIds(m_Features.size(), 0);
+    m_CellStarts.assign(numCells + 1, 0);
+    for(size_t a = 0; a < m_Features.size(); a++)
+    {
+      const float* c1 = m_Centroids + 3 * m_Features[a];
+      cellIds[a] = static_cast<size_t>((cellCoordinate(c1[2], 2) * m_Dims[1] + cellCoordinate(c1[1], 1)) * m_Dims[0] + cellCoordinate(c1[0], 0));
+      m_CellStarts[cellIds[a] + 1]++;
+    }
+    for(size_t c = 0; c < numCells; c++)
+    {
+      m_CellStarts[c + 1] += m_CellStarts[c];
+    }
+    std::vector<size_t> fill(m_CellStarts.begin(), m_CellStarts.end() - 1);
+    m_Members.resize(m_Features.size());
+    for(size_t a = 0; a < m_Features.size(); a++)
+    {
+      m_Members[fill[cellIds[a]]++] = a;
+    }
+  }
+};
+} // namespace
+
+/**
+ * @brief The ClusteringListImpl class fills the clustering list of each clustered Feature with
+ * the separation distances to its partners, in order of the partner Feature Ids.
+ */
+class ClusteringListImpl
+{
+public:
+  ClusteringListImpl(const ClusteringPairFinder& pairs, std::vector<std::vector<float>>& clusteringLists)
+  : m_Pairs(pairs)
+  , m_ClusteringLists(clusteringLists)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    std::vector<std::pair<size_t, float>> partners;
+    for(size_t a = range.min(); a < range.max(); a++)
+    {
+      partners.clear();
+      m_Pairs.forEachPartner(a, false, [&](size_t b, float r) { partners.emplace_back(b, r); });
+      std::sort(partners.begin(), partners.end());
+
+      std::vector<float>& list = m_ClusteringLists[a];
+      list.resize(partners.size());
+      for(size_t p = 0; p < partners.size(); p++)
+      {
+        list[p] = partners[p].second;
+      }
+    }
+  }
+
+private:
+  const ClusteringPairFinder& m_Pairs;
+  std::vector<std::vector<float>>& m_ClusteringLists;
+};
+
+/**
+ * @brief The ClusteringSeparationImpl class gathers either the separation distance range or the
+ * RDF counts into one partial per chunk. Chunk c owns the Features at positions c, c + numChunks, ...
+ * so that the triangular pair loop stays balanced. Distances are read from the clustering lists when
+ * they are stored and are streamed from the pair finder otherwise. A distance is counted in the RDF
+ * once for every unbiased Feature of its pair.
+ */
+class ClusteringSeparationImpl
+{
+public:
+  ClusteringSeparationImpl(const ClusteringPairFinder& pairs, const std::vector<std::vector<float>>& clusteringLists, const std::vector<uint8_t>& unbiased, bool binDistances, float min,
+                           float stepSize, int32_t numBins, std::vector<SeparationPartial>& partials)
+  : m_Pairs(pairs)
+  , m_ClusteringLists(clusteringLists)
+  , m_Unbiased(unbiased)
+  , m_BinDistances(binDistances)
+  , m_Min(min)
+  , m_StepSize(stepSize)
+  , m_NumBins(numBins)
+  , m_Partials(partials)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numChunks = m_Partials.size();
+    for(size_t c = range.min(); c < range.max(); c++)
+    {
+      SeparationPartial& partial = m_Partials[c];
+      if(m_BinDistances)
+      {
+        partial.histogram.assign(m_NumBins, 0);
+      }
+      for(size_t a = c; a < m_Pairs.size(); a += numChunks)
+      {
+        if(!m_ClusteringLists.empty())
+        {
+          for(float r : m_ClusteringLists[a])
+          {
+            record(partial, r, m_Unbiased[a]);
+          }
+        }
+        else
+        {
+          m_Pairs.forEachPartner(a, true, [&](size_t b, float r) { record(partial, r, m_Unbiased[a] + m_Unbiased[b]); });
+        }
+      }
+    }
+  }
+
+private:
+  const ClusteringPairFinder& m_Pairs;
+  const std::vector<std::vector<float>>& m_ClusteringLists;
+  const std::vector<uint8_t>& m_Unbiased;
+  bool m_BinDistances = false;
+  float m_Min = 0.0f;
+  float m_StepSize = 0.0f;
+  int32_t m_NumBins = 0;
+  std::vector<SeparationPartial>& m_Partials;
+
+  void record(SeparationPartial& partial, float r, uint32_t weight) const
+  {
+    if(!m_BinDistances)
+    {
+      partial.min = std::min(partial.min, r);
+      partial.max = std::max(partial.max, r);
+      partial.count++;
+      return;
+    }
+    if(weight == 0)
+    {
+      return;
+    }
+    int32_t bin = m_StepSize > 0.0f ? static_cast<int32_t>((r - m_Min) / m_StepSize) : 0;
+    if(bin >= m_NumBins)
+    {
+      bin = m_NumBins - 1;
+    }
+    partial.histogram[bin] += weight;
+  }
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -88,6 +386,11 @@ void FindFeatureClustering::setupFilterParameters()
   linkedProps = {"RandomSeedValue"};
   parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Set Random Seed", UseRandomSeed, FilterParameter::Category::Parameter, FindFeatureClustering, linkedProps));
   parameters.push_back(SIMPL_NEW_UINT64_FP("Seed Value", RandomSeedValue, FilterParameter::Category::Parameter, FindFeatureClustering));
+  linkedProps = {"MaxSeparationDistance"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Use Maximum Separation Distance", UseMaxSeparationDistance, FilterParameter::Category::Parameter, FindFeatureClustering, linkedProps));
+  parameters.push_back(SIMPL_NEW_FLOAT_FP("Maximum Separation Distance", MaxSeparationDistance, FilterParameter::Category::Parameter, FindFeatureClustering));
+  linkedProps = {"ClusteringListArrayName"};
+  parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Store Clustering List", StoreClusteringList, FilterParameter::Category::Parameter, FindFeatureClustering, linkedProps));
 
   parameters.push_back(SeparatorFilterParameter::Create("Cell Feature Data", FilterParameter::Category::RequiredArray));
   {
@@ -143,6 +446,9 @@ void FindFeatureClustering::readFilterParameters(AbstractFilterParametersReader*
   setPhaseNumber(reader->readValue("PhaseNumber", getPhaseNumber()));
   setBiasedFeaturesArrayPath(reader->readDataArrayPath("BiasedFeaturesArrayPath", getBiasedFeaturesArrayPath()));
   setRemoveBiasedFeatures(reader->readValue("RemoveBiasedFeatures", getRemoveBiasedFeatures()));
+  setUseMaxSeparationDistance(reader->readValue("UseMaxSeparationDistance", getUseMaxSeparationDistance()));
+  setMaxSeparationDistance(reader->readValue("MaxSeparationDistance", getMaxSeparationDistance()));
+  setStoreClusteringList(reader->readValue("StoreClusteringList", getStoreClusteringList()));
   reader->closeFilterGroup();
 }
 
@@ -165,6 +471,12 @@ void FindFeatureClustering::dataCheck()
   initialize();
   getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom>(this, getEquivalentDiametersArrayPath().getDataContainerName());
 
+  if(m_UseMaxSeparationDistance && !(m_MaxSeparationDistance > 0.0f))
+  {
+    QString ss = QObject::tr("The Maximum Separation Distance must be greater than 0");
+    setErrorCondition(-11001, ss);
+  }
+
   DataArrayPath tempPath;
   std::vector<size_t> cDims(1, 1);
 
@@ -215,9 +527,12 @@ void FindFeatureClustering::dataCheck()
     m_MaxMinArray = m_MaxMinArrayPtr.lock()->getPointer(0);
   } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  cDims[0] = 1;
-  tempPath.update(getFeaturePhasesArrayPath().getDataContainerName(), getFeaturePhasesArrayPath().getAttributeMatrixName(), getClusteringListArrayName());
-  m_ClusteringList = getDataContainerArray()->createNonPrereqArrayFromPath<NeighborList<float>>(this, tempPath, 0, cDims, "", DataArrayID32);
+  if(m_StoreClusteringList)
+  {
+    cDims[0] = 1;
+    tempPath.update(getFeaturePhasesArrayPath().getDataContainerName(), getFeaturePhasesArrayPath().getAttributeMatrixName(), getClusteringListArrayName());
+    m_ClusteringList = getDataContainerArray()->createNonPrereqArrayFromPath<NeighborList<float>>(this, tempPath, 0, cDims, "", DataArrayID32);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -225,29 +540,9 @@ void FindFeatureClustering::dataCheck()
 // -----------------------------------------------------------------------------
 void FindFeatureClustering::find_clustering()
 {
-  bool writeErrorFile = true;
-  std::ofstream outFile;
-
-  if(!m_ErrorOutputFile.isEmpty())
-  {
-    outFile.open(m_ErrorOutputFile.toLatin1().data(), std::ios_base::binary);
-    writeErrorFile = true;
-  }
-
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
-  int32_t bin = 0;
-  int32_t ensemble = 0;
-  int32_t totalPPTfeatures = 0;
-  float min = std::numeric_limits<float>::max();
-  float max = 0.0f;
-  float value = 0.0f;
-  float sizex = 0.0f, sizey = 0.0f, sizez = 0.0f, totalvol = 0.0f, totalpoints = 0.0f;
+  float sizex = 0.0f, sizey = 0.0f, sizez = 0.0f;
   float normFactor = 0.0f;
 
-  std::vector<std::vector<float>> clusteringlist;
   std::vector<float> oldcount(m_NumberOfBins);
   std::vector<float> randomRDF;
 
@@ -262,78 +557,77 @@ void FindFeatureClustering::find_clustering()
   sizey = dims[1] * spacing[1];
   sizez = dims[2] * spacing[2];
 
-  totalvol = sizex * sizey * sizez;
-  totalpoints = static_cast<float>(dims[0] * dims[1] * dims[2]);
-
   // initialize boxdims and boxres vectors
   std::array<float, 3> boxdims = {sizex, sizey, sizez};
 
   FloatVec3Type vec3 = m->getGeometryAs<ImageGeom>()->getSpacing();
   std::array<float, 3> boxres = {vec3[0], vec3[1], vec3[2]};
 
+  std::vector<int32_t> clusteredFeatures;
+  std::vector<uint8_t> unbiased;
   for(size_t i = 1; i < totalFeatures; i++)
   {
     if(m_FeaturePhases[i] == m_PhaseNumber)
     {
-      totalPPTfeatures++;
+      clusteredFeatures.push_back(static_cast<int32_t>(i));
+      unbiased.push_back(!m_RemoveBiasedFeatures || !m_BiasedFeatures[i] ? 1 : 0);
     }
   }
+  int32_t totalPPTfeatures = static_cast<int32_t>(clusteredFeatures.size());
 
-  clusteringlist.resize(totalFeatures);
+  ClusteringPairFinder pairs(clusteredFeatures, m_Centroids, m_UseMaxSeparationDistance, m_MaxSeparationDistance);
+  ParallelDataAlgorithm dataAlg;
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  std::vector<std::vector<float>> clusteringLists;
+  if(m_StoreClusteringList)
   {
-    if(m_FeaturePhases[i] == m_PhaseNumber)
+    notifyStatusMessage("Finding Clustering Lists");
+    clusteringLists.resize(clusteredFeatures.size());
+    dataAlg.setRange(0, clusteredFeatures.size());
+    dataAlg.execute(ClusteringListImpl(pairs, clusteringLists));
+    if(getCancel())
     {
-      if(i % 1000 == 0)
-      {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(ss);
-      }
-
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
+      return;
+    }
+  }
 
-      for(size_t j = i + 1; j < totalFeatures; j++)
-      {
-        if(m_FeaturePhases[i] == m_FeaturePhases[j])
-        {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
+  if(!m_ErrorOutputFile.isEmpty() && m_PhaseNumber == 2)
+  {
+    std::ofstream outFile(m_ErrorOutputFile.toLatin1().data(), std::ios_base::binary);
+    for(size_t a = 0; a < pairs.size(); a++)
+    {
+      pairs.forEachPartner(a, true, [&](size_t /* b */, float r) { outFile << r << "\n" << r << "\n"; });
+    }
+  }
 
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+  // Each chunk keeps its own range and RDF counts, which are merged once all chunks are done
+  size_t numChunks = std::min<size_t>(std::max<size_t>(clusteredFeatures.size(), 1), 4 * std::max(1u, std::thread::hardware_concurrency()));
+  std::vector<SeparationPartial> partials(numChunks);
+  dataAlg.setRange(0, numChunks);
 
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
+  notifyStatusMessage("Finding Separation Distance Range");
+  dataAlg.execute(ClusteringSeparationImpl(pairs, clusteringLists, unbiased, false, 0.0f, 0.0f, m_NumberOfBins, partials));
+  if(getCancel())
+  {
+    return;
+  }
 
-          if(writeErrorFile && m_FeaturePhases[j] == 2)
-          {
-            outFile << r << "\n" << r << "\n";
-          }
-        }
-      }
-    }
+  float min = std::numeric_limits<float>::max();
+  float max = 0.0f;
+  size_t numDistances = 0;
+  for(const SeparationPartial& partial : partials)
+  {
+    min = std::min(min, partial.min);
+    max = std::max(max, partial.max);
+    numDistances += partial.count;
   }
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  if(numDistances == 0)
   {
-    for(size_t j = 0; j < clusteringlist[i].size(); j++)
-    {
-      if(m_FeaturePhases[i] == m_PhaseNumber)
-      {
-        value = clusteringlist[i][j];
-        if(value > max)
-        {
-          max = value;
-        }
-        if(value < min)
-        {
-          min = value;
-        }
-      }
-    }
+    QString ss = QObject::tr("No pair of Features in phase %1 is within the separation distance, so the radial distribution function is left empty").arg(m_PhaseNumber);
+    setWarningCondition(-11000, ss);
+    storeClusteringLists(clusteredFeatures, clusteringLists);
+    return;
   }
 
   float stepsize = (max - min) / m_NumberOfBins;
@@ -341,23 +635,17 @@ void FindFeatureClustering::find_clustering()
   m_MaxMinArray[(m_PhaseNumber * 2)] = max;
   m_MaxMinArray[(m_PhaseNumber * 2) + 1] = min;
 
-  for(size_t i = 1; i < totalFeatures; i++)
+  notifyStatusMessage("Binning Separation Distances");
+  dataAlg.execute(ClusteringSeparationImpl(pairs, clusteringLists, unbiased, true, min, stepsize, m_NumberOfBins, partials));
+  if(getCancel())
   {
-    for(size_t j = 0; j < clusteringlist[i].size(); j++)
+    return;
+  }
+  for(const SeparationPartial& partial : partials)
+  {
+    for(int32_t bin = 0; bin < m_NumberOfBins; bin++)
     {
-      if(m_FeaturePhases[i] == m_PhaseNumber)
-      {
-        if(!m_RemoveBiasedFeatures || !m_BiasedFeatures[i])
-        {
-          ensemble = m_FeaturePhases[i];
-          bin = (clusteringlist[i][j] - min) / stepsize;
-          if(bin >= m_NumberOfBins)
-          {
-            bin = m_NumberOfBins - 1;
-          }
-          m_NewEnsembleArray[(m_NumberOfBins * ensemble) + bin]++;
-        }
-      }
+      m_NewEnsembleArray[(m_NumberOfBins * m_PhaseNumber) + bin] += static_cast<float>(partial.histogram[bin]);
     }
   }
 
@@ -369,7 +657,10 @@ void FindFeatureClustering::find_clustering()
   // Call this function to generate the random distribution, which is normalized by the total number of distances
   randomRDF = RadialDistributionFunction::GenerateRandomDistribution(min, max, m_NumberOfBins, boxdims, boxres, m_UseRandomSeed, m_RandomSeedValue);
 
-  // Scale the random distribution by the number of distances in this particular instance
+  // Scale the random distribution by the number of distances in this particular instance. The random frequencies
+  // are fractions of all of the distances in the box, so this stays the count of every ordered pair even when only
+  // pairs within the maximum separation distance are binned: all bins end at or below that distance, where no pair
+  // was skipped, and scaling by the pairs within the cutoff would inflate every bin by the share of pairs beyond it.
   normFactor = totalPPTfeatures * (totalPPTfeatures - 1);
   for(size_t i = 0; i < randomRDF.size(); i++)
   {
@@ -406,11 +697,30 @@ void FindFeatureClustering::find_clustering()
   //    }
   //    testFile7.close();
 
+  storeClusteringLists(clusteredFeatures, clusteringLists);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::storeClusteringLists(const std::vector<int32_t>& clusteredFeatures, std::vector<std::vector<float>>& clusteringLists)
+{
+  if(!m_StoreClusteringList)
+  {
+    return;
+  }
+
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  size_t position = 0;
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the Clustering Object
     NeighborList<float>::SharedVectorType sharedClustLst(new std::vector<float>);
-    sharedClustLst->assign(clusteringlist[i].begin(), clusteringlist[i].end());
+    if(position < clusteredFeatures.size() && clusteredFeatures[position] == static_cast<int32_t>(i))
+    {
+      sharedClustLst->swap(clusteringLists[position]);
+      position++;
+    }
     m_ClusteringList.lock()->setList(static_cast<int>(i), sharedClustLst);
   }
 }
@@ -696,3 +1006,39 @@ uint64_t FindFeatureClustering::getRandomSeedValue() const
 {
   return m_RandomSeedValue;
 }
+
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setStoreClusteringList(bool value)
+{
+  m_StoreClusteringList = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindFeatureClustering::getStoreClusteringList() const
+{
+  return m_StoreClusteringList;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setUseMaxSeparationDistance(bool value)
+{
+  m_UseMaxSeparationDistance = value;
+}
+
+// -----------------------------------------------------------------------------
+bool FindFeatureClustering::getUseMaxSeparationDistance() const
+{
+  return m_UseMaxSeparationDistance;
+}
+
+// -----------------------------------------------------------------------------
+void FindFeatureClustering::setMaxSeparationDistance(float value)
+{
+  m_MaxSeparationDistance = value;
+}
+
+// -----------------------------------------------------------------------------
+float FindFeatureClustering::getMaxSeparationDistance() const
+{
+  return m_MaxSeparationDistance;
+}
@@ -37,6 +37,7 @@
 
 #include <memory>
 #include <random>
+#include <vector>
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
@@ -70,6 +71,9 @@ class StatsToolbox_EXPORT FindFeatureClustering : public AbstractFilter
   PYB11_PROPERTY(QString MaxMinArrayName READ getMaxMinArrayName WRITE setMaxMinArrayName)
   PYB11_PROPERTY(bool UseRandomSeed READ getUseRandomSeed WRITE setUseRandomSeed)
   PYB11_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
+  PYB11_PROPERTY(bool StoreClusteringList READ getStoreClusteringList WRITE setStoreClusteringList)
+  PYB11_PROPERTY(bool UseMaxSeparationDistance READ getUseMaxSeparationDistance WRITE setUseMaxSeparationDistance)
+  PYB11_PROPERTY(float MaxSeparationDistance READ getMaxSeparationDistance WRITE setMaxSeparationDistance)
   PYB11_END_BINDINGS()
   // End Python bindings declarations
 
@@ -256,6 +260,39 @@ public:
   uint64_t getRandomSeedValue() const;
   Q_PROPERTY(uint64_t RandomSeedValue READ getRandomSeedValue WRITE setRandomSeedValue)
 
+  /**
+   * @brief Setter property for StoreClusteringList
+   */
+  void setStoreClusteringList(bool value);
+  /**
+   * @brief Getter property for StoreClusteringList
+   * @return Value of StoreClusteringList
+   */
+  bool getStoreClusteringList() const;
+  Q_PROPERTY(bool StoreClusteringList READ getStoreClusteringList WRITE setStoreClusteringList)
+
+  /**
+   * @brief Setter property for UseMaxSeparationDistance
+   */
+  void setUseMaxSeparationDistance(bool value);
+  /**
+   * @brief Getter property for UseMaxSeparationDistance
+   * @return Value of UseMaxSeparationDistance
+   */
+  bool getUseMaxSeparationDistance() const;
+  Q_PROPERTY(bool UseMaxSeparationDistance READ getUseMaxSeparationDistance WRITE setUseMaxSeparationDistance)
+
+  /**
+   * @brief Setter property for MaxSeparationDistance
+   */
+  void setMaxSeparationDistance(float value);
+  /**
+   * @brief Getter property for MaxSeparationDistance
+   * @return Value of MaxSeparationDistance
+   */
+  float getMaxSeparationDistance() const;
+  Q_PROPERTY(float MaxSeparationDistance READ getMaxSeparationDistance WRITE setMaxSeparationDistance)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -333,6 +370,14 @@ protected:
    */
   void find_clustering();
 
+  /**
+   * @brief storeClusteringLists Moves the clustering list of each clustered Feature into the Clustering List
+   * array. Features of other phases get an empty list. Does nothing if the Clustering List is not stored
+   * @param clusteredFeatures Ids of the clustered Features in ascending order
+   * @param clusteringLists Separation distances of each clustered Feature, emptied on return
+   */
+  void storeClusteringLists(const std::vector<int32_t>& clusteredFeatures, std::vector<std::vector<float>>& clusteringLists);
+
 private:
   std::weak_ptr<DataArray<int32_t>> m_FeaturePhasesPtr;
   int32_t* m_FeaturePhases = nullptr;
@@ -361,6 +406,9 @@ private:
   QString m_MaxMinArrayName = {"RDFMaxMinDistances"};
   bool m_UseRandomSeed = true;
   uint64_t m_RandomSeedValue = std::mt19937::default_seed;
+  bool m_StoreClusteringList = {true};
+  bool m_UseMaxSeparationDistance = {false};
+  float m_MaxSeparationDistance = {1.0f};
 
   NeighborList<float>::WeakPointer m_ClusteringList;
   std::vector<float> m_RandomCentroids;
@@ -49,6 +49,7 @@
 #include "StatsToolbox/DistributionAnalysisOps/BetaOps.h"
 #include "StatsToolbox/DistributionAnalysisOps/LogNormalOps.h"
 #include "StatsToolbox/DistributionAnalysisOps/PowerLawOps.h"
+#include "StatsToolbox/StatsToolboxFilters/util/ParallelHistogram.hpp"
 
 // -----------------------------------------------------------------------------
 //
@@ -166,10 +167,10 @@ void FindFeatureHistogram::dataCheck()
 //
 // -----------------------------------------------------------------------------
 template <typename T>
-void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, int32_t* eIds, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
+void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, size_t numEnsembles, int32_t* eIds, int NumberOfBins, bool removeBiasedFeatures, bool* biasedFeatures)
 {
   typename DataArray<T>::Pointer featureArray = std::dynamic_pointer_cast<DataArray<T>>(inputData);
-  if(nullptr == featureArray)
+  if(nullptr == featureArray || NumberOfBins <= 0)
   {
     return;
   }
@@ -177,37 +178,27 @@ void findHistogram(IDataArray::Pointer inputData, int32_t* ensembleArray, int32_
   T* fPtr = featureArray->getPointer(0);
   size_t numfeatures = featureArray->getNumberOfTuples();
 
-  int32_t bin;
-  int32_t ensemble;
   float min = 1000000.0f;
   float max = 0.0f;
-  float value;
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    value = fPtr[i];
-    if(value > max)
-    {
-      max = value;
-    }
-    if(value < min)
-    {
-      min = value;
-    }
-  }
+  ParallelHistogram::FindRange(fPtr, 1, numfeatures, min, max);
   float stepsize = (max - min) / NumberOfBins;
 
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(!removeBiasedFeatures || !biasedFeatures[i])
+  // One histogram per Ensemble; the largest values fall into the last bin and biased Features are rejected
+  auto binOf = [fPtr, eIds, numEnsembles, min, stepsize, NumberOfBins, removeBiasedFeatures, biasedFeatures](size_t i) -> int64_t {
+    int32_t ensemble = eIds[i];
+    if((removeBiasedFeatures && biasedFeatures[i]) || ensemble < 0 || static_cast<size_t>(ensemble) >= numEnsembles)
     {
-      ensemble = eIds[i];
-      bin = (fPtr[i] - min) / stepsize;
-      if(bin >= NumberOfBins)
-      {
-        bin = NumberOfBins - 1;
-      }
-      ensembleArray[(NumberOfBins * ensemble) + bin]++;
+      return -1;
     }
+    auto offset = (fPtr[i] - min) / stepsize;
+    int64_t bin = offset >= NumberOfBins ? NumberOfBins - 1 : (offset > 0 ? static_cast<int64_t>(offset) : 0);
+    return static_cast<int64_t>(ensemble) * NumberOfBins + bin;
+  };
+  std::vector<uint64_t> counts;
+  ParallelHistogram::Count(binOf, 1, numfeatures, numEnsembles * NumberOfBins, counts);
+  for(size_t i = 0; i < counts.size(); i++)
+  {
+    ensembleArray[i] += static_cast<int32_t>(counts[i]);
   }
 }
 
@@ -234,51 +225,52 @@ void FindFeatureHistogram::execute()
     return;
   }
 
+  size_t numEnsembles = m_NewEnsembleArrayPtr.lock()->getNumberOfTuples();
   QString dType = inputData->getTypeAsString();
   IDataArray::Pointer p = IDataArray::NullPointer();
   if(dType.compare("int8_t") == 0)
   {
-    findHistogram<int8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int8_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint8_t") == 0)
   {
-    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint8_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int16_t") == 0)
   {
-    findHistogram<int16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int16_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint16_t") == 0)
   {
-    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint16_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int32_t") == 0)
   {
-    findHistogram<int32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int32_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint32_t") == 0)
   {
-    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint32_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("int64_t") == 0)
   {
-    findHistogram<int64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<int64_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("uint64_t") == 0)
   {
-    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<uint64_t>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("float") == 0)
   {
-    findHistogram<float>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<float>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("double") == 0)
   {
-    findHistogram<double>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<double>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
   else if(dType.compare("bool") == 0)
   {
-    findHistogram<bool>(inputData, m_NewEnsembleArray, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
+    findHistogram<bool>(inputData, m_NewEnsembleArray, numEnsembles, m_FeaturePhases, m_NumberOfBins, m_RemoveBiasedFeatures, m_BiasedFeatures);
   }
 }
 
@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
 
 #include <QtCore/QTextStream>
@@ -67,73 +69,188 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID31 = 31,
 };
 
+namespace
+{
+/**
+ * @brief The NeighborhoodGrid struct buckets the Feature bins into uniform cells that are
+ * m_CellWidth bins wide. The Features of each cell are stored contiguously in ascending order.
+ */
+struct NeighborhoodGrid
+{
+  int64_t m_CellWidth = 1;
+  int64_t m_BinMin[3] = {0, 0, 0};
+  int64_t m_Dims[3] = {1, 1, 1};
+  std::vector<size_t> m_CellStarts;
+  std::vector<int32_t> m_Features;
+
+  int64_t cellCoordinate(int64_t bin, size_t axis) const
+  {
+    return std::min(std::max((bin - m_BinMin[axis]) / m_CellWidth, static_cast<int64_t>(0)), m_Dims[axis] - 1);
+  }
+};
+
+/**
+ * @brief findReach Returns the largest bin offset that is still strictly less than the critical
+ * distance, or -1 if no offset qualifies.
+ */
+int64_t findReach(float criticalDistance)
+{
+  if(!(criticalDistance > 0.0f))
+  {
+    return -1;
+  }
+  // Keep an infinite distance from overflowing the bin arithmetic
+  return static_cast<int64_t>(std::min(std::ceil(static_cast<double>(criticalDistance)), 1.0e12)) - 1;
+}
+
+/**
+ * @brief buildNeighborhoodGrid Sizes the cells by the largest reach of any Feature so that a
+ * Feature finds its whole neighborhood in the cells adjacent to its own.
+ */
+NeighborhoodGrid buildNeighborhoodGrid(size_t totalFeatures, const std::vector<int64_t>& bins, const std::vector<int64_t>& reach)
+{
+  NeighborhoodGrid grid;
+  if(totalFeatures < 2)
+  {
+    grid.m_CellStarts.assign(2, 0);
+    return grid;
+  }
+
+  int64_t binMax[3] = {bins[3], bins[4], bins[5]};
+  grid.m_BinMin[0] = bins[3];
+  grid.m_BinMin[1] = bins[4];
+  grid.m_BinMin[2] = bins[5];
+  int64_t maxReach = 0;
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      grid.m_BinMin[axis] = std::min(grid.m_BinMin[axis], bins[3 * i + axis]);
+      binMax[axis] = std::max(binMax[axis], bins[3 * i + axis]);
+    }
+    maxReach = std::max(maxReach, reach[i]);
+  }
+
+  // Never let the grid hold more cells than Features
+  int64_t span = std::max({binMax[0] - grid.m_BinMin[0], binMax[1] - grid.m_BinMin[1], binMax[2] - grid.m_BinMin[2]}) + 1;
+  grid.m_CellWidth = std::max(maxReach, static_cast<int64_t>(1));
+  while(true)
+  {
+    double numCells = 1.0;
+    for(size_t axis = 0; axis < 3; axis++)
+    {
+      grid.m_Dims[axis] = (binMax[axis] - grid.m_BinMin[axis]) / grid.m_CellWidth + 1;
+      numCells *= static_cast<double>(grid.m_Dims[axis]);
+    }
+    if(numCells <= static_cast<double>(totalFeatures) || grid.m_CellWidth >= span)
+    {
+      break;
+    }
+    grid.m_CellWidth *= 2;
+  }
+
+  size_t numCells = static_cast<size_t>(grid.m_Dims[0] * grid.m_Dims[1] * grid.m_Dims[2]);
+  std::vector<size_t> cellIds(totalFeatures, 0);
+  grid.m_CellStarts.assign(numCells + 1, 0);
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    int64_t cx = grid.cellCoordinate(bins[3 * i], 0);
+    int64_t cy = grid.cellCoordinate(bins[3 * i + 1], 1);
+    int64_t cz = grid.cellCoordinate(bins[3 * i + 2], 2);
+    cellIds[i] = static_cast<size_t>((cz * grid.m_Dims[1] + cy) * grid.m_Dims[0] + cx);
+    grid.m_CellStarts[cellIds[i] + 1]++;
+  }
+  for(size_t c = 0; c < numCells; c++)
+  {
+    grid.m_CellStarts[c + 1] += grid.m_CellStarts[c];
+  }
+  std::vector<size_t> fill(grid.m_CellStarts.begin(), grid.m_CellStarts.end() - 1);
+  grid.m_Features.resize(totalFeatures - 1);
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    grid.m_Features[fill[cellIds[i]]++] = static_cast<int32_t>(i);
+  }
+  return grid;
+}
+} // namespace
+
+/**
+ * @brief The FindNeighborhoodsImpl class finds, for a range of Features, every other Feature whose
+ * bin lies within the critical distance of the Feature by only visiting the grid cells that overlap
+ * that distance. Each Feature owns its own list, so no locking is needed.
+ */
 class FindNeighborhoodsImpl
 {
 public:
-  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, float* centroids, const std::vector<int64_t>& bins, const std::vector<float>& criticalDistance)
+  FindNeighborhoodsImpl(FindNeighborhoods* filter, size_t totalFeatures, const std::vector<int64_t>& bins, const std::vector<int64_t>& reach, const NeighborhoodGrid& grid,
+                        std::vector<std::vector<int32_t>>& neighborhoodLists)
   : m_Filter(filter)
   , m_TotalFeatures(totalFeatures)
-  , m_Centroids(centroids)
   , m_Bins(bins)
-  , m_CriticalDistance(criticalDistance)
+  , m_Reach(reach)
+  , m_Grid(grid)
+  , m_NeighborhoodLists(neighborhoodLists)
   {
   }
 
   void convert(size_t start, size_t end) const
   {
-    int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-    float dBinX = 0, dBinY = 0, dBinZ = 0;
-    float criticalDistance1 = 0, criticalDistance2 = 0;
-
-    size_t increment = (end - start) / 100;
-    size_t incCount = 0;
     // NEVER start at 0.
     if(start == 0)
     {
       start = 1;
     }
+    size_t incCount = 0;
     for(size_t i = start; i < end; i++)
     {
       incCount++;
-      if(incCount == increment || i == end - 1)
+      if(incCount == 1000 || i == end - 1)
       {
+        m_Filter->updateProgress(incCount, m_TotalFeatures);
         incCount = 0;
-        m_Filter->updateProgress(increment, m_TotalFeatures);
+        if(m_Filter->getCancel())
+        {
+          break;
+        }
       }
-      if(m_Filter->getCancel())
+
+      std::vector<int32_t>& neighborhood = m_NeighborhoodLists[i];
+      neighborhood.clear();
+      int64_t reach = m_Reach[i];
+      if(reach < 0)
       {
-        break;
+        continue;
       }
-      // x = m_Centroids[3 * i];
-      // y = m_Centroids[3 * i + 1];
-      // z = m_Centroids[3 * i + 2];
-      bin1x = m_Bins[3 * i];
-      bin1y = m_Bins[3 * i + 1];
-      bin1z = m_Bins[3 * i + 2];
-      criticalDistance1 = m_CriticalDistance[i];
-
-      for(size_t j = i + 1; j < m_TotalFeatures; j++)
+      const int64_t* bin1 = m_Bins.data() + 3 * i;
+      int64_t cellMin[3] = {0, 0, 0};
+      int64_t cellMax[3] = {0, 0, 0};
+      for(size_t axis = 0; axis < 3; axis++)
       {
-        bin2x = m_Bins[3 * j];
-        bin2y = m_Bins[3 * j + 1];
-        bin2z = m_Bins[3 * j + 2];
-        criticalDistance2 = m_CriticalDistance[j];
-        // Use the llabs version of the "C" abs function because we are using int64_t
-        // do NOT try to use the std::abs() function as this is C++11 ONLY
-        dBinX = llabs(bin2x - bin1x);
-        dBinY = llabs(bin2y - bin1y);
-        dBinZ = llabs(bin2z - bin1z);
-
-        if(dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-        {
-          m_Filter->updateNeighborHood(i, j);
-        }
+        cellMin[axis] = m_Grid.cellCoordinate(bin1[axis] - reach, axis);
+        cellMax[axis] = m_Grid.cellCoordinate(bin1[axis] + reach, axis);
+      }
 
-        if(dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
+      for(int64_t cz = cellMin[2]; cz <= cellMax[2]; cz++)
+      {
+        for(int64_t cy = cellMin[1]; cy <= cellMax[1]; cy++)
         {
-          m_Filter->updateNeighborHood(j, i);
+          size_t rowStart = static_cast<size_t>((cz * m_Grid.m_Dims[1] + cy) * m_Grid.m_Dims[0]);
+          for(size_t f = m_Grid.m_CellStarts[rowStart + cellMin[0]]; f < m_Grid.m_CellStarts[rowStart + cellMax[0] + 1]; f++)
+          {
+            int32_t j = m_Grid.m_Features[f];
+            if(static_cast<size_t>(j) == i)
+            {
+              continue;
+            }
+            const int64_t* bin2 = m_Bins.data() + 3 * j;
+            if(std::abs(bin2[0] - bin1[0]) <= reach && std::abs(bin2[1] - bin1[1]) <= reach && std::abs(bin2[2] - bin1[2]) <= reach)
+            {
+              neighborhood.push_back(j);
+            }
+          }
         }
       }
+      std::sort(neighborhood.begin(), neighborhood.end());
     }
   }
 
@@ -145,9 +262,10 @@ public:
 private:
   FindNeighborhoods* m_Filter = nullptr;
   size_t m_TotalFeatures = 0;
-  float* m_Centroids = nullptr;
   const std::vector<int64_t>& m_Bins;
-  const std::vector<float>& m_CriticalDistance;
+  const std::vector<int64_t>& m_Reach;
+  const NeighborhoodGrid& m_Grid;
+  std::vector<std::vector<int32_t>>& m_NeighborhoodLists;
 };
 
 // -----------------------------------------------------------------------------
@@ -346,29 +464,31 @@ void FindNeighborhoods::execute()
     bins[3 * i + 2] = static_cast<int64_t>(zbin);
   }
 
+  std::vector<int64_t> reach(totalFeatures, -1);
+  for(size_t i = 1; i < totalFeatures; i++)
+  {
+    reach[i] = findReach(criticalDistance[i]);
+  }
+  NeighborhoodGrid grid = buildNeighborhoodGrid(totalFeatures, bins, reach);
+
   ParallelDataAlgorithm parallelAlgorithm;
   parallelAlgorithm.setRange({0, totalFeatures});
   parallelAlgorithm.setParallelizationEnabled(true);
-  parallelAlgorithm.execute(FindNeighborhoodsImpl(this, totalFeatures, m_Centroids, bins, criticalDistance));
+  parallelAlgorithm.execute(FindNeighborhoodsImpl(this, totalFeatures, bins, reach, grid, m_LocalNeighborhoodList));
+
+  if(getCancel())
+  {
+    return;
+  }
 
   for(size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(m_LocalNeighborhoodList[i].begin(), m_LocalNeighborhoodList[i].end());
+    m_Neighborhoods[i] = static_cast<int32_t>(m_LocalNeighborhoodList[i].size());
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(std::move(m_LocalNeighborhoodList[i])));
     m_NeighborhoodList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
   }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void FindNeighborhoods::updateNeighborHood(size_t sourceIndex, size_t destIndex)
-{
-  static std::mutex mutex;
-  std::lock_guard<std::mutex> lock(mutex);
-  m_Neighborhoods[sourceIndex]++;
-  m_LocalNeighborhoodList[sourceIndex].push_back(static_cast<int32_t>(destIndex));
+  m_LocalNeighborhoodList.clear();
 }
 
 // -----------------------------------------------------------------------------
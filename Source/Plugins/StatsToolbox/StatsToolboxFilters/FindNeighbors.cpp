@@ -35,8 +35,9 @@
 #include "FindNeighbors.h"
 
 #include <algorithm>
+#include <thread>
+#include <vector>
 
-#include <QtCore/QDateTime>
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -50,6 +51,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
@@ -62,6 +64,186 @@ enum createdPathID : RenameDataPath::DataID_t
   DataArrayID32 = 32,
 };
 
+namespace
+{
+/**
+ * @brief The NeighborFaceCounts struct holds the number of faces shared by each (Feature, neighbor) pair
+ * found in one slab. Keys pack the Feature Id in the upper and the neighbor Id in the lower 32 bits and are sorted.
+ */
+struct NeighborFaceCounts
+{
+  std::vector<uint64_t> keys;
+  std::vector<uint32_t> counts;
+};
+
+uint64_t packPair(int32_t high, int32_t low)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(high)) << 32) | static_cast<uint32_t>(low);
+}
+
+/**
+ * @brief markSurfaceFeatures Flags the Features that touch the outer surface of the volume by visiting
+ * only the outer shell of voxels. Single plane volumes only consider the X and Y borders.
+ */
+void markSurfaceFeatures(const int32_t* featureIds, const int64_t dims[3], bool* surfaceFeatures)
+{
+  bool is2D = (dims[2] == 1);
+  for(int64_t plane = 0; plane < dims[2]; plane++)
+  {
+    for(int64_t row = 0; row < dims[1]; row++)
+    {
+      bool wholeRow = (row == 0 || row == dims[1] - 1 || (!is2D && (plane == 0 || plane == dims[2] - 1)));
+      int64_t step = wholeRow ? 1 : std::max(dims[0] - 1, static_cast<int64_t>(1));
+      int64_t rowStart = (plane * dims[1] + row) * dims[0];
+      for(int64_t column = 0; column < dims[0]; column += step)
+      {
+        int32_t feature = featureIds[rowStart + column];
+        if(feature > 0)
+        {
+          surfaceFeatures[feature] = true;
+        }
+      }
+    }
+  }
+}
+} // namespace
+
+/**
+ * @brief The FindNeighborsSlabImpl class enumerates the faces that each voxel shares with a voxel of another
+ * Feature for a slab of rows. The faces are counted per (Feature, neighbor) pair in a buffer owned by the slab,
+ * so that the slabs can run concurrently. The number of such faces of each voxel is written to the boundary cells.
+ */
+class FindNeighborsSlabImpl
+{
+public:
+  FindNeighborsSlabImpl(const int32_t* featureIds, const int64_t dims[3], size_t rowsPerSlab, int8_t* boundaryCells, std::vector<NeighborFaceCounts>& slabCounts)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_RowsPerSlab(rowsPerSlab)
+  , m_BoundaryCells(boundaryCells)
+  , m_SlabCounts(slabCounts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numRows = static_cast<size_t>(m_Dims[1] * m_Dims[2]);
+    std::vector<uint64_t> faces;
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      faces.clear();
+      size_t rowEnd = std::min(numRows, (slab + 1) * m_RowsPerSlab);
+      for(size_t rowIndex = slab * m_RowsPerSlab; rowIndex < rowEnd; rowIndex++)
+      {
+        findRowFaces(static_cast<int64_t>(rowIndex), faces);
+      }
+      std::sort(faces.begin(), faces.end());
+
+      NeighborFaceCounts& counts = m_SlabCounts[slab];
+      counts.keys.clear();
+      counts.counts.clear();
+      for(uint64_t key : faces)
+      {
+        if(!counts.keys.empty() && counts.keys.back() == key)
+        {
+          counts.counts.back()++;
+        }
+        else
+        {
+          counts.keys.push_back(key);
+          counts.counts.push_back(1);
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  const int64_t* m_Dims = nullptr;
+  size_t m_RowsPerSlab = 1;
+  int8_t* m_BoundaryCells = nullptr;
+  std::vector<NeighborFaceCounts>& m_SlabCounts;
+
+  void findRowFaces(int64_t rowIndex, std::vector<uint64_t>& faces) const
+  {
+    int64_t row = rowIndex % m_Dims[1];
+    int64_t plane = rowIndex / m_Dims[1];
+    int64_t neighpoints[6] = {-m_Dims[0] * m_Dims[1], -m_Dims[0], -1, 1, m_Dims[0], m_Dims[0] * m_Dims[1]};
+    int64_t rowStart = rowIndex * m_Dims[0];
+    for(int64_t column = 0; column < m_Dims[0]; column++)
+    {
+      int64_t j = rowStart + column;
+      int8_t onsurf = 0;
+      int32_t feature = m_FeatureIds[j];
+      if(feature > 0)
+      {
+        bool good[6] = {plane > 0, row > 0, column > 0, column < m_Dims[0] - 1, row < m_Dims[1] - 1, plane < m_Dims[2] - 1};
+        for(int32_t k = 0; k < 6; k++)
+        {
+          if(!good[k])
+          {
+            continue;
+          }
+          int32_t neighborFeature = m_FeatureIds[j + neighpoints[k]];
+          if(neighborFeature != feature && neighborFeature > 0)
+          {
+            onsurf++;
+            faces.push_back(packPair(feature, neighborFeature));
+          }
+        }
+      }
+      if(nullptr != m_BoundaryCells)
+      {
+        m_BoundaryCells[j] = onsurf;
+      }
+    }
+  }
+};
+
+/**
+ * @brief The FindNeighborsReduceImpl class sorts the (neighbor, face count) entries of each Feature in the
+ * compressed neighbor array and merges the entries of the same neighbor that came from different slabs.
+ */
+class FindNeighborsReduceImpl
+{
+public:
+  FindNeighborsReduceImpl(const std::vector<size_t>& featureStarts, std::vector<uint64_t>& entries, std::vector<size_t>& numNeighbors)
+  : m_FeatureStarts(featureStarts)
+  , m_Entries(entries)
+  , m_NumNeighbors(numNeighbors)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t i = range.min(); i < range.max(); i++)
+    {
+      uint64_t* begin = m_Entries.data() + m_FeatureStarts[i];
+      uint64_t* end = m_Entries.data() + m_FeatureStarts[i + 1];
+      std::sort(begin, end);
+
+      size_t numUnique = 0;
+      for(uint64_t* entry = begin; entry != end; entry++)
+      {
+        if(numUnique > 0 && (begin[numUnique - 1] >> 32) == (*entry >> 32))
+        {
+          begin[numUnique - 1] += (*entry & 0xFFFFFFFFull);
+        }
+        else
+        {
+          begin[numUnique++] = *entry;
+        }
+      }
+      m_NumNeighbors[i] = numUnique;
+    }
+  }
+
+private:
+  const std::vector<size_t>& m_FeatureStarts;
+  std::vector<uint64_t>& m_Entries;
+  std::vector<size_t>& m_NumNeighbors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -243,190 +425,89 @@ void FindNeighbors::execute()
       static_cast<int64_t>(udims[2]),
   };
 
-  int64_t neighpoints[6] = {0, 0, 0, 0, 0, 0};
-  neighpoints[0] = -dims[0] * dims[1];
-  neighpoints[1] = -dims[0];
-  neighpoints[2] = -1;
-  neighpoints[3] = 1;
-  neighpoints[4] = dims[0];
-  neighpoints[5] = dims[0] * dims[1];
-
-  int64_t column = 0, row = 0, plane = 0;
-  int32_t feature = 0;
-  int32_t nnum = 0;
-  int8_t onsurf = 0;
-  bool good = false;
-  int64_t neighbor = 0;
-
-  std::vector<std::vector<int32_t>> neighborlist;
-  std::vector<std::vector<float>> neighborsurfacearealist;
-
-  int32_t nListSize = 100;
-  neighborlist.resize(totalFeatures);
-  neighborsurfacearealist.resize(totalFeatures);
-
-  uint64_t millis = QDateTime::currentMSecsSinceEpoch();
-  uint64_t currentMillis = millis;
-
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Initializing Neighbor Lists || %1% Complete").arg((static_cast<float>(i) / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
     m_NumNeighbors[i] = 0;
-    neighborlist[i].resize(nListSize);
-    neighborsurfacearealist[i].assign(nListSize, -1.0f);
     if(m_StoreSurfaceFeatures)
     {
       m_SurfaceFeatures[i] = false;
     }
   }
+  if(m_StoreSurfaceFeatures)
+  {
+    markSurfaceFeatures(m_FeatureIds, dims, m_SurfaceFeatures);
+  }
+
+  // Each slab of rows counts its own faces so that only the distinct pairs of all slabs are held at once
+  size_t numRows = static_cast<size_t>(dims[1] * dims[2]);
+  size_t numSlabs = std::max(static_cast<size_t>(1), std::min(numRows, static_cast<size_t>(8 * std::max(1u, std::thread::hardware_concurrency()))));
+  size_t rowsPerSlab = std::max(static_cast<size_t>(1), (numRows + numSlabs - 1) / numSlabs);
+  numSlabs = (numRows + rowsPerSlab - 1) / rowsPerSlab;
+  std::vector<NeighborFaceCounts> slabCounts(numSlabs);
 
-  for(size_t j = 0; j < totalPoints; j++)
+  notifyStatusMessage("Finding Neighbors || Determining Neighbor Lists");
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSlabs);
+  dataAlg.execute(FindNeighborsSlabImpl(m_FeatureIds, dims, rowsPerSlab, m_StoreBoundaryCells ? m_BoundaryCells : nullptr, slabCounts));
+
+  if(getCancel())
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Determining Neighbor Lists || %1% Complete").arg((static_cast<float>(j) / totalPoints) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
+    return;
+  }
 
-    if(getCancel())
+  // Gather the pairs of all slabs into a compressed array with one contiguous segment per Feature
+  std::vector<size_t> featureStarts(totalFeatures + 1, 0);
+  for(const NeighborFaceCounts& counts : slabCounts)
+  {
+    for(uint64_t key : counts.keys)
     {
-      return;
+      featureStarts[(key >> 32) + 1]++;
     }
-
-    onsurf = 0;
-    feature = m_FeatureIds[j];
-    if(feature > 0 && feature < neighborlist.size())
+  }
+  for(size_t i = 0; i < totalFeatures; i++)
+  {
+    featureStarts[i + 1] += featureStarts[i];
+  }
+  std::vector<uint64_t> entries(featureStarts[totalFeatures]);
+  {
+    std::vector<size_t> fill(featureStarts.begin(), featureStarts.end() - 1);
+    for(NeighborFaceCounts& counts : slabCounts)
     {
-      column = static_cast<int64_t>(j % m->getGeometryAs<ImageGeom>()->getXPoints());
-      row = static_cast<int64_t>((j / m->getGeometryAs<ImageGeom>()->getXPoints()) % m->getGeometryAs<ImageGeom>()->getYPoints());
-      plane = static_cast<int64_t>(j / (m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()));
-      if(m_StoreSurfaceFeatures)
-      {
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints()) - 1) || plane == 0 || plane == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getZPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() != 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-        if((column == 0 || column == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getXPoints() - 1)) || row == 0 ||
-            row == static_cast<int64_t>((m->getGeometryAs<ImageGeom>()->getYPoints() - 1))) &&
-           m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
-        {
-          m_SurfaceFeatures[feature] = true;
-        }
-      }
-      for(int32_t k = 0; k < 6; k++)
+      for(size_t p = 0; p < counts.keys.size(); p++)
       {
-        good = true;
-        neighbor = static_cast<int64_t>(j + neighpoints[k]);
-        if(k == 0 && plane == 0)
-        {
-          good = false;
-        }
-        if(k == 5 && plane == (m->getGeometryAs<ImageGeom>()->getZPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 1 && row == 0)
-        {
-          good = false;
-        }
-        if(k == 4 && row == (m->getGeometryAs<ImageGeom>()->getYPoints() - 1))
-        {
-          good = false;
-        }
-        if(k == 2 && column == 0)
-        {
-          good = false;
-        }
-        if(k == 3 && column == (m->getGeometryAs<ImageGeom>()->getXPoints() - 1))
-        {
-          good = false;
-        }
-        if(good && m_FeatureIds[neighbor] != feature && m_FeatureIds[neighbor] > 0)
-        {
-          onsurf++;
-          nnum = m_NumNeighbors[feature];
-          neighborlist[feature].push_back(m_FeatureIds[neighbor]);
-          nnum++;
-          m_NumNeighbors[feature] = nnum;
-        }
+        entries[fill[counts.keys[p] >> 32]++] = ((counts.keys[p] & 0xFFFFFFFFull) << 32) | counts.counts[p];
       }
-    }
-    if(m_StoreBoundaryCells)
-    {
-      m_BoundaryCells[j] = onsurf;
+      counts = NeighborFaceCounts();
     }
   }
 
+  notifyStatusMessage("Finding Neighbors || Calculating Surface Areas");
+  std::vector<size_t> numNeighbors(totalFeatures, 0);
+  dataAlg.setRange(0, totalFeatures);
+  dataAlg.execute(FindNeighborsReduceImpl(featureStarts, entries, numNeighbors));
+
+  if(getCancel())
+  {
+    return;
+  }
+
   FloatVec3Type spacing = m->getGeometryAs<ImageGeom>()->getSpacing();
 
   // We do this to create new set of NeighborList objects
   for(size_t i = 1; i < totalFeatures; i++)
   {
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if(currentMillis - millis > 1000)
-    {
-      QString ss = QObject::tr("Finding Neighbors || Calculating Surface Areas || %1% Complete").arg(((float)i / totalFeatures) * 100);
-      notifyStatusMessage(ss);
-      millis = QDateTime::currentMSecsSinceEpoch();
-    }
-
-    if(getCancel())
-    {
-      return;
-    }
-
-    QMap<int32_t, int32_t> neighToCount;
-    int32_t numneighs = static_cast<int32_t>(neighborlist[i].size());
-
-    // this increments the voxel counts for each feature
-    for(int32_t j = 0; j < numneighs; j++)
-    {
-      neighToCount[neighborlist[i][j]]++;
-    }
+    const uint64_t* featureEntries = entries.data() + featureStarts[i];
 
-    QMap<int32_t, int32_t>::Iterator neighiter = neighToCount.find(0);
-    neighToCount.erase(neighiter);
-    neighiter = neighToCount.find(-1);
-    neighToCount.erase(neighiter);
-    // Resize the features neighbor list to zero
-    neighborlist[i].resize(0);
-    neighborsurfacearealist[i].resize(0);
-
-    for(QMap<int32_t, int32_t>::iterator iter = neighToCount.begin(); iter != neighToCount.end(); ++iter)
+    // Set the vector for each list into the NeighborList Object
+    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>(numNeighbors[i]));
+    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>(numNeighbors[i]));
+    for(size_t n = 0; n < numNeighbors[i]; n++)
     {
-      int32_t neigh = iter.key();    // get the neighbor feature
-      int32_t number = iter.value(); // get the number of voxels
-      float area = float(number) * spacing[0] * spacing[1];
-
-      // Push the neighbor feature id back onto the list so we stay synced up
-      neighborlist[i].push_back(neigh);
-      neighborsurfacearealist[i].push_back(area);
+      (*sharedNeiLst)[n] = static_cast<int32_t>(featureEntries[n] >> 32);
+      (*sharedSAL)[n] = float(featureEntries[n] & 0xFFFFFFFFull) * spacing[0] * spacing[1];
     }
-    m_NumNeighbors[i] = int32_t(neighborlist[i].size());
-
-    // Set the vector for each list into the NeighborList Object
-    NeighborList<int32_t>::SharedVectorType sharedNeiLst(new std::vector<int32_t>);
-    sharedNeiLst->assign(neighborlist[i].begin(), neighborlist[i].end());
+    m_NumNeighbors[i] = static_cast<int32_t>(numNeighbors[i]);
     m_NeighborList.lock()->setList(static_cast<int32_t>(i), sharedNeiLst);
-
-    NeighborList<float>::SharedVectorType sharedSAL(new std::vector<float>);
-    sharedSAL->assign(neighborsurfacearealist[i].begin(), neighborsurfacearealist[i].end());
     m_SharedSurfaceAreaList.lock()->setList(static_cast<int32_t>(i), sharedSAL);
   }
 }
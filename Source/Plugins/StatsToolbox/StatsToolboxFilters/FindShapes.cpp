@@ -58,6 +58,7 @@
 #include "EbsdLib/Core/OrientationTransformation.hpp"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/FeatureMoments.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
 namespace
@@ -281,7 +282,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
 
   size_t xPoints = imageGeom->getXPoints();
   size_t yPoints = imageGeom->getYPoints();
@@ -297,89 +297,30 @@ void FindShapes::find_moments()
 
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
-  for(size_t i = 0; i < numfeatures; i++)
-  {
-    featureMoments[6 * i + 0] = 0.0;
-    featureMoments[6 * i + 1] = 0.0;
-    featureMoments[6 * i + 2] = 0.0;
-    featureMoments[6 * i + 3] = 0.0;
-    featureMoments[6 * i + 4] = 0.0;
-    featureMoments[6 * i + 5] = 0.0;
-  }
-
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for(size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for(size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for(size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = featureIds[zStride + yStride + k];
-        x = float(k * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-        y = float(j * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-        z = float(i * modZRes) + (origin[2] * static_cast<float>(m_ScaleFactor));
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist1 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist1 = (z1 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist2 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist2 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist2 = (z2 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist3 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist3 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist3 = (z1 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist4 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist4 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist4 = (z2 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist5 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist5 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist5 = (z1 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist6 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist6 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist6 = (z2 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist7 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist7 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist7 = (z1 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-        xdist8 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-        ydist8 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-        zdist8 = (z2 - (centroids[gnum * 3 + 2] * static_cast<float>(m_ScaleFactor)));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3)) + ((ydist4) * (ydist4)) +
-             ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6)) + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) +
-             ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3)) + ((xdist4) * (xdist4)) +
-             ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6)) + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) +
-             ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3)) + ((xdist4) * (xdist4)) +
-             ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6)) + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) +
-             ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6)) + ((xdist7) * (ydist7)) +
-             ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6)) + ((ydist7) * (zdist7)) +
-             ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6)) + ((xdist7) * (zdist7)) +
-             ((xdist8) * (zdist8));
-
-        featureMoments[gnum * 6 + 0] = featureMoments[gnum * 6 + 0] + static_cast<double>(xx);
-        featureMoments[gnum * 6 + 1] = featureMoments[gnum * 6 + 1] + static_cast<double>(yy);
-        featureMoments[gnum * 6 + 2] = featureMoments[gnum * 6 + 2] + static_cast<double>(zz);
-        featureMoments[gnum * 6 + 3] = featureMoments[gnum * 6 + 3] + static_cast<double>(xy);
-        featureMoments[gnum * 6 + 4] = featureMoments[gnum * 6 + 4] + static_cast<double>(yz);
-        featureMoments[gnum * 6 + 5] = featureMoments[gnum * 6 + 5] + static_cast<double>(xz);
-        volumes[gnum] = volumes[gnum] + 1.0;
-      }
-    }
+  FeatureMoments moments(numfeatures, FeatureMoments::Order::Second);
+  moments.compute(featureIds.getPointer(0), {xPoints, yPoints, zPoints});
+
+  // Each voxel is broken into 8 sub-voxels offset by a quarter of the resolution, which adds a constant term for
+  // every voxel but cancels from the products of different axes
+  std::array<double, 3> modRes = {modXRes, modYRes, modZRes};
+  std::array<double, 3> quarterSq = {modRes[0] * modRes[0] / 16.0, modRes[1] * modRes[1] / 16.0, modRes[2] * modRes[2] / 16.0};
+  for(size_t featureId = 0; featureId < numfeatures; featureId++)
+  {
+    double count = static_cast<double>(moments.getCount(featureId));
+    std::array<double, 3> center = {(centroids[featureId * 3 + 0] - origin[0]) / spacing[0], (centroids[featureId * 3 + 1] - origin[1]) / spacing[1],
+                                    (centroids[featureId * 3 + 2] - origin[2]) / spacing[2]};
+    std::array<double, 6> m2 = moments.getSecondMoments(featureId, center);
+    double xx = m2[0] * modRes[0] * modRes[0];
+    double yy = m2[1] * modRes[1] * modRes[1];
+    double zz = m2[2] * modRes[2] * modRes[2];
+
+    featureMoments[featureId * 6 + 0] = 8.0 * (yy + zz + count * (quarterSq[1] + quarterSq[2]));
+    featureMoments[featureId * 6 + 1] = 8.0 * (xx + zz + count * (quarterSq[0] + quarterSq[2]));
+    featureMoments[featureId * 6 + 2] = 8.0 * (xx + yy + count * (quarterSq[0] + quarterSq[1]));
+    featureMoments[featureId * 6 + 3] = 8.0 * m2[3] * modRes[0] * modRes[1];
+    featureMoments[featureId * 6 + 4] = 8.0 * m2[4] * modRes[1] * modRes[2];
+    featureMoments[featureId * 6 + 5] = 8.0 * m2[5] * modRes[0] * modRes[2];
+    volumes[featureId] = static_cast<float>(count);
   }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
@@ -391,8 +332,8 @@ void FindShapes::find_moments()
   for(size_t featureId = 1; featureId < numfeatures; featureId++)
   {
     // calculating the modified volume for the omega3 value
-    vol5 = volumes[featureId] * konst3;
-    volumes[featureId] = volumes[featureId] * konst2;
+    vol5 = static_cast<double>(moments.getCount(featureId)) * konst3;
+    volumes[featureId] = static_cast<double>(moments.getCount(featureId)) * konst2;
     featureMoments[featureId * 6 + 0] = featureMoments[featureId * 6 + 0] * konst1;
     featureMoments[featureId * 6 + 1] = featureMoments[featureId * 6 + 1] * konst1;
     featureMoments[featureId * 6 + 2] = featureMoments[featureId * 6 + 2] * konst1;
@@ -473,7 +414,6 @@ void FindShapes::find_moments2D()
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
   ImageGeom::Pointer imageGeom = m->getGeometryAs<ImageGeom>();
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
 
   size_t xPoints = 0, yPoints = 0;
@@ -503,40 +443,25 @@ void FindShapes::find_moments2D()
 
   FloatVec3Type origin = imageGeom->getOrigin();
 
-  for(size_t featureId = 0; featureId < 6 * numfeatures; featureId++)
-  {
-    featureMoments[featureId] = 0.0;
-  }
-
-  size_t yStride = 0;
-  for(size_t yPoint = 0; yPoint < yPoints; yPoint++)
-  {
-    yStride = yPoint * xPoints;
-    for(size_t xPoint = 0; xPoint < xPoints; xPoint++)
-    {
-      int32_t gnum = featureIds[yStride + xPoint];
-      float x = static_cast<float>(xPoint * modXRes) + (origin[0] * static_cast<float>(m_ScaleFactor));
-      float y = static_cast<float>(yPoint * modYRes) + (origin[1] * static_cast<float>(m_ScaleFactor));
-      float x1 = x + (modXRes / 4.0f);
-      float x2 = x - (modXRes / 4.0f);
-      float y1 = y + (modYRes / 4.0f);
-      float y2 = y - (modYRes / 4.0f);
-      float xdist1 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      float ydist1 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      float xdist2 = (x1 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      float ydist2 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      float xdist3 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      float ydist3 = (y1 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      float xdist4 = (x2 - (centroids[gnum * 3 + 0] * static_cast<float>(m_ScaleFactor)));
-      float ydist4 = (y2 - (centroids[gnum * 3 + 1] * static_cast<float>(m_ScaleFactor)));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      featureMoments[gnum * 6 + 0] = featureMoments[gnum * 6 + 0] + xx;
-      featureMoments[gnum * 6 + 1] = featureMoments[gnum * 6 + 1] + yy;
-      featureMoments[gnum * 6 + 2] = featureMoments[gnum * 6 + 2] + xy;
-      volumes[gnum] = volumes[gnum] + 1.0;
-    }
+  FeatureMoments moments(numfeatures, FeatureMoments::Order::Second);
+  moments.compute(featureIds.getPointer(0), {xPoints, yPoints, 1});
+
+  // Each pixel is broken into 4 sub-pixels offset by a quarter of the resolution
+  std::array<double, 2> modRes = {modXRes, modYRes};
+  std::array<double, 2> quarterSq = {modRes[0] * modRes[0] / 16.0, modRes[1] * modRes[1] / 16.0};
+  for(size_t featureId = 0; featureId < numfeatures; featureId++)
+  {
+    double count = static_cast<double>(moments.getCount(featureId));
+    std::array<double, 3> center = {(centroids[featureId * 3 + 0] - origin[0]) / spacing[0], (centroids[featureId * 3 + 1] - origin[1]) / spacing[1], 0.0};
+    std::array<double, 6> m2 = moments.getSecondMoments(featureId, center);
+
+    featureMoments[featureId * 6 + 0] = 4.0 * (m2[1] * modRes[1] * modRes[1] + count * quarterSq[1]);
+    featureMoments[featureId * 6 + 1] = 4.0 * (m2[0] * modRes[0] * modRes[0] + count * quarterSq[0]);
+    featureMoments[featureId * 6 + 2] = 4.0 * m2[3] * modRes[0] * modRes[1];
+    featureMoments[featureId * 6 + 3] = 0.0;
+    featureMoments[featureId * 6 + 4] = 0.0;
+    featureMoments[featureId * 6 + 5] = 0.0;
+    volumes[featureId] = static_cast<float>(count);
   }
   double konst1 = static_cast<double>((modXRes / 2.0f) * (modYRes / 2.0f));
   double konst2 = static_cast<double>(spacing[0] * spacing[1]);
@@ -546,7 +471,7 @@ void FindShapes::find_moments2D()
     // Eq. 11 Omega 2
     // E1. 13 Omega 1
     // xx = u20 =
-    volumes[featureId] = volumes[featureId] * konst2;                                // Area
+    volumes[featureId] = static_cast<double>(moments.getCount(featureId)) * konst2;  // Area
     featureMoments[featureId * 6 + 0] = featureMoments[featureId * 6 + 0] * konst1;  // u20
     featureMoments[featureId * 6 + 1] = featureMoments[featureId * 6 + 1] * konst1;  // u02
     featureMoments[featureId * 6 + 2] = -featureMoments[featureId * 6 + 2] * konst1; // u11
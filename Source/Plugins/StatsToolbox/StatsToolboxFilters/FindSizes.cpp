@@ -34,6 +34,8 @@
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FindSizes.h"
 
+#include <vector>
+
 #include <QtCore/QTextStream>
 
 #include "SIMPLib/Common/Constants.h"
@@ -49,6 +51,7 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "StatsToolbox/StatsToolboxConstants.h"
+#include "StatsToolbox/StatsToolboxFilters/util/FeatureMoments.h"
 #include "StatsToolbox/StatsToolboxVersion.h"
 
 /* Create Enumerations to allow the created Attribute Arrays to take part in renaming */
@@ -186,23 +189,20 @@ void FindSizes::dataCheck()
 // -----------------------------------------------------------------------------
 void FindSizes::findSizesImage(ImageGeom::Pointer image)
 {
-  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t numfeatures = m_VolumesPtr.lock()->getNumberOfTuples();
 
-  DataArray<uint64_t>::Pointer m_FeatureCounts = DataArray<uint64_t>::CreateArray(numfeatures, std::string("_INTERNAL_USE_ONLY_FeatureCounts"), true);
-  m_FeatureCounts->initializeWithZeros();
-  uint64_t* featurecounts = m_FeatureCounts->getPointer(0);
+  FeatureMoments moments(numfeatures, FeatureMoments::Order::Count);
+  moments.compute(m_FeatureIds, {image->getXPoints(), image->getYPoints(), image->getZPoints()});
+  std::vector<uint64_t> featurecounts(numfeatures, 0);
+  for(size_t i = 0; i < numfeatures; i++)
+  {
+    featurecounts[i] = moments.getCount(i);
+  }
 
   float rad = 0.0f;
   float diameter = 0.0f;
   float res_scalar = 0.0f;
 
-  for(size_t j = 0; j < totalPoints; j++)
-  {
-    int32_t gnum = m_FeatureIds[j];
-    featurecounts[gnum]++;
-  }
-
   FloatVec3Type spacing = image->getSpacing();
 
   if(image->getXPoints() == 1 || image->getYPoints() == 1 || image->getZPoints() == 1)
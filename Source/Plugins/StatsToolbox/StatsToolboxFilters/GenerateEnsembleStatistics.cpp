@@ -35,6 +35,9 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QDebug>
 #include <QtCore/QTextStream>
 
@@ -58,6 +61,8 @@
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
 #include "SIMPLib/StatsData/TransformationStatsData.h"
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+#include "SIMPLib/Utilities/ParallelTaskAlgorithm.h"
 
 #include "EbsdLib/Core/EbsdLibConstants.h"
 #include "EbsdLib/Core/Orientation.hpp"
@@ -82,6 +87,185 @@ enum createdPathID : RenameDataPath::DataID_t
 // FIXME: #2 Need to fix phase selectionWidget to not show phase 0
 // FIXME: #3 Need to link phase selectionWidget to option to include Radial Distribution Function instead of an extra linkedProps boolean.
 
+namespace
+{
+// Number of Features that share one copy of the moments while they are gathered
+constexpr size_t k_FeaturesPerChunk = 16384;
+
+/**
+ * @brief The SizeCorrelatedBins struct places the size bins of every Ensemble one after the other in a single
+ * array of moments. Ensembles that are not correlated with size have no bins.
+ */
+struct SizeCorrelatedBins
+{
+  std::vector<size_t> offsets;
+  std::vector<float> minDiameters;
+  std::vector<float> binSteps;
+
+  SizeCorrelatedBins(size_t numEnsembles)
+  : offsets(numEnsembles + 1, 0)
+  , minDiameters(numEnsembles, 0.0f)
+  , binSteps(numEnsembles, 0.0f)
+  {
+  }
+
+  void setEnsemble(size_t ensemble, size_t numBins, float minDiameter, float binStep)
+  {
+    offsets[ensemble + 1] = numBins;
+    minDiameters[ensemble] = minDiameter;
+    binSteps[ensemble] = binStep;
+  }
+
+  /**
+   * @brief finalize Turns the number of bins of each Ensemble into the offset of its first bin
+   */
+  void finalize()
+  {
+    for(size_t i = 1; i < offsets.size(); i++)
+    {
+      offsets[i] += offsets[i - 1];
+    }
+  }
+
+  size_t getTotalBins() const
+  {
+    return offsets.back();
+  }
+};
+
+/**
+ * @brief The SizeBinFunctor class returns the bin of the diameter of an unbiased Feature among the size bins of its
+ * Ensemble, or -1 if the Feature is biased or does not fall into a bin.
+ */
+class SizeBinFunctor
+{
+public:
+  SizeBinFunctor(const SizeCorrelatedBins& bins, const int32_t* featurePhases, const bool* biasedFeatures, const float* equivalentDiameters)
+  : m_Offsets(bins.offsets.data())
+  , m_MinDiameters(bins.minDiameters.data())
+  , m_BinSteps(bins.binSteps.data())
+  , m_NumEnsembles(bins.minDiameters.size())
+  , m_FeaturePhases(featurePhases)
+  , m_BiasedFeatures(biasedFeatures)
+  , m_EquivalentDiameters(equivalentDiameters)
+  {
+  }
+
+  int64_t operator()(size_t feature) const
+  {
+    int32_t phase = m_FeaturePhases[feature];
+    if(m_BiasedFeatures[feature] || phase < 0 || static_cast<size_t>(phase) >= m_NumEnsembles)
+    {
+      return -1;
+    }
+    float bin = (m_EquivalentDiameters[feature] - m_MinDiameters[phase]) / m_BinSteps[phase];
+    size_t numBins = m_Offsets[phase + 1] - m_Offsets[phase];
+    if(!(bin > -1.0f && bin < static_cast<float>(numBins)))
+    {
+      return -1;
+    }
+    return static_cast<int64_t>(m_Offsets[phase] + static_cast<size_t>(std::max(bin, 0.0f)));
+  }
+
+private:
+  const size_t* m_Offsets = nullptr;
+  const float* m_MinDiameters = nullptr;
+  const float* m_BinSteps = nullptr;
+  size_t m_NumEnsembles = 0;
+  const int32_t* m_FeaturePhases = nullptr;
+  const bool* m_BiasedFeatures = nullptr;
+  const float* m_EquivalentDiameters = nullptr;
+};
+
+/**
+ * @brief ensembleBins Returns the moments of one component of one Ensemble
+ */
+std::vector<DistributionMoments> ensembleBins(const std::vector<DistributionMoments>& moments, const SizeCorrelatedBins& bins, size_t component, size_t ensemble)
+{
+  size_t base = component * bins.getTotalBins();
+  return std::vector<DistributionMoments>(moments.begin() + base + bins.offsets[ensemble], moments.begin() + base + bins.offsets[ensemble + 1]);
+}
+} // namespace
+
+/**
+ * @brief The GatherEnsembleMomentsImpl class accumulates the values of a range of chunks of Features into the
+ * moments of their bins, each chunk into its own copy. binOf returns the bin of a Feature or -1 to skip it and
+ * valueOf returns one of the values of the Feature.
+ */
+template <typename BinFunctor, typename ValueFunctor>
+class GatherEnsembleMomentsImpl
+{
+public:
+  GatherEnsembleMomentsImpl(size_t numFeatures, size_t chunkSize, size_t numComponents, const BinFunctor& binOf, const ValueFunctor& valueOf, std::vector<std::vector<DistributionMoments>>& partials)
+  : m_NumFeatures(numFeatures)
+  , m_ChunkSize(chunkSize)
+  , m_NumComponents(numComponents)
+  , m_BinOf(binOf)
+  , m_ValueOf(valueOf)
+  , m_Partials(partials)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      std::vector<DistributionMoments>& moments = m_Partials[chunk];
+      int64_t numBins = static_cast<int64_t>(moments.size() / m_NumComponents);
+      size_t end = std::min(m_NumFeatures, (chunk + 1) * m_ChunkSize);
+      for(size_t i = std::max(static_cast<size_t>(1), chunk * m_ChunkSize); i < end; i++)
+      {
+        int64_t bin = m_BinOf(i);
+        if(bin < 0 || bin >= numBins)
+        {
+          continue;
+        }
+        for(size_t c = 0; c < m_NumComponents; c++)
+        {
+          moments[c * static_cast<size_t>(numBins) + static_cast<size_t>(bin)].add(m_ValueOf(i, c));
+        }
+      }
+    }
+  }
+
+private:
+  size_t m_NumFeatures = 0;
+  size_t m_ChunkSize = 1;
+  size_t m_NumComponents = 1;
+  BinFunctor m_BinOf;
+  ValueFunctor m_ValueOf;
+  std::vector<std::vector<DistributionMoments>>& m_Partials;
+};
+
+namespace
+{
+/**
+ * @brief gatherEnsembleMoments Accumulates numComponents values of every Feature except Feature 0 into numBins bins
+ * per component, laid out component after component. The chunks are merged in order, so the result does not
+ * depend on the number of threads.
+ */
+template <typename BinFunctor, typename ValueFunctor>
+std::vector<DistributionMoments> gatherEnsembleMoments(size_t numFeatures, size_t numBins, size_t numComponents, const BinFunctor& binOf, const ValueFunctor& valueOf)
+{
+  size_t chunkSize = std::max(k_FeaturesPerChunk, numBins * numComponents);
+  size_t numChunks = std::max(static_cast<size_t>(1), (numFeatures + chunkSize - 1) / chunkSize);
+  std::vector<std::vector<DistributionMoments>> partials(numChunks, std::vector<DistributionMoments>(numBins * numComponents));
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute(GatherEnsembleMomentsImpl<BinFunctor, ValueFunctor>(numFeatures, chunkSize, numComponents, binOf, valueOf, partials));
+
+  for(size_t chunk = 1; chunk < numChunks; chunk++)
+  {
+    for(size_t bin = 0; bin < partials[0].size(); bin++)
+    {
+      partials[0][bin].merge(partials[chunk][bin]);
+    }
+  }
+  return std::move(partials[0]);
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -626,7 +810,6 @@ void GenerateEnsembleStatistics::gatherSizeStats()
   float mindiam = 0.0f;
   float totalUnbiasedVolume = 0.0f;
   QVector<VectorOfFloatArray> sizedist;
-  std::vector<std::vector<std::vector<float>>> values;
 
   FloatArrayType::Pointer binnumbers;
   size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
@@ -634,21 +817,23 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 
   std::vector<float> fractions(numensembles, 0.0f);
   sizedist.resize(numensembles);
-  values.resize(numensembles);
 
   for(size_t i = 1; i < numensembles; i++)
   {
     sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
-    values[i].resize(1);
   }
 
+  // A single size bin per Ensemble that holds the diameters of its unbiased Features
+  const int32_t* featurePhases = m_FeaturePhases;
+  const bool* biasedFeatures = m_BiasedFeatures;
+  const float* equivalentDiameters = m_EquivalentDiameters;
+  std::vector<DistributionMoments> values = gatherEnsembleMoments(
+      numfeatures, numensembles, 1, [featurePhases, biasedFeatures](size_t i) -> int64_t { return biasedFeatures[i] ? -1 : featurePhases[i]; },
+      [equivalentDiameters](size_t i, size_t) { return equivalentDiameters[i]; });
+
   float vol = 0.0f;
   for(size_t i = 1; i < numfeatures; i++)
   {
-    if(!m_BiasedFeatures[i])
-    {
-      values[m_FeaturePhases[i]][0].push_back(m_EquivalentDiameters[i]);
-    }
     vol = (1.0f / 6.0f) * SIMPLib::Constants::k_PiD * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
     fractions[m_FeaturePhases[i]] = fractions[m_FeaturePhases[i]] + vol;
     totalUnbiasedVolume = totalUnbiasedVolume + vol;
@@ -664,9 +849,9 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(std::vector<DistributionMoments>(1, values[i]), sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values[i], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber, true);
@@ -677,9 +862,9 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(std::vector<DistributionMoments>(1, values[i]), sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values[i], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber, true);
@@ -690,9 +875,9 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
       tp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(std::vector<DistributionMoments>(1, values[i]), sizedist[i]);
       tp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
+      DistributionAnalysisOps::determineMaxAndMinValues(values[i], maxdiam, mindiam);
       int numbins = int(maxdiam / m_SizeCorrelationResolution) + 1;
       tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, SIMPL::StringConstants::BinNumber, true);
@@ -709,22 +894,14 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> boveras;
   QVector<VectorOfFloatArray> coveras;
-  std::vector<std::vector<std::vector<float>>> bvalues;
-  std::vector<std::vector<std::vector<float>>> cvalues;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
   size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  SizeCorrelatedBins bins(numensembles);
 
   boveras.resize(numensembles);
   coveras.resize(numensembles);
-  bvalues.resize(numensembles);
-  cvalues.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
@@ -732,69 +909,52 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
       boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
       coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
       boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
       coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
       boveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
       coveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      bvalues[i].resize(tp->getBinNumbers()->getSize());
-      cvalues[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
-    }
-  }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        bvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i]);
-        cvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i + 1]);
-      }
+      bins.setEnsemble(i, tp->getBinNumbers()->getSize(), tp->getMinFeatureDiameter(), tp->getBinStepSize());
     }
   }
+
+  // Each unbiased Feature of a size correlated Ensemble goes into the size bin of its diameter
+  bins.finalize();
+  SizeBinFunctor binOf(bins, m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters);
+  std::vector<DistributionMoments> values = gatherEnsembleMoments(numfeatures, bins.getTotalBins(), 2, binOf, [aspectRatios = m_AspectRatios](size_t i, size_t c) { return aspectRatios[2 * i + c]; });
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 1, i), coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 1, i), coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 1, i), coveras[i]);
       tp->setFeatureSize_BOverA(boveras[i]);
       tp->setFeatureSize_COverA(coveras[i]);
     }
@@ -808,76 +968,57 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> omega3s;
-  std::vector<std::vector<std::vector<float>>> values;
-  QVector<float> mindiams;
-  QVector<float> binsteps;
   size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  SizeCorrelatedBins bins(numensembles);
 
   omega3s.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
       omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
       omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
       omega3s[i] = tp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
-    }
-  }
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(m_Omega3s[i]);
-      }
+      bins.setEnsemble(i, tp->getBinNumbers()->getSize(), tp->getMinFeatureDiameter(), tp->getBinStepSize());
     }
   }
+
+  // Each unbiased Feature of a size correlated Ensemble goes into the size bin of its diameter
+  bins.finalize();
+  SizeBinFunctor binOf(bins, m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters);
+  std::vector<DistributionMoments> values = gatherEnsembleMoments(numfeatures, bins.getTotalBins(), 1, binOf, [omega3 = m_Omega3s](size_t i, size_t) { return omega3[i]; });
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), omega3s[i]);
       tp->setFeatureSize_Omegas(omega3s[i]);
     }
   }
@@ -890,82 +1031,94 @@ void GenerateEnsembleStatistics::gatherNeighborhoodStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> neighborhoods;
-  std::vector<std::vector<std::vector<float>>> values;
-  std::vector<float> mindiams;
-  std::vector<float> binsteps;
   size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  SizeCorrelatedBins bins(numensembles);
 
   neighborhoods.resize(numensembles);
-  values.resize(numensembles);
-  mindiams.resize(numensembles);
-  binsteps.resize(numensembles);
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
       neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
       neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
-      mindiams[i] = pp->getMinFeatureDiameter();
-      binsteps[i] = pp->getBinStepSize();
+      bins.setEnsemble(i, pp->getBinNumbers()->getSize(), pp->getMinFeatureDiameter(), pp->getBinStepSize());
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
       neighborhoods[i] = tp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
-      mindiams[i] = tp->getMinFeatureDiameter();
-      binsteps[i] = tp->getBinStepSize();
+      bins.setEnsemble(i, tp->getBinNumbers()->getSize(), tp->getMinFeatureDiameter(), tp->getBinStepSize());
     }
   }
 
-  for(size_t i = 1; i < numfeatures; i++)
-  {
-    if(m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate) ||
-       m_PhaseTypes[m_FeaturePhases[i]] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
-    {
-      if(!m_BiasedFeatures[i])
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(static_cast<float>(m_Neighborhoods[i]));
-      }
-    }
-  }
+  bins.finalize();
+  SizeBinFunctor binOf(bins, m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters);
+  std::vector<DistributionMoments> values = gatherEnsembleMoments(numfeatures, bins.getTotalBins(), 1, binOf, [neighborhoodCounts = m_Neighborhoods](size_t i, size_t) { return static_cast<float>(neighborhoodCounts[i]); });
+
   for(size_t i = 1; i < numensembles; i++)
   {
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Primary))
     {
       PrimaryStatsData::Pointer pp = std::dynamic_pointer_cast<PrimaryStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), neighborhoods[i]);
       pp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Precipitate))
     {
       PrecipitateStatsData::Pointer pp = std::dynamic_pointer_cast<PrecipitateStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), neighborhoods[i]);
       pp->setFeatureSize_Clustering(neighborhoods[i]);
     }
     if(m_PhaseTypes[i] == static_cast<PhaseType::EnumType>(PhaseType::Type::Transformation))
     {
       TransformationStatsData::Pointer tp = std::dynamic_pointer_cast<TransformationStatsData>(statsDataArray[i]);
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(ensembleBins(values, bins, 0, i), neighborhoods[i]);
       tp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GenerateEnsembleStatistics::validateODFLaueClasses()
+{
+  std::vector<LaueOps::Pointer> m_OrientationOps = LaueOps::GetAllOrientationOps();
+  size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
+  for(size_t i = 1; i < numensembles; i++)
+  {
+    uint32_t laueClass = m_CrystalStructures[i];
+    if(laueClass != EbsdLib::CrystalStructure::Hexagonal_High && laueClass != EbsdLib::CrystalStructure::Cubic_High)
+    {
+      QString errorMessage;
+      QTextStream out(&errorMessage);
+      out << "The option 'Calculate Crystallographic Statistics' only works with Laue classes [Cubic m3m] and [Hexagonal 6/mmm]. ";
+      out << "The offending phase was " << i << " with a value of " << QString::fromStdString(m_OrientationOps[laueClass]->getSymmetryName());
+      out << ".\nThe following Laue classes were also found [Phase #] Laue Class:\n";
+      for(size_t e = 1; e < numensembles; e++)
+      {
+        uint32_t lc = m_CrystalStructures[e];
+        out << "  [" << QString::number(e) << "] " << QString::fromStdString(m_OrientationOps[lc]->getSymmetryName());
+        if(e < numensembles - 1)
+        {
+          out << "\n";
+        }
+      }
+      setErrorCondition(-3015, errorMessage);
+      return false;
+    }
+  }
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1005,25 +1158,6 @@ void GenerateEnsembleStatistics::gatherODFStats()
         eulerodf[i]->setValue(j, 0.0);
       }
     }
-    else
-    {
-      QString errorMessage;
-      QTextStream out(&errorMessage);
-      out << "The option 'Calculate Crystallographic Statistics' only works with Laue classes [Cubic m3m] and [Hexagonal 6/mmm]. ";
-      out << "The offending phase was " << i << " with a value of " << QString::fromStdString(m_OrientationOps[laueClass]->getSymmetryName());
-      out << ".\nThe following Laue classes were also found [Phase #] Laue Class:\n";
-      for(size_t e = 1; e < numensembles; e++)
-      {
-        uint32_t lc = m_CrystalStructures[e];
-        out << "  [" << QString::number(e) << "] " << QString::fromStdString(m_OrientationOps[lc]->getSymmetryName());
-        if(e < numensembles - 1)
-        {
-          out << "\n";
-        }
-      }
-      setErrorCondition(-3015, errorMessage);
-      return;
-    }
   }
   for(size_t i = 1; i < numfeatures; i++)
   {
@@ -1402,44 +1536,48 @@ void GenerateEnsembleStatistics::execute()
     m_StatsDataArray->fillArrayWithNewStatsData(m_PhaseTypesPtr.lock()->getNumberOfTuples(), m_PhaseTypes);
   }
 
+  // The size bins are needed by the size correlated statistics, everything else is independent
   if(m_ComputeSizeDistribution)
   {
     gatherSizeStats();
   }
+  bool validODF = !m_CalculateODF || validateODFLaueClasses();
+
+  // Each stage writes different members of the StatsData of each Ensemble, so the stages run concurrently
+  ParallelTaskAlgorithm taskAlg;
   if(m_ComputeAspectRatioDistribution)
   {
-    gatherAspectRatioStats();
+    taskAlg.execute([this]() { gatherAspectRatioStats(); });
   }
   if(m_ComputeOmega3Distribution)
   {
-    gatherOmega3Stats();
+    taskAlg.execute([this]() { gatherOmega3Stats(); });
   }
   if(m_ComputeNeighborhoodDistribution)
   {
-    gatherNeighborhoodStats();
+    taskAlg.execute([this]() { gatherNeighborhoodStats(); });
   }
-  if(m_CalculateODF)
-  {
-    gatherODFStats();
-  }
-  if(getErrorCode() < 0)
-  {
-    return;
-  }
-  if(m_CalculateMDF)
-  {
-    gatherMDFStats();
-  }
-  if(m_CalculateAxisODF)
+  if(m_CalculateODF && validODF)
   {
-    gatherAxisODFStats();
+    taskAlg.execute([this]() { gatherODFStats(); });
   }
-  if(m_IncludeRadialDistFunc)
+  if(getErrorCode() >= 0)
   {
-    gatherRadialDistFunc();
+    if(m_CalculateMDF)
+    {
+      taskAlg.execute([this]() { gatherMDFStats(); });
+    }
+    if(m_CalculateAxisODF)
+    {
+      taskAlg.execute([this]() { gatherAxisODFStats(); });
+    }
+    if(m_IncludeRadialDistFunc)
+    {
+      taskAlg.execute([this]() { gatherRadialDistFunc(); });
+    }
+    taskAlg.execute([this]() { calculatePPTBoundaryFrac(); });
   }
-
-  calculatePPTBoundaryFrac();
+  taskAlg.wait();
 }
 
 // -----------------------------------------------------------------------------
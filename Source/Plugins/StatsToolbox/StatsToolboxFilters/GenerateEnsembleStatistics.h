@@ -644,6 +644,13 @@ protected:
    */
   void gatherMDFStats();
 
+  /**
+   * @brief validateODFLaueClasses Checks that the ODF can be computed for the Laue class of every Ensemble and
+   * sets an error condition if it cannot
+   * @return Boolean check for whether all Laue classes are supported
+   */
+  bool validateODFLaueClasses();
+
   /**
    * @brief gatherODFStats Consolidates Feature ODF statistics
    */
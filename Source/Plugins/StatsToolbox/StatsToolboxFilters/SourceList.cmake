@@ -71,6 +71,9 @@ endforeach()
 
 ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.h)
 ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/MomentInvariants2D.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/FeatureMoments.h)
+ADD_SIMPL_SUPPORT_SOURCE(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/FeatureMoments.cpp)
+ADD_SIMPL_SUPPORT_HEADER(${${PLUGIN_NAME}_SOURCE_DIR} ${_filterGroupName} util/ParallelHistogram.hpp)
 
 
 SIMPL_END_FILTER_GROUP(${StatsToolbox_BINARY_DIR} "${_filterGroupName}" "StatsToolbox Filters")
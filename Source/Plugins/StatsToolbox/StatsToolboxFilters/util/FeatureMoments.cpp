@@ -0,0 +1,324 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureMoments.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace
+{
+// Axes of the second moments in the order xx, yy, zz, xy, yz, xz
+constexpr size_t k_MomentAxes[6][2] = {{0, 0}, {1, 1}, {2, 2}, {0, 1}, {1, 2}, {0, 2}};
+
+/**
+ * @brief mergeMomentSums Adds the sums of b to a after moving them to the shifted origin of a.
+ */
+void mergeMomentSums(FeatureMomentSums& a, const FeatureMomentSums& b, bool secondOrder)
+{
+  if(b.count == 0)
+  {
+    return;
+  }
+  if(a.count == 0)
+  {
+    a = b;
+    return;
+  }
+
+  std::array<int64_t, 3> d = {b.shift[0] - a.shift[0], b.shift[1] - a.shift[1], b.shift[2] - a.shift[2]};
+  if(secondOrder)
+  {
+    double n = static_cast<double>(b.count);
+    std::array<double, 3> dd = {static_cast<double>(d[0]), static_cast<double>(d[1]), static_cast<double>(d[2])};
+    std::array<double, 3> s = {static_cast<double>(b.sum[0]), static_cast<double>(b.sum[1]), static_cast<double>(b.sum[2])};
+    for(size_t m = 0; m < 6; m++)
+    {
+      size_t p = k_MomentAxes[m][0];
+      size_t q = k_MomentAxes[m][1];
+      a.sumSquares[m] += b.sumSquares[m] + dd[p] * s[q] + s[p] * dd[q] + n * dd[p] * dd[q];
+    }
+  }
+  for(size_t k = 0; k < 3; k++)
+  {
+    a.sum[k] += b.sum[k] + static_cast<int64_t>(b.count) * d[k];
+  }
+  a.count += b.count;
+}
+} // namespace
+
+/**
+ * @brief The FeatureCountSlabImpl class counts the voxels of every Feature for a range of slabs, each slab into its own counts.
+ */
+class FeatureCountSlabImpl
+{
+public:
+  FeatureCountSlabImpl(const int32_t* featureIds, size_t numVoxels, size_t voxelsPerSlab, std::vector<std::vector<uint64_t>>& partials)
+  : m_FeatureIds(featureIds)
+  , m_NumVoxels(numVoxels)
+  , m_VoxelsPerSlab(voxelsPerSlab)
+  , m_Partials(partials)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      std::vector<uint64_t>& counts = m_Partials[slab];
+      size_t numFeatures = counts.size();
+      size_t end = std::min(m_NumVoxels, (slab + 1) * m_VoxelsPerSlab);
+      for(size_t i = slab * m_VoxelsPerSlab; i < end; i++)
+      {
+        int32_t feature = m_FeatureIds[i];
+        if(feature >= 0 && static_cast<size_t>(feature) < numFeatures)
+        {
+          counts[feature]++;
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  size_t m_NumVoxels = 0;
+  size_t m_VoxelsPerSlab = 1;
+  std::vector<std::vector<uint64_t>>& m_Partials;
+};
+
+/**
+ * @brief The FeatureMomentSlabImpl class accumulates the moment sums of every Feature for a range of slabs of rows,
+ * each slab into its own sums.
+ */
+class FeatureMomentSlabImpl
+{
+public:
+  FeatureMomentSlabImpl(const int32_t* featureIds, const std::array<size_t, 3>& dims, size_t rowsPerSlab, bool secondOrder, std::vector<std::vector<FeatureMomentSums>>& partials)
+  : m_FeatureIds(featureIds)
+  , m_Dims(dims)
+  , m_RowsPerSlab(rowsPerSlab)
+  , m_SecondOrder(secondOrder)
+  , m_Partials(partials)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numRows = m_Dims[1] * m_Dims[2];
+    for(size_t slab = range.min(); slab < range.max(); slab++)
+    {
+      std::vector<FeatureMomentSums>& sums = m_Partials[slab];
+      size_t numFeatures = sums.size();
+      size_t rowEnd = std::min(numRows, (slab + 1) * m_RowsPerSlab);
+      for(size_t rowIndex = slab * m_RowsPerSlab; rowIndex < rowEnd; rowIndex++)
+      {
+        int64_t y = static_cast<int64_t>(rowIndex % m_Dims[1]);
+        int64_t z = static_cast<int64_t>(rowIndex / m_Dims[1]);
+        const int32_t* row = m_FeatureIds + rowIndex * m_Dims[0];
+        for(size_t column = 0; column < m_Dims[0]; column++)
+        {
+          int32_t feature = row[column];
+          if(feature < 0 || static_cast<size_t>(feature) >= numFeatures)
+          {
+            continue;
+          }
+          int64_t x = static_cast<int64_t>(column);
+          FeatureMomentSums& s = sums[feature];
+          if(s.count == 0)
+          {
+            s.shift = {x, y, z};
+          }
+          int64_t dx = x - s.shift[0];
+          int64_t dy = y - s.shift[1];
+          int64_t dz = z - s.shift[2];
+          s.count++;
+          s.sum[0] += dx;
+          s.sum[1] += dy;
+          s.sum[2] += dz;
+          if(m_SecondOrder)
+          {
+            s.sumSquares[0] += static_cast<double>(dx * dx);
+            s.sumSquares[1] += static_cast<double>(dy * dy);
+            s.sumSquares[2] += static_cast<double>(dz * dz);
+            s.sumSquares[3] += static_cast<double>(dx * dy);
+            s.sumSquares[4] += static_cast<double>(dy * dz);
+            s.sumSquares[5] += static_cast<double>(dx * dz);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const int32_t* m_FeatureIds = nullptr;
+  std::array<size_t, 3> m_Dims = {0, 0, 0};
+  size_t m_RowsPerSlab = 1;
+  bool m_SecondOrder = false;
+  std::vector<std::vector<FeatureMomentSums>>& m_Partials;
+};
+
+/**
+ * @brief The FeatureMomentMergeImpl class merges the slab sums of a range of Features into the first slab. The
+ * slabs are merged pairwise in a tree so that every partial sum is combined with one of similar size.
+ */
+class FeatureMomentMergeImpl
+{
+public:
+  FeatureMomentMergeImpl(bool secondOrder, std::vector<std::vector<FeatureMomentSums>>& partials)
+  : m_SecondOrder(secondOrder)
+  , m_Partials(partials)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    size_t numSlabs = m_Partials.size();
+    for(size_t feature = range.min(); feature < range.max(); feature++)
+    {
+      for(size_t stride = 1; stride < numSlabs; stride *= 2)
+      {
+        for(size_t slab = 0; slab + stride < numSlabs; slab += 2 * stride)
+        {
+          mergeMomentSums(m_Partials[slab][feature], m_Partials[slab + stride][feature], m_SecondOrder);
+        }
+      }
+    }
+  }
+
+private:
+  bool m_SecondOrder = false;
+  std::vector<std::vector<FeatureMomentSums>>& m_Partials;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureMoments::FeatureMoments(size_t numFeatures, Order order)
+: m_NumFeatures(numFeatures)
+, m_Order(order)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureMoments::~FeatureMoments() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureMoments::compute(const int32_t* featureIds, const std::array<size_t, 3>& dims)
+{
+  size_t numVoxels = dims[0] * dims[1] * dims[2];
+  size_t numRows = dims[1] * dims[2];
+  size_t bytesPerFeature = (m_Order == Order::Count) ? sizeof(uint64_t) : sizeof(FeatureMomentSums);
+
+  // Use one slab per thread, but never let the partial sums outgrow the Feature Ids themselves
+  size_t maxSlabs = std::max(static_cast<size_t>(1), (numVoxels * sizeof(int32_t)) / std::max(static_cast<size_t>(1), m_NumFeatures * bytesPerFeature));
+  size_t numSlabs = std::min({std::max(numRows, static_cast<size_t>(1)), static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())), maxSlabs});
+  size_t rowsPerSlab = std::max(static_cast<size_t>(1), (numRows + numSlabs - 1) / numSlabs);
+  numSlabs = std::max(static_cast<size_t>(1), (numRows + rowsPerSlab - 1) / rowsPerSlab);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numSlabs);
+
+  if(m_Order == Order::Count)
+  {
+    std::vector<std::vector<uint64_t>> partials(numSlabs, std::vector<uint64_t>(m_NumFeatures, 0));
+    dataAlg.execute(FeatureCountSlabImpl(featureIds, numVoxels, rowsPerSlab * dims[0], partials));
+    m_Counts = std::move(partials[0]);
+    for(size_t slab = 1; slab < numSlabs; slab++)
+    {
+      for(size_t feature = 0; feature < m_NumFeatures; feature++)
+      {
+        m_Counts[feature] += partials[slab][feature];
+      }
+    }
+    return;
+  }
+
+  bool secondOrder = (m_Order == Order::Second);
+  std::vector<std::vector<FeatureMomentSums>> partials(numSlabs, std::vector<FeatureMomentSums>(m_NumFeatures));
+  dataAlg.execute(FeatureMomentSlabImpl(featureIds, dims, rowsPerSlab, secondOrder, partials));
+
+  dataAlg.setRange(0, m_NumFeatures);
+  dataAlg.execute(FeatureMomentMergeImpl(secondOrder, partials));
+  m_Sums = std::move(partials[0]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t FeatureMoments::getCount(size_t feature) const
+{
+  return (m_Order == Order::Count) ? m_Counts[feature] : m_Sums[feature].count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<double, 3> FeatureMoments::getMean(size_t feature) const
+{
+  const FeatureMomentSums& s = m_Sums[feature];
+  if(s.count == 0)
+  {
+    return {0.0, 0.0, 0.0};
+  }
+  double n = static_cast<double>(s.count);
+  return {static_cast<double>(s.shift[0]) + static_cast<double>(s.sum[0]) / n, static_cast<double>(s.shift[1]) + static_cast<double>(s.sum[1]) / n,
+          static_cast<double>(s.shift[2]) + static_cast<double>(s.sum[2]) / n};
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::array<double, 6> FeatureMoments::getSecondMoments(size_t feature, const std::array<double, 3>& center) const
+{
+  const FeatureMomentSums& s = m_Sums[feature];
+  double n = static_cast<double>(s.count);
+  std::array<double, 3> d = {center[0] - static_cast<double>(s.shift[0]), center[1] - static_cast<double>(s.shift[1]), center[2] - static_cast<double>(s.shift[2])};
+  std::array<double, 3> sum = {static_cast<double>(s.sum[0]), static_cast<double>(s.sum[1]), static_cast<double>(s.sum[2])};
+
+  std::array<double, 6> moments = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for(size_t m = 0; m < 6; m++)
+  {
+    size_t p = k_MomentAxes[m][0];
+    size_t q = k_MomentAxes[m][1];
+    moments[m] = s.sumSquares[m] - d[p] * sum[q] - sum[p] * d[q] + n * d[p] * d[q];
+  }
+  return moments;
+}
@@ -0,0 +1,111 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The FeatureMomentSums struct holds the sums of one Feature about a shifted origin, which is the first
+ * voxel of the Feature that was visited. The first moments are exact integers and the second moments stay
+ * small, so no large squared offsets cancel when the central moments are formed.
+ */
+struct FeatureMomentSums
+{
+  uint64_t count = 0;
+  std::array<int64_t, 3> shift = {0, 0, 0};
+  std::array<int64_t, 3> sum = {0, 0, 0};
+  std::array<double, 6> sumSquares = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+};
+
+/**
+ * @brief The FeatureMoments class finds the number of voxels and optionally the first and second moments of the
+ * voxel positions of every Feature of an Image Geometry in a single parallel pass over the Feature Ids. Each slab
+ * of rows accumulates its own partial sums, which are merged per Feature in a pairwise tree. Positions are in
+ * voxel index units, so callers apply the origin and spacing of the geometry.
+ */
+class FeatureMoments
+{
+public:
+  enum class Order : int32_t
+  {
+    Count = 0,
+    First = 1,
+    Second = 2
+  };
+
+  FeatureMoments(size_t numFeatures, Order order);
+  ~FeatureMoments();
+
+  /**
+   * @brief compute Accumulates the moments of all Features. Voxels whose Feature Id is out of range are skipped.
+   * @param featureIds Feature Id of each voxel with X varying fastest
+   * @param dims Number of voxels along X, Y and Z
+   */
+  void compute(const int32_t* featureIds, const std::array<size_t, 3>& dims);
+
+  /**
+   * @brief getCount Returns the number of voxels of a Feature
+   */
+  uint64_t getCount(size_t feature) const;
+
+  /**
+   * @brief getMean Returns the mean voxel index of a Feature. Requires the First or Second order
+   */
+  std::array<double, 3> getMean(size_t feature) const;
+
+  /**
+   * @brief getSecondMoments Returns the sums of (p - center)_a * (p - center)_b over the voxels of a Feature in
+   * the order xx, yy, zz, xy, yz, xz. Requires the Second order
+   * @param feature Feature Id
+   * @param center Point the moments are taken about, in voxel index units
+   */
+  std::array<double, 6> getSecondMoments(size_t feature, const std::array<double, 3>& center) const;
+
+private:
+  size_t m_NumFeatures = 0;
+  Order m_Order = Order::Count;
+  std::vector<uint64_t> m_Counts;
+  std::vector<FeatureMomentSums> m_Sums;
+
+public:
+  FeatureMoments(const FeatureMoments&) = delete;            // Copy Constructor Not Implemented
+  FeatureMoments(FeatureMoments&&) = delete;                 // Move Constructor Not Implemented
+  FeatureMoments& operator=(const FeatureMoments&) = delete; // Copy Assignment Not Implemented
+  FeatureMoments& operator=(FeatureMoments&&) = delete;      // Move Assignment Not Implemented
+};
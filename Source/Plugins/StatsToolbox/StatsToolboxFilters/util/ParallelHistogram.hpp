@@ -0,0 +1,271 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, Data, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/Utilities/ParallelDataAlgorithm.h"
+
+namespace ParallelHistogram
+{
+// Smallest number of values worth giving a chunk of its own
+constexpr size_t k_MinChunkSize = 65536;
+// Number of bin indices found at once before they are scattered into the bins
+constexpr size_t k_BlockSize = 256;
+
+/**
+ * @brief NumberOfChunks Returns how many chunks a range of values is split into. Every chunk owns its own copy of
+ * the bins, so there are never more chunks than values per bin.
+ * @param numValues Number of values in the range
+ * @param numBins Number of bins of one copy, or 0 if the chunks carry no bins
+ */
+inline size_t NumberOfChunks(size_t numValues, size_t numBins)
+{
+  size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+  size_t numChunks = std::min((numValues + k_MinChunkSize - 1) / k_MinChunkSize, numThreads * 4);
+  if(numBins > 0)
+  {
+    numChunks = std::min(numChunks, numValues / numBins);
+  }
+  return std::max(numChunks, static_cast<size_t>(1));
+}
+
+/**
+ * @brief The RangeImpl class finds the smallest and largest value of a range of chunks, each chunk into its own
+ * pair. Values are compared as floats and NaNs are ignored.
+ */
+template <typename T>
+class RangeImpl
+{
+public:
+  RangeImpl(const T* values, size_t begin, size_t end, size_t chunkSize, std::vector<std::array<float, 2>>& ranges)
+  : m_Values(values)
+  , m_Begin(begin)
+  , m_End(end)
+  , m_ChunkSize(chunkSize)
+  , m_Ranges(ranges)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      float min = m_Ranges[chunk][0];
+      float max = m_Ranges[chunk][1];
+      size_t end = std::min(m_End, m_Begin + (chunk + 1) * m_ChunkSize);
+      for(size_t i = m_Begin + chunk * m_ChunkSize; i < end; i++)
+      {
+        float value = static_cast<float>(m_Values[i]);
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+      }
+      m_Ranges[chunk] = {min, max};
+    }
+  }
+
+private:
+  const T* m_Values = nullptr;
+  size_t m_Begin = 0;
+  size_t m_End = 0;
+  size_t m_ChunkSize = 1;
+  std::vector<std::array<float, 2>>& m_Ranges;
+};
+
+/**
+ * @brief The CountImpl class bins a range of chunks, each chunk into its own bins. The bin indices of a block of
+ * values are found in a tight loop the compiler can vectorize before they are scattered into the bins.
+ */
+template <typename BinFunctor>
+class CountImpl
+{
+public:
+  CountImpl(const BinFunctor& binOf, size_t begin, size_t end, size_t chunkSize, std::vector<std::vector<uint64_t>>& counts, std::vector<uint64_t>& rejected)
+  : m_BinOf(binOf)
+  , m_Begin(begin)
+  , m_End(end)
+  , m_ChunkSize(chunkSize)
+  , m_Counts(counts)
+  , m_Rejected(rejected)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    std::array<int64_t, k_BlockSize> indices = {};
+    for(size_t chunk = range.min(); chunk < range.max(); chunk++)
+    {
+      uint64_t* counts = m_Counts[chunk].data();
+      int64_t numBins = static_cast<int64_t>(m_Counts[chunk].size());
+      uint64_t rejected = 0;
+      size_t end = std::min(m_End, m_Begin + (chunk + 1) * m_ChunkSize);
+      for(size_t blockStart = m_Begin + chunk * m_ChunkSize; blockStart < end; blockStart += k_BlockSize)
+      {
+        size_t blockSize = std::min(k_BlockSize, end - blockStart);
+        for(size_t i = 0; i < blockSize; i++)
+        {
+          indices[i] = m_BinOf(blockStart + i);
+        }
+        for(size_t i = 0; i < blockSize; i++)
+        {
+          int64_t index = indices[i];
+          if(index >= 0 && index < numBins)
+          {
+            counts[index]++;
+          }
+          else
+          {
+            rejected++;
+          }
+        }
+      }
+      m_Rejected[chunk] = rejected;
+    }
+  }
+
+private:
+  BinFunctor m_BinOf;
+  size_t m_Begin = 0;
+  size_t m_End = 0;
+  size_t m_ChunkSize = 1;
+  std::vector<std::vector<uint64_t>>& m_Counts;
+  std::vector<uint64_t>& m_Rejected;
+};
+
+/**
+ * @brief The ReduceImpl class adds the bins of every chunk into the bins of the first chunk for a range of bins.
+ */
+class ReduceImpl
+{
+public:
+  ReduceImpl(std::vector<std::vector<uint64_t>>& counts)
+  : m_Counts(counts)
+  {
+  }
+
+  void operator()(const SIMPLRange& range) const
+  {
+    uint64_t* total = m_Counts[0].data();
+    for(size_t chunk = 1; chunk < m_Counts.size(); chunk++)
+    {
+      const uint64_t* counts = m_Counts[chunk].data();
+      for(size_t bin = range.min(); bin < range.max(); bin++)
+      {
+        total[bin] += counts[bin];
+      }
+    }
+  }
+
+private:
+  std::vector<std::vector<uint64_t>>& m_Counts;
+};
+
+/**
+ * @brief FindRange Widens min and max to the smallest and largest value of values[begin, end), compared as floats.
+ * The caller seeds min and max, so a range that should always contain some value can be passed in.
+ */
+template <typename T>
+void FindRange(const T* values, size_t begin, size_t end, float& min, float& max)
+{
+  if(end <= begin)
+  {
+    return;
+  }
+  size_t numChunks = NumberOfChunks(end - begin, 0);
+  size_t chunkSize = (end - begin + numChunks - 1) / numChunks;
+  std::vector<std::array<float, 2>> ranges(numChunks, {min, max});
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute(RangeImpl<T>(values, begin, end, chunkSize, ranges));
+
+  for(const auto& range : ranges)
+  {
+    min = std::min(min, range[0]);
+    max = std::max(max, range[1]);
+  }
+}
+
+/**
+ * @brief Count Bins the values [begin, end) in parallel. binOf(i) returns the bin of value i, and any index outside
+ * [0, numBins) is counted as rejected instead. Grouped histograms, such as one per Ensemble, use group * binsPerGroup
+ * + bin as the index. Each chunk of values fills its own bins, which are added up afterwards, so the result does not
+ * depend on the number of threads.
+ * @param binOf Functor mapping a value index to a bin index
+ * @param begin First value index
+ * @param end One past the last value index
+ * @param numBins Total number of bins
+ * @param counts Receives the number of values in each bin
+ * @return Number of rejected values
+ */
+template <typename BinFunctor>
+uint64_t Count(const BinFunctor& binOf, size_t begin, size_t end, size_t numBins, std::vector<uint64_t>& counts)
+{
+  if(end <= begin || numBins == 0)
+  {
+    counts.assign(numBins, 0);
+    return end > begin ? end - begin : 0;
+  }
+  size_t numChunks = NumberOfChunks(end - begin, numBins);
+  size_t chunkSize = (end - begin + numChunks - 1) / numChunks;
+  std::vector<std::vector<uint64_t>> partials(numChunks, std::vector<uint64_t>(numBins, 0));
+  std::vector<uint64_t> rejected(numChunks, 0);
+
+  ParallelDataAlgorithm dataAlg;
+  dataAlg.setRange(0, numChunks);
+  dataAlg.execute(CountImpl<BinFunctor>(binOf, begin, end, chunkSize, partials, rejected));
+
+  if(numChunks > 1)
+  {
+    ParallelDataAlgorithm reduceAlg;
+    reduceAlg.setRange(0, numBins);
+    reduceAlg.execute(ReduceImpl(partials));
+  }
+  counts = std::move(partials[0]);
+
+  uint64_t totalRejected = 0;
+  for(uint64_t value : rejected)
+  {
+    totalRejected += value;
+  }
+  return totalRejected;
+}
+} // namespace ParallelHistogram
@@ -33,6 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <limits>
+#include <vector>
+
 #include <QtCore/QString>
 
 #include "SIMPLib/SIMPLib.h"
@@ -47,6 +50,8 @@
 #include "SIMPLib/Plugin/ISIMPLibPlugin.h"
 #include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
 
+#include "StatsToolbox/StatsToolboxFilters/util/ParallelHistogram.hpp"
+
 #include "UnitTestSupport.hpp"
 
 #include "StatsToolboxTestFileLocations.h"
@@ -262,6 +267,128 @@ public:
     }
   }
 
+  // -----------------------------------------------------------------------------
+  // Runs the filter over the values with the range taken from the values themselves
+  // -----------------------------------------------------------------------------
+  DoubleArrayType::Pointer runAutoRangeHistogram(const std::vector<float>& values, int numberOfBins, int& warningCode)
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(DCName);
+    dca->addOrReplaceDataContainer(dc);
+
+    std::vector<size_t> tDims = {values.size()};
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, Data_AMName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(am);
+    FloatArrayType::Pointer data = FloatArrayType::CreateArray(values.size(), Duration_Name, true);
+    for(size_t i = 0; i < values.size(); i++)
+    {
+      data->setValue(i, values[i]);
+    }
+    am->insertOrAssign(data);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("CalculateArrayHistogram")->create();
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(DCName, Data_AMName, Duration_Name));
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedArrayPath", var), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumberOfBins", numberOfBins), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("UserDefinedRange", false), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("Normalize", false), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewAttributeMatrixName", Hist_AMName), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewDataArrayName", DurationHistogram_Name), true)
+    DREAM3D_REQUIRE_EQUAL(filter->setProperty("NewDataContainer", false), true)
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0);
+    warningCode = filter->getWarningCode();
+
+    DoubleArrayType::Pointer histogram = dca->getAttributeMatrix(DataArrayPath(DCName, Hist_AMName, ""))->getAttributeArrayAs<DoubleArrayType>(DurationHistogram_Name);
+    DREAM3D_REQUIRE_VALID_POINTER(histogram.get())
+    DREAM3D_REQUIRE_EQUAL(histogram->getNumberOfTuples(), numberOfBins)
+    return histogram;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The largest value lands one past the last bin and, as in the serial loop, is reported as not categorized. NaNs
+  // do not widen the range and are never binned.
+  // -----------------------------------------------------------------------------
+  void TestMaxAndNaNValues()
+  {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> values = {nan, 0.0f, 0.5f, 1.0f, 2.5f, nan, 3.0f, 3.5f, 4.0f, 4.0f};
+    int warningCode = 0;
+    DoubleArrayType::Pointer histogram = runAutoRangeHistogram(values, 4, warningCode);
+    DREAM3D_REQUIRE_EQUAL(warningCode, -2000)
+
+    const double expected[4][2] = {{1.0, 2.0}, {2.0, 1.0}, {3.0, 1.0}, {4.0, 2.0}};
+    for(size_t r = 0; r < 4; r++)
+    {
+      DREAM3D_REQUIRE_EQUAL(histogram->getComponent(r, 0), expected[r][0])
+      DREAM3D_REQUIRE_EQUAL(histogram->getComponent(r, 1), expected[r][1])
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Empty ranges leave the seeded range untouched and bin nothing
+  // -----------------------------------------------------------------------------
+  void TestEmptyRanges()
+  {
+    std::vector<float> values = {1.0f, 2.0f, 3.0f};
+    float min = 10.0f;
+    float max = -10.0f;
+    ParallelHistogram::FindRange(values.data(), 2, 2, min, max);
+    DREAM3D_REQUIRE_EQUAL(min, 10.0f)
+    DREAM3D_REQUIRE_EQUAL(max, -10.0f)
+    ParallelHistogram::FindRange(values.data(), 1, 3, min, max);
+    DREAM3D_REQUIRE_EQUAL(min, 2.0f)
+    DREAM3D_REQUIRE_EQUAL(max, 3.0f)
+
+    auto binOf = [](size_t i) -> int64_t { return static_cast<int64_t>(i % 4); };
+    std::vector<uint64_t> counts = {7, 7};
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::Count(binOf, 5, 5, 4, counts), 0)
+    DREAM3D_REQUIRE_EQUAL(counts.size(), 4)
+    for(uint64_t count : counts)
+    {
+      DREAM3D_REQUIRE_EQUAL(count, 0)
+    }
+
+    // Without any bins every value is rejected
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::Count(binOf, 0, 6, 0, counts), 6)
+    DREAM3D_REQUIRE_EQUAL(counts.size(), 0)
+  }
+
+  // -----------------------------------------------------------------------------
+  // Every chunk owns a copy of the bins, so there are never more chunks than values per bin. The counts must not
+  // depend on how the values were chunked.
+  // -----------------------------------------------------------------------------
+  void TestChunkClamp()
+  {
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::NumberOfChunks(10, 100), 1)
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::NumberOfChunks(0, 0), 1)
+    const size_t numValues = ParallelHistogram::k_MinChunkSize * 8;
+    DREAM3D_REQUIRE(ParallelHistogram::NumberOfChunks(numValues, numValues / 2) <= 2)
+
+    // More bins than values, with every fourth value rejected
+    auto sparseBinOf = [](size_t i) -> int64_t { return (i % 4 == 3) ? -1 : static_cast<int64_t>(i * 10); };
+    std::vector<uint64_t> counts;
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::Count(sparseBinOf, 0, 10, 100, counts), 2)
+    DREAM3D_REQUIRE_EQUAL(counts.size(), 100)
+    for(size_t bin = 0; bin < 100; bin++)
+    {
+      uint64_t expected = (bin % 10 == 0 && (bin / 10) % 4 != 3) ? 1 : 0;
+      DREAM3D_REQUIRE_EQUAL(counts[bin], expected)
+    }
+
+    // Enough values for several chunks, with the bin count clamping them to two
+    auto denseBinOf = [numValues](size_t i) -> int64_t { return (i == numValues - 1) ? static_cast<int64_t>(numValues) : static_cast<int64_t>(i / 2); };
+    DREAM3D_REQUIRE_EQUAL(ParallelHistogram::Count(denseBinOf, 0, numValues, numValues / 2, counts), 1)
+    for(size_t bin = 0; bin < numValues / 2; bin++)
+    {
+      DREAM3D_REQUIRE_EQUAL(counts[bin], (bin == numValues / 2 - 1) ? 1 : 2)
+    }
+  }
+
   /**
    * @brief
    */
@@ -271,6 +398,9 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
     // DREAM3D_REGISTER_TEST( CalculateArrayHistogramTest() )
     DREAM3D_REGISTER_TEST(TestFaithful())
+    DREAM3D_REGISTER_TEST(TestMaxAndNaNValues())
+    DREAM3D_REGISTER_TEST(TestEmptyRanges())
+    DREAM3D_REGISTER_TEST(TestChunkClamp())
   }
 
 private:
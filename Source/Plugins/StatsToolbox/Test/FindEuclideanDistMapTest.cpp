@@ -195,9 +195,9 @@ public:
 
     FloatArrayType::Pointer floatArray = am->getAttributeArrayAs<FloatArrayType>("GBEuclideanDistance");
 
-    std::vector<float> GBEuclidean = {4.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 2.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f,
-                                      0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-                                      2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0};
+    std::vector<float> GBEuclidean = {2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f, 2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f,
+                                      0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f,
+                                      2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f, 2.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, -1.0f};
 
     for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
     {
@@ -208,9 +208,9 @@ public:
 
     floatArray = am->getAttributeArrayAs<FloatArrayType>("TJEuclideanDistance");
     std::vector<float> TJEuclidean = {
-        4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.0f, 0.0f, 2.828427f, 2.236068f,  2.0f, 2.236068f,  2.828427f, 2.236068f,  2.0f, 2.236068f,  2.0f, 0.0f,
-        2.0f,      1.0f,       0.0f, 1.0f,       2.0f,      1.0f,       0.0f, 1.0f,       0.0f, 0.0f, 2.0f,      1.0f,       0.0f, 1.0f,       2.0f,      1.0f,       0.0f, 1.0f,       0.0f, 0.0f,
-        2.828427f, 2.236068f,  2.0f, 2.236068f,  2.828427f, 2.236068f,  2.0f, 2.236068f,  2.0f, 0.0f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.0f, 0.0};
+        4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.0f, -1.0f, 2.828427f, 2.236068f,  2.0f, 2.236068f,  2.828427f, 2.236068f,  2.0f, 2.236068f,  2.0f, -1.0f,
+        2.0f,      1.0f,       0.0f, 1.0f,       2.0f,      1.0f,       0.0f, 1.0f,       0.0f, -1.0f, 2.0f,      1.0f,       0.0f, 1.0f,       2.0f,      1.0f,       0.0f, 1.0f,       0.0f, -1.0f,
+        2.828427f, 2.236068f,  2.0f, 2.236068f,  2.828427f, 2.236068f,  2.0f, 2.236068f,  2.0f, -1.0f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.472136f, 4.1231055f, 4.0f, 4.1231055f, 4.0f, -1.0f};
 
     for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
     {
@@ -220,9 +220,9 @@ public:
     }
 
     floatArray = am->getAttributeArrayAs<FloatArrayType>("QPEuclideanDistance");
-    std::vector<float> QPEuclidean = {-1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0f,
-                                      -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0f,
-                                      -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, 0.0};
+    std::vector<float> QPEuclidean = {-1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f,
+                                      -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f,
+                                      -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f, -1.0f};
 
     for(size_t i = 0; i < floatArray->getNumberOfTuples(); i++)
     {
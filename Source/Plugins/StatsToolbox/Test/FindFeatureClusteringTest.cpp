@@ -0,0 +1,293 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <cmath>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+class FindFeatureClusteringTest
+{
+
+public:
+  FindFeatureClusteringTest() = default;
+  virtual ~FindFeatureClusteringTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindFeatureClustering Filter from the FilterManager
+    QString filtName = "FindFeatureClustering";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindFeatureClusteringTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Five Features of phase 1 and one of phase 2 in a 12 x 12 x 12 box. The phase 1 centroids are (0, 0, 0),
+  // (1, 0, 0), (3, 0, 0), (0, 4, 0) and (10, 10, 10); Feature 5 sits at (2, 0, 0) in phase 2.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(12, 12, 12));
+    imageGeom->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    dc->setGeometry(imageGeom);
+
+    const size_t numFeatures = 7;
+    const int32_t featurePhases[numFeatures] = {0, 1, 1, 1, 1, 2, 1};
+    const float featureCentroids[numFeatures][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f},
+                                                    {0.0f, 4.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {10.0f, 10.0f, 10.0f}};
+
+    std::vector<size_t> tDims = {numFeatures};
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Phases, true);
+    FloatArrayType::Pointer equivalentDiameters = FloatArrayType::CreateArray(numFeatures, SIMPL::FeatureData::EquivalentDiameters, true);
+    std::vector<size_t> cDims = {3};
+    FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::Centroids, true);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      phases->setValue(i, featurePhases[i]);
+      equivalentDiameters->setValue(i, 1.0f);
+      for(size_t c = 0; c < 3; c++)
+      {
+        centroids->setComponent(i, c, featureCentroids[i][c]);
+      }
+    }
+    featureAM->insertOrAssign(phases);
+    featureAM->insertOrAssign(equivalentDiameters);
+    featureAM->insertOrAssign(centroids);
+
+    tDims = {3};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellEnsembleAttributeMatrixName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer runClustering(bool storeClusteringList, bool useMaxSeparationDistance, float maxSeparationDistance, int32_t expectedWarning)
+  {
+    DataContainerArray::Pointer dca = createTestData();
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindFeatureClustering")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    DREAM3D_REQUIRE(filter->setProperty("CellEnsembleAttributeMatrixName", var))
+    DREAM3D_REQUIRE(filter->setProperty("NumberOfBins", 4))
+    DREAM3D_REQUIRE(filter->setProperty("PhaseNumber", 1))
+    DREAM3D_REQUIRE(filter->setProperty("RemoveBiasedFeatures", false))
+    DREAM3D_REQUIRE(filter->setProperty("UseRandomSeed", true))
+    DREAM3D_REQUIRE(filter->setProperty("StoreClusteringList", storeClusteringList))
+    DREAM3D_REQUIRE(filter->setProperty("UseMaxSeparationDistance", useMaxSeparationDistance))
+    DREAM3D_REQUIRE(filter->setProperty("MaxSeparationDistance", maxSeparationDistance))
+
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+    DREAM3D_REQUIRE_EQUAL(filter->getWarningCode(), expectedWarning)
+
+    NeighborList<float>::Pointer clusteringList =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""))
+            ->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::ClusteringList);
+    DREAM3D_REQUIRE_EQUAL(nullptr != clusteringList.get(), storeClusteringList)
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  FloatArrayType::Pointer getEnsembleArray(DataContainerArray::Pointer dca, const QString& name)
+  {
+    FloatArrayType::Pointer array =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""))->getAttributeArrayAs<FloatArrayType>(name);
+    DREAM3D_REQUIRE_VALID_POINTER(array.get())
+    return array;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Each list must hold the distances to the partners of its Feature in order of the partner Feature Ids
+  // -----------------------------------------------------------------------------
+  void checkClusteringLists(DataContainerArray::Pointer dca, const std::vector<std::vector<float>>& expected)
+  {
+    NeighborList<float>::Pointer clusteringList =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""))
+            ->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::ClusteringList);
+    DREAM3D_REQUIRE_VALID_POINTER(clusteringList.get())
+    for(size_t feature = 1; feature < expected.size(); feature++)
+    {
+      NeighborList<float>::SharedVectorType list = clusteringList->getList(static_cast<int32_t>(feature));
+      DREAM3D_REQUIRE_EQUAL(list->size(), expected[feature].size())
+      for(size_t p = 0; p < list->size(); p++)
+      {
+        DREAM3D_REQUIRE(std::fabs(list->at(p) - expected[feature][p]) < 0.0001f)
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Binning straight from the pair search must give the same RDF as binning the stored clustering lists
+  // -----------------------------------------------------------------------------
+  void checkSameRDF(DataContainerArray::Pointer stored, DataContainerArray::Pointer streamed)
+  {
+    FloatArrayType::Pointer storedRDF = getEnsembleArray(stored, "RDF");
+    FloatArrayType::Pointer streamedRDF = getEnsembleArray(streamed, "RDF");
+    for(size_t i = 0; i < storedRDF->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(storedRDF->getValue(i), streamedRDF->getValue(i))
+    }
+    FloatArrayType::Pointer storedMaxMin = getEnsembleArray(stored, "RDFMaxMinDistances");
+    FloatArrayType::Pointer streamedMaxMin = getEnsembleArray(streamed, "RDFMaxMinDistances");
+    for(size_t i = 0; i < storedMaxMin->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(storedMaxMin->getValue(i), streamedMaxMin->getValue(i))
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestStoreClusteringList()
+  {
+    DataContainerArray::Pointer stored = runClustering(true, false, 1.0f, 0);
+    const float r16 = std::sqrt(300.0f);
+    const float r26 = std::sqrt(281.0f);
+    const float r36 = std::sqrt(249.0f);
+    const float r46 = std::sqrt(236.0f);
+    const float r24 = std::sqrt(17.0f);
+    checkClusteringLists(stored, {{}, {1.0f, 3.0f, 4.0f, r16}, {1.0f, 2.0f, r24, r26}, {3.0f, 2.0f, 5.0f, r36}, {4.0f, r24, 5.0f, r46}, {}, {r16, r26, r36, r46}});
+
+    FloatArrayType::Pointer maxMin = getEnsembleArray(stored, "RDFMaxMinDistances");
+    DREAM3D_REQUIRE(std::fabs(maxMin->getComponent(1, 0) - r16) < 0.0001f)
+    DREAM3D_REQUIRE_EQUAL(maxMin->getComponent(1, 1), 1.0f)
+
+    DataContainerArray::Pointer streamed = runClustering(false, false, 1.0f, 0);
+    checkSameRDF(stored, streamed);
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Only pairs at most the maximum separation distance apart are kept, including a pair exactly at the cutoff
+  // -----------------------------------------------------------------------------
+  int TestMaxSeparationDistance()
+  {
+    DataContainerArray::Pointer stored = runClustering(true, true, 4.0f, 0);
+    checkClusteringLists(stored, {{}, {1.0f, 3.0f, 4.0f}, {1.0f, 2.0f}, {3.0f, 2.0f}, {4.0f}, {}, {}});
+
+    FloatArrayType::Pointer maxMin = getEnsembleArray(stored, "RDFMaxMinDistances");
+    DREAM3D_REQUIRE_EQUAL(maxMin->getComponent(1, 0), 4.0f)
+    DREAM3D_REQUIRE_EQUAL(maxMin->getComponent(1, 1), 1.0f)
+
+    DataContainerArray::Pointer streamed = runClustering(false, true, 4.0f, 0);
+    checkSameRDF(stored, streamed);
+
+    // A cutoff below every separation leaves the lists and the RDF empty
+    DataContainerArray::Pointer empty = runClustering(true, true, 0.5f, -11000);
+    checkClusteringLists(empty, {{}, {}, {}, {}, {}, {}, {}});
+    FloatArrayType::Pointer rdf = getEnsembleArray(empty, "RDF");
+    for(size_t i = 0; i < rdf->getSize(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(rdf->getValue(i), 0.0f)
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestInvalidMaxSeparationDistance()
+  {
+    DataContainerArray::Pointer dca = createTestData();
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindFeatureClustering")->create();
+    filter->setDataContainerArray(dca);
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellEnsembleAttributeMatrixName, ""));
+    DREAM3D_REQUIRE(filter->setProperty("CellEnsembleAttributeMatrixName", var))
+    DREAM3D_REQUIRE(filter->setProperty("UseMaxSeparationDistance", true))
+    DREAM3D_REQUIRE(filter->setProperty("MaxSeparationDistance", 0.0f))
+    filter->preflight();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), -11001)
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestStoreClusteringList())
+    DREAM3D_REGISTER_TEST(TestMaxSeparationDistance())
+    DREAM3D_REGISTER_TEST(TestInvalidMaxSeparationDistance())
+  }
+
+public:
+  FindFeatureClusteringTest(const FindFeatureClusteringTest&) = delete;            // Copy Constructor Not Implemented
+  FindFeatureClusteringTest(FindFeatureClusteringTest&&) = delete;                 // Move Constructor Not Implemented
+  FindFeatureClusteringTest& operator=(const FindFeatureClusteringTest&) = delete; // Copy Assignment Not Implemented
+  FindFeatureClusteringTest& operator=(FindFeatureClusteringTest&&) = delete;      // Move Assignment Not Implemented
+};
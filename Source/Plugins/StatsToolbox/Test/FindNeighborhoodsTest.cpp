@@ -0,0 +1,267 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+class FindNeighborhoodsTest
+{
+
+public:
+  FindNeighborhoodsTest() = default;
+  virtual ~FindNeighborhoodsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighborhoods Filter from the FilterManager
+    QString filtName = "FindNeighborhoods";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborhoodsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter on the given Feature centroids and equivalent diameters, with the image origin at (0, 0, 0), and
+  // returns the neighborhood list of every Feature. Entry 0 of both inputs is the unused Feature 0.
+  // -----------------------------------------------------------------------------
+  std::vector<std::vector<int32_t>> runNeighborhoods(const std::vector<std::array<float, 3>>& featureCentroids, const std::vector<float>& diameters, float multiplesOfAverage)
+  {
+    const size_t numFeatures = diameters.size();
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(32, 32, 32));
+    imageGeom->setSpacing(FloatVec3Type(1.0f, 1.0f, 1.0f));
+    imageGeom->setOrigin(FloatVec3Type(0.0f, 0.0f, 0.0f));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {numFeatures};
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Phases, true);
+    FloatArrayType::Pointer equivalentDiameters = FloatArrayType::CreateArray(numFeatures, SIMPL::FeatureData::EquivalentDiameters, true);
+    std::vector<size_t> cDims = {3};
+    FloatArrayType::Pointer centroids = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::Centroids, true);
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      phases->setValue(i, 1);
+      equivalentDiameters->setValue(i, diameters[i]);
+      for(size_t c = 0; c < 3; c++)
+      {
+        centroids->setComponent(i, c, featureCentroids[i][c]);
+      }
+    }
+    featureAM->insertOrAssign(phases);
+    featureAM->insertOrAssign(equivalentDiameters);
+    featureAM->insertOrAssign(centroids);
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindNeighborhoods")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EquivalentDiameters));
+    DREAM3D_REQUIRE(filter->setProperty("EquivalentDiametersArrayPath", var))
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases));
+    DREAM3D_REQUIRE(filter->setProperty("FeaturePhasesArrayPath", var))
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids));
+    DREAM3D_REQUIRE(filter->setProperty("CentroidsArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("MultiplesOfAverage", multiplesOfAverage))
+    DREAM3D_REQUIRE(filter->setProperty("NeighborhoodsArrayName", SIMPL::FeatureData::Neighborhoods))
+    DREAM3D_REQUIRE(filter->setProperty("NeighborhoodListArrayName", SIMPL::FeatureData::NeighborhoodList))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    Int32ArrayType::Pointer neighborhoods = featureAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::Neighborhoods);
+    NeighborList<int32_t>::Pointer neighborhoodList = featureAM->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborhoodList);
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoods.get())
+    DREAM3D_REQUIRE_VALID_POINTER(neighborhoodList.get())
+
+    std::vector<std::vector<int32_t>> lists(numFeatures);
+    for(size_t i = 1; i < numFeatures; i++)
+    {
+      lists[i] = *(neighborhoodList->getList(static_cast<int32_t>(i)));
+      DREAM3D_REQUIRE_EQUAL(neighborhoods->getValue(i), static_cast<int32_t>(lists[i].size()))
+    }
+    return lists;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The diameters add up to the number of tuples, so the average diameter is 1 and the bins are the unit cubes. Feature 1
+  // has a critical distance of 2 and sees the Features up to one bin away: an offset just below 2 from the start of its
+  // bin lands one bin over, while an offset of exactly 2 lands two bins over. Feature 8 checks the same from the top of
+  // its bin towards lower bins. The other Features have a critical distance below 1 and only see their own bin.
+  // -----------------------------------------------------------------------------
+  int TestIntegerCriticalDistance()
+  {
+    const std::vector<std::array<float, 3>> centroids = {
+        {0.0f, 0.0f, 0.0f},          {0.0f, 0.0f, 0.0f},          {1.9375f, 0.0f, 0.0f},     {0.0f, 2.0f, 0.0f},
+        {0.0f, 0.0f, 1.9375f},       {0.0f, 0.0f, 2.0f},          {1.9375f, 1.9375f, 1.9375f}, {2.0f, 1.9375f, 0.0f},
+        {4.9375f, 4.9375f, 4.9375f}, {3.0f, 4.9375f, 4.9375f},    {4.9375f, 2.9375f, 4.9375f},
+    };
+    const std::vector<float> diameters = {0.0f, 2.0f, 0.875f, 0.875f, 0.875f, 0.875f, 0.875f, 0.875f, 2.0f, 0.875f, 0.875f};
+    std::vector<std::vector<int32_t>> lists = runNeighborhoods(centroids, diameters, 1.0f);
+
+    const std::vector<std::vector<int32_t>> expected = {{}, {2, 4, 6}, {}, {}, {}, {}, {}, {}, {9}, {}, {}};
+    for(size_t i = 1; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE(lists[i] == expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // As above with a critical distance of 2.5 for Features 1 and 7. Offsets of exactly 2.5 and just below 3 stay two
+  // bins away and are neighbors; an offset of 3 is not.
+  // -----------------------------------------------------------------------------
+  int TestFractionalCriticalDistance()
+  {
+    const std::vector<std::array<float, 3>> centroids = {
+        {0.0f, 0.0f, 0.0f},          {0.0f, 0.0f, 0.0f},          {2.5f, 0.0f, 0.0f},          {0.0f, 2.9375f, 0.0f},
+        {0.0f, 0.0f, 3.0f},          {2.5f, 2.5f, 2.5f},          {3.0f, 0.0f, 0.0f},          {6.9375f, 6.9375f, 6.9375f},
+        {4.4375f, 6.9375f, 6.9375f}, {6.9375f, 4.0f, 6.9375f},    {6.9375f, 6.9375f, 3.9375f},
+    };
+    const std::vector<float> diameters = {0.0f, 2.5f, 0.75f, 0.75f, 0.75f, 0.75f, 0.75f, 2.5f, 0.75f, 0.75f, 0.75f};
+    std::vector<std::vector<int32_t>> lists = runNeighborhoods(centroids, diameters, 1.0f);
+
+    const std::vector<std::vector<int32_t>> expected = {{}, {2, 3, 5}, {}, {}, {}, {}, {}, {8, 9}, {}, {}, {}};
+    for(size_t i = 1; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE(lists[i] == expected[i])
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Scattered Features with mixed diameters must get exactly the neighborhoods of the pairwise rule: Feature j is in the
+  // neighborhood of Feature i when every bin offset is less than the critical distance of i. The reference repeats the
+  // filter's float arithmetic for the average diameter, the critical distances and the bins.
+  // -----------------------------------------------------------------------------
+  int TestPairwiseRule()
+  {
+    const size_t numFeatures = 400;
+    std::mt19937 generator(5489U);
+    std::uniform_real_distribution<float> position(0.0f, 24.0f);
+    std::uniform_real_distribution<float> diameter(0.25f, 4.0f);
+
+    for(float multiplesOfAverage : {1.0f, 1.5f, 2.0f})
+    {
+      std::vector<std::array<float, 3>> centroids(numFeatures, {0.0f, 0.0f, 0.0f});
+      std::vector<float> diameters(numFeatures, 0.0f);
+      for(size_t i = 1; i < numFeatures; i++)
+      {
+        centroids[i] = {position(generator), position(generator), position(generator)};
+        diameters[i] = diameter(generator);
+      }
+      std::vector<std::vector<int32_t>> lists = runNeighborhoods(centroids, diameters, multiplesOfAverage);
+
+      float aveDiam = 0.0f;
+      for(size_t i = 1; i < numFeatures; i++)
+      {
+        aveDiam += diameters[i];
+      }
+      aveDiam /= numFeatures;
+      for(size_t i = 1; i < numFeatures; i++)
+      {
+        float criticalDistance = diameters[i] * multiplesOfAverage / aveDiam;
+        std::vector<int32_t> expected;
+        for(size_t j = 1; j < numFeatures; j++)
+        {
+          bool inside = (j != i);
+          for(size_t c = 0; c < 3; c++)
+          {
+            int64_t bin1 = static_cast<int64_t>(static_cast<size_t>(centroids[i][c] / aveDiam));
+            int64_t bin2 = static_cast<int64_t>(static_cast<size_t>(centroids[j][c] / aveDiam));
+            inside = inside && static_cast<float>(std::abs(bin2 - bin1)) < criticalDistance;
+          }
+          if(inside)
+          {
+            expected.push_back(static_cast<int32_t>(j));
+          }
+        }
+        DREAM3D_REQUIRE(lists[i] == expected)
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestIntegerCriticalDistance())
+    DREAM3D_REGISTER_TEST(TestFractionalCriticalDistance())
+    DREAM3D_REGISTER_TEST(TestPairwiseRule())
+  }
+
+public:
+  FindNeighborhoodsTest(const FindNeighborhoodsTest&) = delete;            // Copy Constructor Not Implemented
+  FindNeighborhoodsTest(FindNeighborhoodsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindNeighborhoodsTest& operator=(const FindNeighborhoodsTest&) = delete; // Copy Assignment Not Implemented
+  FindNeighborhoodsTest& operator=(FindNeighborhoodsTest&&) = delete;      // Move Assignment Not Implemented
+};
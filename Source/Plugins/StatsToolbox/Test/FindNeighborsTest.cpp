@@ -0,0 +1,223 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+class FindNeighborsTest
+{
+
+public:
+  FindNeighborsTest() = default;
+  virtual ~FindNeighborsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the FindNeighbors Filter from the FilterManager
+    QString filtName = "FindNeighbors";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The FindNeighborsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builds an image geometry from one picture of Feature Ids per Z plane, with rows along Y. The spacing is
+  // (0.5, 0.25, 4).
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData(const std::vector<std::vector<QString>>& featureIdPlanes, size_t numFeatures)
+  {
+    const size_t dims[3] = {static_cast<size_t>(featureIdPlanes[0][0].size()), featureIdPlanes[0].size(), featureIdPlanes.size()};
+
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    ImageGeom::Pointer imageGeom = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    imageGeom->setDimensions(SizeVec3Type(dims[0], dims[1], dims[2]));
+    imageGeom->setSpacing(FloatVec3Type(0.5f, 0.25f, 4.0f));
+    dc->setGeometry(imageGeom);
+
+    std::vector<size_t> tDims = {dims[0], dims[1], dims[2]};
+    AttributeMatrix::Pointer cellAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    dc->addOrReplaceAttributeMatrix(cellAM);
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(dims[0] * dims[1] * dims[2], SIMPL::CellData::FeatureIds, true);
+    for(size_t z = 0; z < dims[2]; z++)
+    {
+      for(size_t y = 0; y < dims[1]; y++)
+      {
+        for(size_t x = 0; x < dims[0]; x++)
+        {
+          featureIds->setValue((z * dims[1] + y) * dims[0] + x, featureIdPlanes[z][y][static_cast<int>(x)].digitValue());
+        }
+      }
+    }
+    cellAM->insertOrAssign(featureIds);
+
+    tDims = {numFeatures};
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(tDims, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Runs the filter and checks all five outputs. The neighbor lists are in ascending order of neighbor Feature Id.
+  // -----------------------------------------------------------------------------
+  void checkNeighbors(const std::vector<std::vector<QString>>& featureIdPlanes, const std::vector<std::vector<int32_t>>& neighbors, const std::vector<std::vector<float>>& areas,
+                      const std::vector<bool>& surfaceFeatures, const std::vector<std::vector<QString>>& boundaryCells)
+  {
+    DataContainerArray::Pointer dca = createTestData(featureIdPlanes, neighbors.size());
+
+    AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryFromClassName("FindNeighbors")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds));
+    DREAM3D_REQUIRE(filter->setProperty("FeatureIdsArrayPath", var))
+    var.setValue(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    DREAM3D_REQUIRE(filter->setProperty("CellFeatureAttributeMatrixPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("NeighborListArrayName", SIMPL::FeatureData::NeighborList))
+    DREAM3D_REQUIRE(filter->setProperty("SharedSurfaceAreaListArrayName", SIMPL::FeatureData::SharedSurfaceAreaList))
+    DREAM3D_REQUIRE(filter->setProperty("NumNeighborsArrayName", SIMPL::FeatureData::NumNeighbors))
+    DREAM3D_REQUIRE(filter->setProperty("BoundaryCellsArrayName", SIMPL::CellData::BoundaryCells))
+    DREAM3D_REQUIRE(filter->setProperty("SurfaceFeaturesArrayName", SIMPL::FeatureData::SurfaceFeatures))
+    DREAM3D_REQUIRE(filter->setProperty("StoreBoundaryCells", true))
+    DREAM3D_REQUIRE(filter->setProperty("StoreSurfaceFeatures", true))
+    filter->execute();
+    DREAM3D_REQUIRE_EQUAL(filter->getErrorCode(), 0)
+
+    AttributeMatrix::Pointer featureAM = dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, ""));
+    NeighborList<int32_t>::Pointer neighborList = featureAM->getAttributeArrayAs<NeighborList<int32_t>>(SIMPL::FeatureData::NeighborList);
+    NeighborList<float>::Pointer sharedSurfaceAreaList = featureAM->getAttributeArrayAs<NeighborList<float>>(SIMPL::FeatureData::SharedSurfaceAreaList);
+    Int32ArrayType::Pointer numNeighbors = featureAM->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumNeighbors);
+    BoolArrayType::Pointer surfaceFeaturesArray = featureAM->getAttributeArrayAs<BoolArrayType>(SIMPL::FeatureData::SurfaceFeatures);
+    DREAM3D_REQUIRE_VALID_POINTER(neighborList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(sharedSurfaceAreaList.get())
+    DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get())
+    DREAM3D_REQUIRE_VALID_POINTER(surfaceFeaturesArray.get())
+
+    for(size_t feature = 1; feature < neighbors.size(); feature++)
+    {
+      NeighborList<int32_t>::SharedVectorType list = neighborList->getList(static_cast<int32_t>(feature));
+      NeighborList<float>::SharedVectorType areaList = sharedSurfaceAreaList->getList(static_cast<int32_t>(feature));
+      DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(feature), static_cast<int32_t>(neighbors[feature].size()))
+      DREAM3D_REQUIRE(*list == neighbors[feature])
+      DREAM3D_REQUIRE(*areaList == areas[feature])
+      DREAM3D_REQUIRE_EQUAL(surfaceFeaturesArray->getValue(feature), surfaceFeatures[feature])
+    }
+
+    Int8ArrayType::Pointer boundaryCellsArray =
+        dca->getAttributeMatrix(DataArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, ""))->getAttributeArrayAs<Int8ArrayType>(SIMPL::CellData::BoundaryCells);
+    DREAM3D_REQUIRE_VALID_POINTER(boundaryCellsArray.get())
+    size_t index = 0;
+    for(const auto& plane : boundaryCells)
+    {
+      for(const auto& row : plane)
+      {
+        for(const auto& cell : row)
+        {
+          DREAM3D_REQUIRE_EQUAL(static_cast<int32_t>(boundaryCellsArray->getValue(index)), cell.digitValue())
+          index++;
+        }
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Six Features over three Z planes, so neighbors are found within rows, across rows and across planes. Feature 6 is
+  // enclosed and is the only one off the surface. Every shared face counts as the X spacing times the Y spacing,
+  // whatever its orientation, as the filter always has: 0.125 per face here.
+  // -----------------------------------------------------------------------------
+  int TestVolume()
+  {
+    checkNeighbors({{"11220", "11230", "44330", "44555"}, {"11220", "10663", "44333", "44555"}, {"11222", "11222", "44552", "44555"}},
+                   {{}, {2, 4}, {1, 3, 5, 6}, {2, 4, 5, 6}, {1, 3, 5}, {2, 3, 4}, {2, 3}},
+                   {{}, {0.625f, 0.625f}, {0.625f, 0.625f, 0.5f, 0.625f}, {0.625f, 0.25f, 0.875f, 0.5f}, {0.625f, 0.25f, 0.5f}, {0.5f, 0.875f, 0.5f}, {0.625f, 0.5f}},
+                   {false, true, true, true, true, true, false}, {{"01110", "12430", "12310", "01210"}, {"01210", "10452", "11432", "01211"}, {"01100", "12321", "12333", "01101"}});
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  // In a single Z plane only the X and Y borders put a Feature on the surface
+  // -----------------------------------------------------------------------------
+  int TestSingleSlice()
+  {
+    checkNeighbors({{"112233", "112033", "446033", "455553", "455553"}}, {{}, {2, 4}, {1, 3, 6}, {2, 5}, {1, 5, 6}, {3, 4, 6}, {2, 4, 5}},
+                   {{}, {0.25f, 0.25f}, {0.25f, 0.125f, 0.125f}, {0.125f, 0.375f}, {0.25f, 0.375f, 0.125f}, {0.375f, 0.375f, 0.125f}, {0.125f, 0.125f, 0.125f}},
+                   {false, true, true, true, true, true, false}, {{"011110", "122000", "133010", "121021", "110011"}});
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestVolume())
+    DREAM3D_REGISTER_TEST(TestSingleSlice())
+  }
+
+public:
+  FindNeighborsTest(const FindNeighborsTest&) = delete;            // Copy Constructor Not Implemented
+  FindNeighborsTest(FindNeighborsTest&&) = delete;                 // Move Constructor Not Implemented
+  FindNeighborsTest& operator=(const FindNeighborsTest&) = delete; // Copy Assignment Not Implemented
+  FindNeighborsTest& operator=(FindNeighborsTest&&) = delete;      // Move Assignment Not Implemented
+};
@@ -33,6 +33,9 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <array>
+#include <cmath>
+
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
 
@@ -333,6 +336,224 @@ public:
     return EXIT_SUCCESS;
   }
 
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void runShapesFilters(const DataContainerArray::Pointer& dca, const QString& dcName)
+  {
+    FilterManager* fm = FilterManager::Instance();
+    QVariant var;
+
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindFeatureCentroids");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer centroidsFilter = factory->create();
+    DREAM3D_REQUIRE(centroidsFilter.get() != nullptr);
+    centroidsFilter->setDataContainerArray(dca);
+
+    DataArrayPath path(dcName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds);
+    var.setValue(path);
+    DREAM3D_REQUIRE(centroidsFilter->setProperty("FeatureIdsArrayPath", var));
+    path.update(dcName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids);
+    var.setValue(path);
+    DREAM3D_REQUIRE(centroidsFilter->setProperty("CentroidsArrayPath", var));
+    centroidsFilter->execute();
+    DREAM3D_REQUIRE_EQUAL(centroidsFilter->getErrorCode(), 0);
+
+    factory = fm->getFactoryFromClassName("FindShapes");
+    DREAM3D_REQUIRE(factory.get() != nullptr);
+    AbstractFilter::Pointer shapesFilter = factory->create();
+    DREAM3D_REQUIRE(shapesFilter.get() != nullptr);
+    shapesFilter->setDataContainerArray(dca);
+
+    path.update(dcName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds);
+    var.setValue(path);
+    DREAM3D_REQUIRE(shapesFilter->setProperty("FeatureIdsArrayPath", var));
+    path.update(dcName, SIMPL::Defaults::CellFeatureAttributeMatrixName, "");
+    var.setValue(path);
+    DREAM3D_REQUIRE(shapesFilter->setProperty("CellFeatureAttributeMatrixName", var));
+    path.update(dcName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids);
+    var.setValue(path);
+    DREAM3D_REQUIRE(shapesFilter->setProperty("CentroidsArrayPath", var));
+    shapesFilter->execute();
+    DREAM3D_REQUIRE_EQUAL(shapesFilter->getErrorCode(), 0);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns |cos| of the angle between a row of the Bunge rotation matrix of the
+  // Axis Euler Angles and a direction, which does not depend on the sign that the
+  // eigen solver picks for each principal axis
+  // -----------------------------------------------------------------------------
+  float axisAlignment(const FloatArrayType::Pointer& axisEulerAngles, size_t featureId, size_t row, std::array<float, 3> dir)
+  {
+    float phi1 = axisEulerAngles->getValue(3 * featureId);
+    float phi = axisEulerAngles->getValue(3 * featureId + 1);
+    float phi2 = axisEulerAngles->getValue(3 * featureId + 2);
+    float c1 = std::cos(phi1);
+    float s1 = std::sin(phi1);
+    float c = std::cos(phi);
+    float s = std::sin(phi);
+    float c2 = std::cos(phi2);
+    float s2 = std::sin(phi2);
+    std::array<std::array<float, 3>, 3> om = {{{c1 * c2 - s1 * s2 * c, s1 * c2 + c1 * s2 * c, s2 * s}, {-c1 * s2 - s1 * c2 * c, -s1 * s2 + c1 * c2 * c, c2 * s}, {s1 * s, -c1 * s, c}}};
+    float norm = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+    return std::fabs(om[row][0] * dir[0] + om[row][1] * dir[1] + om[row][2] * dir[2]) / norm;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Anisotropic spacing with a non-zero origin and an oblique Feature. The
+  // expected values come from the per-voxel sum over the 8 (3D) or 4 (2D)
+  // sub-voxels that FindShapes used before the moments were found analytically
+  // -----------------------------------------------------------------------------
+  int TestAnisotropicFeatures()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer idc = DataContainer::New(SIMPL::Defaults::ImageDataContainerName);
+    dca->addOrReplaceDataContainer(idc);
+    ImageGeom::Pointer image = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image->setDimensions(SizeVec3Type(24, 32, 40));
+    image->setSpacing(FloatVec3Type(0.75f, 0.5f, 0.25f));
+    image->setOrigin(FloatVec3Type(-2.0f, 1.0f, 0.5f));
+    idc->setGeometry(image);
+
+    std::vector<size_t> tDims = {24, 32, 40};
+    AttributeMatrix::Pointer attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    idc->addOrReplaceAttributeMatrix(attrMat);
+    AttributeMatrix::Pointer featAttrMat = AttributeMatrix::New({4}, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    idc->addOrReplaceAttributeMatrix(featAttrMat);
+
+    // Feature 1 is an ellipsoid centered at (9, 8, 5) from the corner of the volume with semi-axes 7, 4
+    // and 2.5 along (1, 1, 1), (1, -1, 0) and (1, 1, -2). Feature 2 is the slab of the first 4 columns and
+    // Feature 3 is a thin box that the ellipsoid cuts into. Voxel centers are in eighths of a unit so the
+    // test for the ellipsoid is exact
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(24 * 32 * 40, {1}, SIMPL::CellData::FeatureIds, true);
+    for(int64_t k = 0; k < 40; k++)
+    {
+      for(int64_t j = 0; j < 32; j++)
+      {
+        for(int64_t i = 0; i < 24; i++)
+        {
+          int64_t x = 6 * i + 3 - 72;
+          int64_t y = 4 * j + 2 - 64;
+          int64_t z = 2 * k + 1 - 40;
+          int64_t u = x + y + z;
+          int64_t v = x - y;
+          int64_t w = x + y - 2 * z;
+          int64_t a = 56, b = 32, c = 20;
+          int32_t featureId = 0;
+          if(2 * b * b * c * c * u * u + 3 * a * a * c * c * v * v + a * a * b * b * w * w <= 6 * a * a * b * b * c * c)
+          {
+            featureId = 1;
+          }
+          else if(i < 4)
+          {
+            featureId = 2;
+          }
+          else if(k >= 36 && j >= 16)
+          {
+            featureId = 3;
+          }
+          featureIds->setValue((k * 32 + j) * 24 + i, featureId);
+        }
+      }
+    }
+    attrMat->insertOrAssign(featureIds);
+
+    DataContainer::Pointer idc2 = DataContainer::New("ImageDataContainer2");
+    dca->addOrReplaceDataContainer(idc2);
+    ImageGeom::Pointer image2 = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image2->setDimensions(SizeVec3Type(40, 48, 1));
+    image2->setSpacing(FloatVec3Type(0.75f, 0.5f, 1.0f));
+    image2->setOrigin(FloatVec3Type(1.0f, -2.0f, 0.0f));
+    idc2->setGeometry(image2);
+
+    tDims = {40, 48, 1};
+    attrMat = AttributeMatrix::New(tDims, SIMPL::Defaults::CellAttributeMatrixName, AttributeMatrix::Type::Cell);
+    idc2->addOrReplaceAttributeMatrix(attrMat);
+    featAttrMat = AttributeMatrix::New({3}, SIMPL::Defaults::CellFeatureAttributeMatrixName, AttributeMatrix::Type::CellFeature);
+    idc2->addOrReplaceAttributeMatrix(featAttrMat);
+
+    // Feature 1 is an ellipse centered at (15, 12) with semi-axes 10 and 5 along (2, 1) and (-1, 2).
+    // Feature 2 is the strip of the first 8 rows
+    featureIds = Int32ArrayType::CreateArray(40 * 48, {1}, SIMPL::CellData::FeatureIds, true);
+    for(int64_t j = 0; j < 48; j++)
+    {
+      for(int64_t i = 0; i < 40; i++)
+      {
+        int64_t x = 6 * i + 3 - 120;
+        int64_t y = 4 * j + 2 - 96;
+        int64_t u = 2 * x + y;
+        int64_t v = -x + 2 * y;
+        int64_t a = 80, b = 40;
+        int32_t featureId = 0;
+        if(b * b * u * u + a * a * v * v <= 5 * a * a * b * b)
+        {
+          featureId = 1;
+        }
+        else if(j < 8)
+        {
+          featureId = 2;
+        }
+        featureIds->setValue(j * 40 + i, featureId);
+      }
+    }
+    attrMat->insertOrAssign(featureIds);
+
+    runShapesFilters(dca, SIMPL::Defaults::ImageDataContainerName);
+    runShapesFilters(dca, "ImageDataContainer2");
+
+    featAttrMat = idc->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    FloatArrayType::Pointer omega3s = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Omega3s);
+    FloatArrayType::Pointer axisLengths = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AxisLengths);
+    FloatArrayType::Pointer axisEulerAngles = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AxisEulerAngles);
+    FloatArrayType::Pointer aspectRatios = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AspectRatios);
+    FloatArrayType::Pointer volumes = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+
+    std::array<float, 3> expectedVolumes = {292.5f, 480.0f, 117.28125f};
+    std::array<float, 3> expectedOmega3s = {0.94380f, 0.66988f, 0.61544f};
+    std::array<float, 9> expectedAxisLengths = {7.0167f, 3.9801f, 2.5295f, 9.9358f, 6.2069f, 2.0132f, 9.3463f, 4.9841f, 0.6623f};
+    std::array<float, 6> expectedAspectRatios = {0.5672f, 0.3605f, 0.6247f, 0.2026f, 0.5333f, 0.0709f};
+    for(size_t featureId = 1; featureId < 4; featureId++)
+    {
+      DREAM3D_CLOSE_ENOUGH(volumes->getValue(featureId), expectedVolumes[featureId - 1], 0.0001f);
+      DREAM3D_CLOSE_ENOUGH(omega3s->getValue(featureId), expectedOmega3s[featureId - 1], 0.0001f);
+      for(size_t i = 0; i < 3; i++)
+      {
+        DREAM3D_CLOSE_ENOUGH(axisLengths->getValue(3 * featureId + i), expectedAxisLengths[3 * (featureId - 1) + i], 0.001f);
+      }
+      DREAM3D_CLOSE_ENOUGH(aspectRatios->getValue(2 * featureId), expectedAspectRatios[2 * (featureId - 1)], 0.0001f);
+      DREAM3D_CLOSE_ENOUGH(aspectRatios->getValue(2 * featureId + 1), expectedAspectRatios[2 * (featureId - 1) + 1], 0.0001f);
+    }
+
+    // The first row of the axis orientation is the longest axis and the last row the shortest
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 1, 0, {1.0f, 1.0f, 1.0f}), 1.0f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 1, 2, {1.0f, 1.0f, -2.0f}), 1.0f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 2, 0, {0.0f, 1.0f, 0.0f}), 1.0f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 2, 2, {1.0f, 0.0f, 0.0f}), 1.0f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 3, 0, {1.0f, 0.0f, 0.0f}), 1.0f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisAlignment(axisEulerAngles, 3, 2, {0.0f, 0.0f, 1.0f}), 1.0f, 0.001f);
+
+    featAttrMat = idc2->getAttributeMatrix(SIMPL::Defaults::CellFeatureAttributeMatrixName);
+    axisLengths = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AxisLengths);
+    axisEulerAngles = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AxisEulerAngles);
+    aspectRatios = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::AspectRatios);
+    volumes = featAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+
+    DREAM3D_CLOSE_ENOUGH(volumes->getValue(1), 158.25f, 0.0001f);
+    DREAM3D_CLOSE_ENOUGH(axisLengths->getValue(3), 9.9733f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisLengths->getValue(4), 5.0665f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(aspectRatios->getValue(2), 0.5080f, 0.0001f);
+    DREAM3D_CLOSE_ENOUGH(axisEulerAngles->getValue(3), 0.46649f, 0.0001f);
+
+    DREAM3D_CLOSE_ENOUGH(volumes->getValue(2), 120.0f, 0.0001f);
+    DREAM3D_CLOSE_ENOUGH(axisLengths->getValue(6), 17.0433f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(axisLengths->getValue(7), 2.3187f, 0.001f);
+    DREAM3D_CLOSE_ENOUGH(aspectRatios->getValue(4), 0.1360f, 0.0001f);
+    DREAM3D_CLOSE_ENOUGH(axisEulerAngles->getValue(6), 0.00127f, 0.0001f);
+
+    return EXIT_SUCCESS;
+  }
+
   // -----------------------------------------------------------------------------
   //
   // -----------------------------------------------------------------------------
@@ -343,6 +564,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(TestFindShapesTest())
+    DREAM3D_REGISTER_TEST(TestAnisotropicFeatures())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
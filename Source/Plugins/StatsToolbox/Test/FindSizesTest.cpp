@@ -33,6 +33,8 @@
  *
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
+#include <cmath>
+
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
 
@@ -483,6 +485,110 @@ public:
 
     return EXIT_SUCCESS;
   }
+  // -----------------------------------------------------------------------------
+  // Anisotropic spacing with several Features of unequal size in a 3D and a 2D
+  // Image Geometry, so the voxel counts of every Feature are merged across slabs
+  // -----------------------------------------------------------------------------
+  int TestAnisotropicImage()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+
+    DataContainer::Pointer image3D_DC = DataContainer::New("ImageGeom3D");
+    dca->addOrReplaceDataContainer(image3D_DC);
+    ImageGeom::Pointer image3D = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image3D->setDimensions(SizeVec3Type(5, 4, 3));
+    image3D->setSpacing(FloatVec3Type(0.75f, 0.5f, 0.25f));
+    image3D_DC->setGeometry(image3D);
+
+    DataContainer::Pointer image2D_DC = DataContainer::New("ImageGeom2D");
+    dca->addOrReplaceDataContainer(image2D_DC);
+    ImageGeom::Pointer image2D = ImageGeom::CreateGeometry(SIMPL::Geometry::ImageGeometry);
+    image2D->setDimensions(SizeVec3Type(5, 4, 1));
+    image2D->setSpacing(FloatVec3Type(0.75f, 0.5f, 1.0f));
+    image2D_DC->setGeometry(image2D);
+
+    // Feature (x + 2y + 3z) % 4 gives 16, 14, 16 and 14 voxels in 3D and 6, 4, 6 and 4 pixels in 2D
+    std::vector<size_t> tDims = {5, 4, 3};
+    AttributeMatrix::Pointer image3D_AttrMat = AttributeMatrix::New(tDims, "Image3DData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer image3D_fIDs = Int32ArrayType::CreateArray(60, SIMPL::CellData::FeatureIds, true);
+    tDims = {5, 4, 1};
+    AttributeMatrix::Pointer image2D_AttrMat = AttributeMatrix::New(tDims, "Image2DData", AttributeMatrix::Type::Cell);
+    Int32ArrayType::Pointer image2D_fIDs = Int32ArrayType::CreateArray(20, SIMPL::CellData::FeatureIds, true);
+    for(size_t z = 0; z < 3; z++)
+    {
+      for(size_t y = 0; y < 4; y++)
+      {
+        for(size_t x = 0; x < 5; x++)
+        {
+          image3D_fIDs->setValue((z * 4 + y) * 5 + x, static_cast<int32_t>((x + 2 * y + 3 * z) % 4));
+          if(z == 0)
+          {
+            image2D_fIDs->setValue(y * 5 + x, static_cast<int32_t>((x + 2 * y) % 4));
+          }
+        }
+      }
+    }
+    image3D_AttrMat->insertOrAssign(image3D_fIDs);
+    image3D_DC->addOrReplaceAttributeMatrix(image3D_AttrMat);
+    image2D_AttrMat->insertOrAssign(image2D_fIDs);
+    image2D_DC->addOrReplaceAttributeMatrix(image2D_AttrMat);
+
+    tDims = {4};
+    image3D_DC->addOrReplaceAttributeMatrix(AttributeMatrix::New(tDims, "Image3DFeatureData", AttributeMatrix::Type::CellFeature));
+    image2D_DC->addOrReplaceAttributeMatrix(AttributeMatrix::New(tDims, "Image2DFeatureData", AttributeMatrix::Type::CellFeature));
+
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer factory = fm->getFactoryFromClassName("FindSizes");
+    DREAM3D_REQUIRE(factory.get() != nullptr)
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != nullptr)
+    filter->setDataContainerArray(dca);
+
+    QVariant var;
+    bool propWasSet;
+    int err = 0;
+
+    DataArrayPath imageGeom3D_featureIds("ImageGeom3D", "Image3DData", "FeatureIds");
+    DataArrayPath imageGeom3D_featureAttrMat("ImageGeom3D", "Image3DFeatureData", "");
+    SET_PROPERTIES_AND_CHECK(filter, imageGeom3D_featureIds, imageGeom3D_featureAttrMat, err);
+
+    DataArrayPath imageGeom2D_featureIds("ImageGeom2D", "Image2DData", "FeatureIds");
+    DataArrayPath imageGeom2D_featureAttrMat("ImageGeom2D", "Image2DFeatureData", "");
+    SET_PROPERTIES_AND_CHECK(filter, imageGeom2D_featureIds, imageGeom2D_featureAttrMat, err);
+
+    AttributeMatrix::Pointer featureAttrMat = image3D_DC->getAttributeMatrix("Image3DFeatureData");
+    Int32ArrayType::Pointer numElements = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumElements);
+    FloatArrayType::Pointer volumes = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    FloatArrayType::Pointer diameters = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EquivalentDiameters);
+
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(1), 14);
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(2), 16);
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(3), 14);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(1), 1.3125f);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(2), 1.5f);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(3), 1.3125f);
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(1) - 1.35842f) < 0.0001f)
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(2) - 1.42025f) < 0.0001f)
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(3) - 1.35842f) < 0.0001f)
+
+    featureAttrMat = image2D_DC->getAttributeMatrix("Image2DFeatureData");
+    numElements = featureAttrMat->getAttributeArrayAs<Int32ArrayType>(SIMPL::FeatureData::NumElements);
+    volumes = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::Volumes);
+    diameters = featureAttrMat->getAttributeArrayAs<FloatArrayType>(SIMPL::FeatureData::EquivalentDiameters);
+
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(1), 4);
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(2), 6);
+    DREAM3D_REQUIRE_EQUAL(numElements->getValue(3), 4);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(1), 1.5f);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(2), 2.25f);
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(3), 1.5f);
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(1) - 1.38198f) < 0.0001f)
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(2) - 1.69257f) < 0.0001f)
+    DREAM3D_REQUIRE(std::fabs(diameters->getValue(3) - 1.38198f) < 0.0001f)
+
+    return EXIT_SUCCESS;
+  }
+
   /**
    * @brief
    */
@@ -492,6 +598,7 @@ public:
     DREAM3D_REGISTER_TEST(TestFilterAvailability());
 
     DREAM3D_REGISTER_TEST(RunTest())
+    DREAM3D_REGISTER_TEST(TestAnisotropicImage())
 
     DREAM3D_REGISTER_TEST(RemoveTestFiles())
   }
@@ -0,0 +1,278 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/PhaseType.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/FilterFactory.hpp"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/StatsData/PrimaryStatsData.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "StatsToolboxTestFileLocations.h"
+
+namespace
+{
+const QString k_DataContainerName("DataContainer");
+const QString k_FeatureDataName("CellFeatureData");
+const QString k_EnsembleDataName("CellEnsembleData");
+} // namespace
+
+class GenerateEnsembleStatisticsTest
+{
+
+public:
+  GenerateEnsembleStatisticsTest() = default;
+  virtual ~GenerateEnsembleStatisticsTest() = default;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestFilterAvailability()
+  {
+    // Now instantiate the GenerateEnsembleStatistics Filter from the FilterManager
+    QString filtName = "GenerateEnsembleStatistics";
+    FilterManager* fm = FilterManager::Instance();
+    IFilterFactory::Pointer filterFactory = fm->getFactoryFromClassName(filtName);
+    if(nullptr == filterFactory.get())
+    {
+      std::stringstream ss;
+      ss << "The GenerateEnsembleStatisticsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Statistics Plugin";
+      DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+    }
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // The fits are computed in single precision, so the values are compared with a relative tolerance
+  // -----------------------------------------------------------------------------
+  bool closeEnough(float value, float expected)
+  {
+    return std::fabs(value - expected) <= 0.001f * std::max(1.0f, std::fabs(expected));
+  }
+
+  // -----------------------------------------------------------------------------
+  // Seven Features of one Primary phase. Feature 6 is biased and must not contribute to any of the fits. With a
+  // correlation resolution of 1 the unbiased diameters 2.0 to 4.5 fall in pairs into the first three of five bins.
+  // -----------------------------------------------------------------------------
+  DataContainerArray::Pointer createTestData()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer dc = DataContainer::New(k_DataContainerName);
+    dca->addOrReplaceDataContainer(dc);
+
+    const size_t numFeatures = 8;
+    const bool biased[numFeatures] = {false, false, false, false, false, false, true, false};
+    const float diameters[numFeatures] = {0.0f, 2.0f, 2.5f, 3.0f, 3.5f, 4.0f, 5.0f, 4.5f};
+    const float bOverA[numFeatures] = {0.0f, 0.50f, 0.60f, 0.70f, 0.80f, 0.55f, 0.9f, 0.65f};
+    const float cOverA[numFeatures] = {0.0f, 0.30f, 0.40f, 0.35f, 0.45f, 0.25f, 0.9f, 0.45f};
+    const float omega3s[numFeatures] = {0.0f, 0.70f, 0.80f, 0.75f, 0.85f, 0.90f, 0.5f, 0.60f};
+    const int32_t neighborhoods[numFeatures] = {0, 4, 6, 8, 10, 12, 30, 16};
+
+    std::vector<size_t> tDims = {numFeatures};
+    AttributeMatrix::Pointer featureAM = AttributeMatrix::New(tDims, k_FeatureDataName, AttributeMatrix::Type::CellFeature);
+    dc->addOrReplaceAttributeMatrix(featureAM);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Phases, true);
+    BoolArrayType::Pointer biasedFeatures = BoolArrayType::CreateArray(numFeatures, SIMPL::FeatureData::BiasedFeatures, true);
+    FloatArrayType::Pointer equivalentDiameters = FloatArrayType::CreateArray(numFeatures, SIMPL::FeatureData::EquivalentDiameters, true);
+    Int32ArrayType::Pointer neighborhoodCounts = Int32ArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Neighborhoods, true);
+    FloatArrayType::Pointer omega3Values = FloatArrayType::CreateArray(numFeatures, SIMPL::FeatureData::Omega3s, true);
+    std::vector<size_t> cDims = {2};
+    FloatArrayType::Pointer aspectRatios = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::AspectRatios, true);
+    cDims = {3};
+    FloatArrayType::Pointer axisEulerAngles = FloatArrayType::CreateArray(numFeatures, cDims, SIMPL::FeatureData::AxisEulerAngles, true);
+    axisEulerAngles->initializeWithZeros();
+    NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(numFeatures, SIMPL::FeatureData::NeighborList, true);
+
+    for(size_t i = 0; i < numFeatures; i++)
+    {
+      phases->setValue(i, (i == 0) ? 0 : 1);
+      biasedFeatures->setValue(i, biased[i]);
+      equivalentDiameters->setValue(i, diameters[i]);
+      neighborhoodCounts->setValue(i, neighborhoods[i]);
+      omega3Values->setValue(i, omega3s[i]);
+      aspectRatios->setComponent(i, 0, bOverA[i]);
+      aspectRatios->setComponent(i, 1, cOverA[i]);
+      NeighborList<int32_t>::SharedVectorType list(new std::vector<int32_t>);
+      neighborList->setList(static_cast<int32_t>(i), list);
+    }
+
+    featureAM->insertOrAssign(phases);
+    featureAM->insertOrAssign(biasedFeatures);
+    featureAM->insertOrAssign(equivalentDiameters);
+    featureAM->insertOrAssign(neighborhoodCounts);
+    featureAM->insertOrAssign(omega3Values);
+    featureAM->insertOrAssign(aspectRatios);
+    featureAM->insertOrAssign(axisEulerAngles);
+    featureAM->insertOrAssign(neighborList);
+
+    tDims = {2};
+    AttributeMatrix::Pointer ensembleAM = AttributeMatrix::New(tDims, k_EnsembleDataName, AttributeMatrix::Type::CellEnsemble);
+    dc->addOrReplaceAttributeMatrix(ensembleAM);
+
+    return dca;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void setPath(AbstractFilter::Pointer filter, const char* propertyName, const DataArrayPath& path)
+  {
+    QVariant var;
+    var.setValue(path);
+    DREAM3D_REQUIRE(filter->setProperty(propertyName, var))
+  }
+
+  // -----------------------------------------------------------------------------
+  // The expected parameters are the population moment fits of each bin, computed by hand
+  // -----------------------------------------------------------------------------
+  int TestDistributionFits()
+  {
+    DataContainerArray::Pointer dca = createTestData();
+
+    FilterManager* fm = FilterManager::Instance();
+    AbstractFilter::Pointer filter = fm->getFactoryFromClassName("GenerateEnsembleStatistics")->create();
+    DREAM3D_REQUIRE_VALID_POINTER(filter.get())
+    filter->setDataContainerArray(dca);
+
+    // The phase types are not a registered property type, so they are read the same way a pipeline file supplies them
+    QJsonObject json;
+    QJsonArray phaseTypes;
+    phaseTypes.append(static_cast<int>(PhaseType::Type::Unknown));
+    phaseTypes.append(static_cast<int>(PhaseType::Type::Primary));
+    json["PhaseTypeArray"] = phaseTypes;
+    filter->readFilterParameters(json);
+
+    setPath(filter, "CellEnsembleAttributeMatrixPath", DataArrayPath(k_DataContainerName, k_EnsembleDataName, ""));
+    setPath(filter, "FeaturePhasesArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::Phases));
+    setPath(filter, "BiasedFeaturesArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::BiasedFeatures));
+    setPath(filter, "EquivalentDiametersArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::EquivalentDiameters));
+    setPath(filter, "NeighborhoodsArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::Neighborhoods));
+    setPath(filter, "AspectRatiosArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::AspectRatios));
+    setPath(filter, "Omega3sArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::Omega3s));
+    setPath(filter, "AxisEulerAnglesArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::AxisEulerAngles));
+    setPath(filter, "NeighborListArrayPath", DataArrayPath(k_DataContainerName, k_FeatureDataName, SIMPL::FeatureData::NeighborList));
+
+    DREAM3D_REQUIRE(filter->setProperty("CalculateMorphologicalStats", true))
+    DREAM3D_REQUIRE(filter->setProperty("CalculateCrystallographicStats", false))
+    DREAM3D_REQUIRE(filter->setProperty("IncludeRadialDistFunc", false))
+    DREAM3D_REQUIRE(filter->setProperty("SizeCorrelationResolution", 1.0f))
+    DREAM3D_REQUIRE(filter->setProperty("SizeDistributionFitType", SIMPL::DistributionType::LogNormal))
+    DREAM3D_REQUIRE(filter->setProperty("AspectRatioDistributionFitType", SIMPL::DistributionType::Beta))
+    DREAM3D_REQUIRE(filter->setProperty("Omega3DistributionFitType", SIMPL::DistributionType::Beta))
+    DREAM3D_REQUIRE(filter->setProperty("NeighborhoodDistributionFitType", SIMPL::DistributionType::Power))
+
+    filter->execute();
+    // The power law neighborhood fit raises a warning, which is expected
+    DREAM3D_REQUIRED(filter->getErrorCode(), >=, 0)
+
+    AttributeMatrix::Pointer ensembleAM = dca->getAttributeMatrix(DataArrayPath(k_DataContainerName, k_EnsembleDataName, ""));
+    StatsDataArray::Pointer statsDataArray = ensembleAM->getAttributeArrayAs<StatsDataArray>(SIMPL::EnsembleData::Statistics);
+    DREAM3D_REQUIRE_VALID_POINTER(statsDataArray.get())
+    PrimaryStatsData::Pointer statsData = std::dynamic_pointer_cast<PrimaryStatsData>((*statsDataArray)[1]);
+    DREAM3D_REQUIRE_VALID_POINTER(statsData.get())
+
+    DREAM3D_REQUIRE(closeEnough(statsData->getPhaseFraction(), 1.0f))
+
+    // Log normal fit of the six unbiased diameters
+    VectorOfFloatArray sizeDistribution = statsData->getFeatureSizeDistribution();
+    DREAM3D_REQUIRE(closeEnough(sizeDistribution[0]->getValue(0), 1.14186f))
+    DREAM3D_REQUIRE(closeEnough(sizeDistribution[1]->getValue(0), 0.27609f))
+
+    FloatArrayType::Pointer binNumbers = statsData->getBinNumbers();
+    DREAM3D_REQUIRE_EQUAL(binNumbers->getNumberOfTuples(), 5)
+    DREAM3D_REQUIRE(closeEnough(binNumbers->getValue(0), 2.0f))
+    DREAM3D_REQUIRE(closeEnough(binNumbers->getValue(1), 3.0f))
+    DREAM3D_REQUIRE(closeEnough(binNumbers->getValue(2), 4.0f))
+
+    // Beta fits, per bin: {b/a alpha, b/a beta, c/a alpha, c/a beta, omega3 alpha, omega3 beta}
+    const float betaParameters[3][6] = {
+        {53.9f, 44.1f, 31.5f, 58.5f, 55.5f, 18.5f},
+        {55.5f, 18.5f, 38.0f, 57.0f, 50.4f, 12.6f},
+        {57.0f, 38.0f, 7.6125f, 14.1375f, 5.5f, 1.83333f},
+    };
+    // Power law fits, per bin: {alpha, min}. Each bin starts its own sum, so bins 1 and 2 only depend on their own values
+    const float powerLawParameters[3][2] = {{5.93261f, 4.0f}, {9.96284f, 8.0f}, {7.95212f, 12.0f}};
+
+    VectorOfFloatArray bOverA = statsData->getFeatureSize_BOverA();
+    VectorOfFloatArray cOverA = statsData->getFeatureSize_COverA();
+    VectorOfFloatArray omegas = statsData->getFeatureSize_Omegas();
+    VectorOfFloatArray neighbors = statsData->getFeatureSize_Neighbors();
+    for(size_t bin = 0; bin < 5; bin++)
+    {
+      const bool populated = (bin < 3);
+      DREAM3D_REQUIRE(closeEnough(bOverA[0]->getValue(bin), populated ? betaParameters[bin][0] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(bOverA[1]->getValue(bin), populated ? betaParameters[bin][1] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(cOverA[0]->getValue(bin), populated ? betaParameters[bin][2] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(cOverA[1]->getValue(bin), populated ? betaParameters[bin][3] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(omegas[0]->getValue(bin), populated ? betaParameters[bin][4] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(omegas[1]->getValue(bin), populated ? betaParameters[bin][5] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(neighbors[0]->getValue(bin), populated ? powerLawParameters[bin][0] : 0.0f))
+      DREAM3D_REQUIRE(closeEnough(neighbors[1]->getValue(bin), populated ? powerLawParameters[bin][1] : 0.0f))
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestFilterAvailability());
+
+    DREAM3D_REGISTER_TEST(TestDistributionFits())
+  }
+
+public:
+  GenerateEnsembleStatisticsTest(const GenerateEnsembleStatisticsTest&) = delete;            // Copy Constructor Not Implemented
+  GenerateEnsembleStatisticsTest(GenerateEnsembleStatisticsTest&&) = delete;                 // Move Constructor Not Implemented
+  GenerateEnsembleStatisticsTest& operator=(const GenerateEnsembleStatisticsTest&) = delete; // Copy Assignment Not Implemented
+  GenerateEnsembleStatisticsTest& operator=(GenerateEnsembleStatisticsTest&&) = delete;      // Move Assignment Not Implemented
+};